@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Fires concurrent requests at a MythTV HTTP server (the backend's services
+# API or status page by default) and reports latency percentiles and the
+# peak resident memory of the server process.
+#
+# Example, 8 clients fetching the recordings list 200 times as gzip'd JSON:
+#
+#   httpbench.py --host localhost --port 6544 --clients 8 --requests 200 \
+#                --json --gzip --pid $(pidof mythbackend) \
+#                /Dvr/GetRecordedList /Guide/GetProgramGuide
+#
+# Latencies are measured from sending the request to the first byte of the
+# body and to the last byte.  Peak RSS is read from /proc, so --pid only
+# works when the server runs on this machine.
+#
+# Licensed under the GPL v2 or later, see COPYING for details
+
+import argparse
+import http.client
+import itertools
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+
+def read_status_kb(pid, field):
+    """Returns a memory field from /proc/<pid>/status in kB, or None."""
+    try:
+        with open('/proc/{}/status'.format(pid)) as status:
+            for line in status:
+                if line.startswith(field + ':'):
+                    return int(line.split()[1])
+    except OSError:
+        pass
+    return None
+
+
+class RssSampler(threading.Thread):
+    """Samples the resident size of a process until stopped.
+
+    VmHWM is the kernel's own high water mark, but it covers the whole
+    life of the process, so the sampled peak during the run is reported
+    too."""
+
+    def __init__(self, pid, interval=0.05):
+        super().__init__(daemon=True)
+        self.pid = pid
+        self.interval = interval
+        self.start_rss = read_status_kb(pid, 'VmRSS')
+        self.peak_rss = self.start_rss or 0
+        self.stopped = threading.Event()
+
+    def run(self):
+        while not self.stopped.wait(self.interval):
+            rss = read_status_kb(self.pid, 'VmRSS')
+            if rss is not None:
+                self.peak_rss = max(self.peak_rss, rss)
+
+    def stop(self):
+        self.stopped.set()
+        self.join()
+
+
+def fetch(args, path):
+    """Makes one request, returns (first byte, last byte, bytes, status)."""
+    headers = {'Accept': 'application/json' if args.json else 'text/xml'}
+    if args.gzip:
+        headers['Accept-Encoding'] = 'gzip'
+
+    conn = http.client.HTTPConnection(args.host, args.port,
+                                      timeout=args.timeout)
+    try:
+        start = time.monotonic()
+        conn.request('GET', path, headers=headers)
+        response = conn.getresponse()
+        first = response.read(1)
+        first_byte = time.monotonic() - start
+        size = len(first)
+        while True:
+            data = response.read(65536)
+            if not data:
+                break
+            size += len(data)
+        last_byte = time.monotonic() - start
+        return first_byte, last_byte, size, response.status
+    finally:
+        conn.close()
+
+
+def percentile(values, pct):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    index = min(len(values) - 1, int(round(pct / 100.0 * (len(values) - 1))))
+    return values[index]
+
+
+def report(name, values):
+    print('  {:<12} p50 {:8.1f} ms  p90 {:8.1f} ms  p99 {:8.1f} ms  '
+          'max {:8.1f} ms'.format(name,
+                                  percentile(values, 50) * 1000,
+                                  percentile(values, 90) * 1000,
+                                  percentile(values, 99) * 1000,
+                                  max(values) * 1000 if values else 0.0))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Concurrent load test for the MythTV HTTP server')
+    parser.add_argument('paths', nargs='*', default=['/Dvr/GetRecordedList'],
+                        help='URLs to request, in turn')
+    parser.add_argument('--host', default='localhost')
+    parser.add_argument('--port', type=int, default=6544)
+    parser.add_argument('--clients', type=int, default=8,
+                        help='concurrent connections')
+    parser.add_argument('--requests', type=int, default=100,
+                        help='requests in all')
+    parser.add_argument('--json', action='store_true',
+                        help='ask for JSON rather than XML')
+    parser.add_argument('--gzip', action='store_true',
+                        help='accept gzip encoding')
+    parser.add_argument('--timeout', type=float, default=120.0)
+    parser.add_argument('--pid', type=int,
+                        help='server process to measure the memory of')
+    args = parser.parse_args()
+
+    sampler = None
+    if args.pid:
+        sampler = RssSampler(args.pid)
+        sampler.start()
+
+    paths = list(itertools.islice(itertools.cycle(args.paths), args.requests))
+    first_bytes, last_bytes, errors = [], [], []
+    total_bytes = 0
+
+    start = time.monotonic()
+    with ThreadPoolExecutor(max_workers=args.clients) as pool:
+        futures = [pool.submit(fetch, args, path) for path in paths]
+        for future in futures:
+            try:
+                first_byte, last_byte, size, status = future.result()
+            except (OSError, http.client.HTTPException) as err:
+                errors.append(str(err))
+                continue
+            if status != 200:
+                errors.append('HTTP {}'.format(status))
+                continue
+            first_bytes.append(first_byte)
+            last_bytes.append(last_byte)
+            total_bytes += size
+    elapsed = time.monotonic() - start
+
+    if sampler:
+        sampler.stop()
+
+    print('{} requests, {} clients, {:.1f} s, {:.1f} requests/s, '
+          '{:.1f} MB received'.format(len(last_bytes), args.clients, elapsed,
+                                      len(last_bytes) / elapsed,
+                                      total_bytes / 1e6))
+    report('first byte', first_bytes)
+    report('last byte', last_bytes)
+
+    if sampler:
+        hwm = read_status_kb(args.pid, 'VmHWM')
+        print('  server RSS   start {} MB  peak {} MB  (VmHWM {} MB)'.format(
+            (sampler.start_rss or 0) // 1024, sampler.peak_rss // 1024,
+            (hwm or 0) // 1024))
+
+    if errors:
+        print('{} errors, first: {}'.format(len(errors), errors[0]))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
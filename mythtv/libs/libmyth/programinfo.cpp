@@ -11,6 +11,7 @@ using std::max;
 using std::min;
 
 // Qt headers
+#include <QHash>
 #include <QMap>
 #include <QUrl>
 #include <QFile>
@@ -5903,112 +5904,17 @@ bool LoadFromOldRecorded(ProgramList &destination, const QString &sql,
     return true;
 }
 
-/** \fn ProgramInfo::LoadFromRecorded(void)
- *  \brief Load a ProgramList from the recorded table.
- *  \param destination     ProgramList to fill
- *  \param possiblyInProgressRecordingsOnly  return only in-progress
- *                                           recordings or empty list
- *  \param inUseMap        in-use programs map
- *  \param isJobRunning    job map
- *  \param recMap          recording map
- *  \param sort            sort order, negative for descending, 0 for
- *                         unsorted, positive for ascending
- *  \param sortBy          comma separated list of fields to sort by
- *  \return true if it succeeds, false if it fails.
- *  \sa QueryInUseMap(void)
- *      QueryJobsRunning(int)
- *      Scheduler::GetRecording()
- */
-bool LoadFromRecorded(
+/// Appends the rows of a query on ProgramInfo::kFromRecordedQuery
+static void FromRecordedQuery(
     ProgramList &destination,
-    bool possiblyInProgressRecordingsOnly,
+    MSqlQuery &query,
     const QMap<QString,uint32_t> &inUseMap,
     const QMap<QString,bool> &isJobRunning,
-    const QMap<QString, ProgramInfo*> &recMap,
-    int sort,
-    const QString &sortBy)
+    const QMap<QString, ProgramInfo*> &recMap)
 {
-    destination.clear();
-
     QDateTime   rectime    = MythDate::current().addSecs(
         -gCoreContext->GetNumSetting("RecordOverTime"));
 
-    // ----------------------------------------------------------------------
-
-    QString thequery = ProgramInfo::kFromRecordedQuery;
-    if (possiblyInProgressRecordingsOnly)
-        thequery += "WHERE r.endtime >= NOW() AND r.starttime <= NOW() ";
-
-    if (sortBy.isEmpty())
-    {
-        if (sort)
-            thequery += "ORDER BY r.starttime ";
-        if (sort < 0)
-            thequery += "DESC ";
-    }
-    else
-    {
-        QStringList sortByFields;
-        sortByFields << "starttime" <<  "title" <<  "subtitle" << "season" << "episode" << "category"
-                     <<  "watched" << "stars" << "originalairdate" << "recgroup" << "storagegroup"
-                     <<  "channum" << "callsign" << "name";
-
-        // sanity check the fields are one of the above fields
-        QString sSortBy;
-        QStringList fields = sortBy.split(",");
-        for (int x = 0; x < fields.size(); x++)
-        {
-            bool ascending = true;
-            QString field = fields.at(x).simplified().toLower();
-
-            if (field.endsWith("desc"))
-            {
-                ascending = false;
-                field = field.remove("desc");
-            }
-
-            if (field.endsWith("asc"))
-            {
-                ascending = true;
-                field = field.remove("asc");
-            }
-
-            field = field.simplified();
-
-            if (field == "channelname")
-                field = "name";
-
-            if (sortByFields.contains(field))
-            {
-                QString table;
-                if (field == "channum" || field == "callsign" || field == "name")
-                    table = "c";
-                else
-                    table = "r";
-
-                if (sSortBy.isEmpty())
-                    sSortBy = QString("%1.%2 %3").arg(table, field, ascending ? "ASC" : "DESC");
-                else
-                    sSortBy += QString(",%1.%2 %3").arg(table, field, ascending ? "ASC" : "DESC");
-            }
-            else
-            {
-                LOG(VB_GENERAL, LOG_WARNING, QString("ProgramInfo::LoadFromRecorded() got an unknown sort field '%1' - ignoring").arg(fields.at(x)));
-            }
-        }
-
-        thequery += "ORDER BY " + sSortBy;
-    }
-
-    MSqlQuery query(MSqlQuery::InitCon());
-    query.prepare(thequery);
-
-    if (!query.exec())
-    {
-        MythDB::DBError("ProgramList::FromRecorded", query);
-        return true;
-    }
-
     while (query.next())
     {
         const uint chanid = query.value(6).toUInt();
@@ -6148,6 +6054,155 @@ bool LoadFromRecorded(
         if (save_not_commflagged)
             destination.back()->SaveCommFlagged(COMM_FLAG_NOT_FLAGGED);
     }
+}
+
+/** \fn ProgramInfo::LoadFromRecorded(void)
+ *  \brief Load a ProgramList from the recorded table.
+ *  \param destination     ProgramList to fill
+ *  \param possiblyInProgressRecordingsOnly  return only in-progress
+ *                                           recordings or empty list
+ *  \param inUseMap        in-use programs map
+ *  \param isJobRunning    job map
+ *  \param recMap          recording map
+ *  \param sort            sort order, negative for descending, 0 for
+ *                         unsorted, positive for ascending
+ *  \param sortBy          comma separated list of fields to sort by
+ *  \return true if it succeeds, false if it fails.
+ *  \sa QueryInUseMap(void)
+ *      QueryJobsRunning(int)
+ *      Scheduler::GetRecording()
+ */
+bool LoadFromRecorded(
+    ProgramList &destination,
+    bool possiblyInProgressRecordingsOnly,
+    const QMap<QString,uint32_t> &inUseMap,
+    const QMap<QString,bool> &isJobRunning,
+    const QMap<QString, ProgramInfo*> &recMap,
+    int sort,
+    const QString &sortBy)
+{
+    destination.clear();
+
+    QString thequery = ProgramInfo::kFromRecordedQuery;
+    if (possiblyInProgressRecordingsOnly)
+        thequery += "WHERE r.endtime >= NOW() AND r.starttime <= NOW() ";
+
+    if (sortBy.isEmpty())
+    {
+        if (sort)
+            thequery += "ORDER BY r.starttime ";
+        if (sort < 0)
+            thequery += "DESC ";
+    }
+    else
+    {
+        QStringList sortByFields;
+        sortByFields << "starttime" <<  "title" <<  "subtitle" << "season" << "episode" << "category"
+                     <<  "watched" << "stars" << "originalairdate" << "recgroup" << "storagegroup"
+                     <<  "channum" << "callsign" << "name";
+
+        // sanity check the fields are one of the above fields
+        QString sSortBy;
+        QStringList fields = sortBy.split(",");
+        for (int x = 0; x < fields.size(); x++)
+        {
+            bool ascending = true;
+            QString field = fields.at(x).simplified().toLower();
+
+            if (field.endsWith("desc"))
+            {
+                ascending = false;
+                field = field.remove("desc");
+            }
+
+            if (field.endsWith("asc"))
+            {
+                ascending = true;
+                field = field.remove("asc");
+            }
+
+            field = field.simplified();
+
+            if (field == "channelname")
+                field = "name";
+
+            if (sortByFields.contains(field))
+            {
+                QString table;
+                if (field == "channum" || field == "callsign" || field == "name")
+                    table = "c";
+                else
+                    table = "r";
+
+                if (sSortBy.isEmpty())
+                    sSortBy = QString("%1.%2 %3").arg(table, field, ascending ? "ASC" : "DESC");
+                else
+                    sSortBy += QString(",%1.%2 %3").arg(table, field, ascending ? "ASC" : "DESC");
+            }
+            else
+            {
+                LOG(VB_GENERAL, LOG_WARNING, QString("ProgramInfo::LoadFromRecorded() got an unknown sort field '%1' - ignoring").arg(fields.at(x)));
+            }
+        }
+
+        thequery += "ORDER BY " + sSortBy;
+    }
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(thequery);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramList::FromRecorded", query);
+        return true;
+    }
+
+    FromRecordedQuery(destination, query, inUseMap, isJobRunning, recMap);
+    return true;
+}
+
+/** \brief Loads the recordings with the given recorded ids, in that order.
+ *
+ *  Ids of recordings that no longer exist are skipped.
+ */
+bool LoadFromRecorded(
+    ProgramList &destination,
+    const std::vector<uint> &recordedids,
+    const QMap<QString,uint32_t> &inUseMap,
+    const QMap<QString,bool> &isJobRunning,
+    const QMap<QString, ProgramInfo*> &recMap)
+{
+    destination.clear();
+    if (recordedids.empty())
+        return true;
+
+    QStringList ids;
+    for (uint recordedid : recordedids)
+        ids << QString::number(recordedid);
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(ProgramInfo::kFromRecordedQuery +
+                  QString("WHERE r.recordedid IN (%1) ").arg(ids.join(",")));
+
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramList::FromRecorded", query);
+        return true;
+    }
+
+    ProgramList loaded(false);
+    FromRecordedQuery(loaded, query, inUseMap, isJobRunning, recMap);
+
+    QHash<uint, ProgramInfo*> byId;
+    for (auto *pginfo : loaded)
+        byId.insert(pginfo->GetRecordingID(), pginfo);
+    for (uint recordedid : recordedids)
+    {
+        ProgramInfo *pginfo = byId.take(recordedid);
+        if (pginfo)
+            destination.push_back(pginfo);
+    }
+    qDeleteAll(byId);
 
     return true;
 }
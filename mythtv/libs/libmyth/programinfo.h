@@ -888,6 +888,13 @@ MPUBLIC bool LoadFromRecorded(
     int                 sort = 0,
     const QString      &sortBy = "");
 
+MPUBLIC bool LoadFromRecorded(
+    ProgramList        &destination,
+    const std::vector<uint> &recordedids,
+    const QMap<QString,uint32_t> &inUseMap,
+    const QMap<QString,bool> &isJobRunning,
+    const QMap<QString, ProgramInfo*> &recMap);
+
 
 template<typename TYPE>
 bool LoadFromScheduler(
@@ -0,0 +1,361 @@
+#include "filehashcache.h"
+
+// C++ headers
+#include <cerrno>
+#include <utility>
+
+// POSIX headers
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+// Qt headers
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+// MythTV headers
+#include "mythconfig.h"
+#include "mythdirs.h"
+#include "mythlogging.h"
+#include "mythmiscutil.h"
+
+#define LOC QString("FileHashCache: ")
+
+static constexpr quint32 kJournalMagic   { 0x4d464843 }; // "MFHC"
+static constexpr quint32 kJournalVersion { 1 };
+
+// Outdated records that are tolerated before the journal is compacted
+static constexpr int kCompactSlack { 1000 };
+
+FileHashCache::FileHashCache(QString journal) :
+    m_journalName(std::move(journal))
+{
+}
+
+FileHashCache::~FileHashCache()
+{
+#ifndef _WIN32
+    if (m_lockFd >= 0)
+        close(m_lockFd);
+#endif
+}
+
+/**
+ * \brief Returns the FileHash() of a file, reading it only if it has
+ *        changed since it was last hashed.
+ */
+QString FileHashCache::Hash(const QString &filename)
+{
+    FileId id;
+
+    // Missing and empty files are left to ReadFileHash() to report
+    if (!GetFileId(filename, id) || (id.m_size == 0))
+        return ReadFileHash(filename);
+
+    {
+        QMutexLocker locker(&m_lock);
+        Load();
+
+        auto it = m_entries.constFind(filename);
+        if ((it != m_entries.constEnd()) && (it->m_id == id))
+            return it->m_hash;
+    }
+
+    // Read without the lock, so other files can be looked up meanwhile
+    QString hash = ReadFileHash(filename);
+    if (hash == "NULL")
+        return hash;
+
+    // A file that changed while it was read is hashed again next time
+    FileId after;
+    if (!GetFileId(filename, after) || (after != id))
+        return hash;
+
+    Entry entry { id, hash };
+
+    QMutexLocker locker(&m_lock);
+    m_entries.insert(filename, entry);
+    Append(filename, entry);
+
+    return hash;
+}
+
+/**
+ * \brief Looks up the hash of a file that is unchanged since it was hashed.
+ * \return true if it was found, false if the file has to be read.
+ */
+bool FileHashCache::Lookup(const QString &filename, QString &hash)
+{
+    FileId id;
+    if (!GetFileId(filename, id))
+        return false;
+
+    QMutexLocker locker(&m_lock);
+    Load();
+
+    auto it = m_entries.constFind(filename);
+    if ((it == m_entries.constEnd()) || (it->m_id != id))
+        return false;
+
+    hash = it->m_hash;
+    return true;
+}
+
+/**
+ * \brief Returns the cache used by FileHash(), which keeps its journal
+ *        in the cache directory, one per program.
+ */
+FileHashCache *FileHashCache::GetGlobal(void)
+{
+    static QMutex s_lock;
+    static FileHashCache *s_cache = nullptr;
+
+    QMutexLocker locker(&s_lock);
+    if (s_cache == nullptr)
+    {
+        QString journal;
+        if (!GetCacheDir().isEmpty())
+        {
+            QString name = QCoreApplication::applicationName();
+            if (name.isEmpty())
+                name = "filehash";
+            journal = GetCacheDir() + "/filehash/" + name + ".journal";
+        }
+        s_cache = new FileHashCache(journal);
+    }
+
+    return s_cache;
+}
+
+bool FileHashCache::GetFileId(const QString &filename, FileId &id)
+{
+#ifdef _WIN32
+    (void) filename;
+    (void) id;
+    return false;
+#else
+    struct stat st {};
+    if ((stat(QFile::encodeName(filename).constData(), &st) != 0) ||
+        !S_ISREG(st.st_mode))
+        return false;
+
+    id.m_inode = st.st_ino;
+    id.m_size  = st.st_size;
+#if CONFIG_DARWIN
+    id.m_mtime = (st.st_mtimespec.tv_sec * 1000000000LL) +
+                 st.st_mtimespec.tv_nsec;
+#else
+    id.m_mtime = (st.st_mtim.tv_sec * 1000000000LL) + st.st_mtim.tv_nsec;
+#endif
+    return true;
+#endif
+}
+
+/**
+ * \brief Waits until no other program uses the journal.  Needs m_lock.
+ *
+ * The lock is taken on a file of its own, as Rewrite() replaces the
+ * journal file.
+ */
+bool FileHashCache::LockJournal(void)
+{
+#ifdef _WIN32
+    return false;
+#else
+    if (m_lockFd < 0)
+    {
+        QByteArray lockname = QFile::encodeName(m_journalName + ".lock");
+        m_lockFd = open(lockname.constData(), O_RDWR | O_CREAT | O_CLOEXEC,
+                        0644);
+        if (m_lockFd < 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to open the lock file for %1")
+                .arg(m_journalName) + ENO);
+            return false;
+        }
+    }
+
+    while (flock(m_lockFd, LOCK_EX) != 0)
+    {
+        if (errno != EINTR)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to lock %1").arg(m_journalName) + ENO);
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+/// Lets other programs use the journal again.  Needs m_lock.
+void FileHashCache::UnlockJournal(void)
+{
+#ifndef _WIN32
+    flock(m_lockFd, LOCK_UN);
+#endif
+}
+
+/// Reads the journal, the first time the cache is used.  Needs m_lock.
+void FileHashCache::Load(void)
+{
+    if (m_loaded)
+        return;
+    m_loaded = true;
+
+    if (m_journalName.isEmpty())
+        return;
+
+    if (!QDir().mkpath(QFileInfo(m_journalName).absolutePath()))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to create the directory for %1")
+            .arg(m_journalName));
+        return;
+    }
+
+    // Hashes are kept in memory only, rather than risk a mixed up journal
+    if (!LockJournal())
+        return;
+
+    QFile file(m_journalName);
+    bool complete = false;
+    int records = 0;
+
+    if (file.open(QIODevice::ReadOnly))
+    {
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+
+        quint32 magic = 0;
+        quint32 version = 0;
+        stream >> magic >> version;
+        complete = (magic == kJournalMagic) && (version == kJournalVersion);
+
+        while (complete && !stream.atEnd())
+        {
+            QString filename;
+            Entry entry;
+            stream >> filename >> entry.m_id.m_inode >> entry.m_id.m_size
+                   >> entry.m_id.m_mtime >> entry.m_hash;
+
+            // A record that was cut short is dropped with the rest
+            if (stream.status() != QDataStream::Ok)
+            {
+                complete = false;
+                break;
+            }
+
+            m_entries.insert(filename, entry);
+            records++;
+        }
+
+        file.close();
+    }
+
+    LOG(VB_FILE, LOG_INFO, LOC + QString("Loaded %1 hashes from %2")
+        .arg(m_entries.size()).arg(m_journalName));
+
+    if (!complete || (records > (2 * m_entries.size()) + kCompactSlack))
+    {
+        Rewrite();
+    }
+    else
+    {
+        m_journal.setFileName(m_journalName);
+        if (!m_journal.open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to open %1 for writing").arg(m_journalName));
+        }
+    }
+
+    UnlockJournal();
+}
+
+/**
+ * \brief Writes the journal anew, with one record per file, leaving out
+ *        files that were changed or removed since they were hashed.
+ *        Needs m_lock and the journal lock.
+ */
+bool FileHashCache::Rewrite(void)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); )
+    {
+        FileId id;
+        if (GetFileId(it.key(), id) && (id == it->m_id))
+            ++it;
+        else
+            it = m_entries.erase(it);
+    }
+
+    QSaveFile file(m_journalName);
+    if (file.open(QIODevice::WriteOnly))
+    {
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_0);
+        stream << kJournalMagic << kJournalVersion;
+
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+        {
+            stream << it.key() << it->m_id.m_inode << it->m_id.m_size
+                   << it->m_id.m_mtime << it->m_hash;
+        }
+    }
+
+    if (!file.commit())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to write %1").arg(m_journalName));
+        return false;
+    }
+
+    LOG(VB_FILE, LOG_INFO, LOC + QString("Wrote %1 hashes to %2")
+        .arg(m_entries.size()).arg(m_journalName));
+
+    m_journal.setFileName(m_journalName);
+    return m_journal.open(QIODevice::WriteOnly | QIODevice::Append);
+}
+
+/// Adds a new hash to the journal.  Needs m_lock.
+void FileHashCache::Append(const QString &filename, const Entry &entry)
+{
+    if (!m_journal.isOpen() || !LockJournal())
+        return;
+
+#ifndef _WIN32
+    // Another program may have replaced the journal since it was opened
+    struct stat opened {};
+    struct stat current {};
+    if ((fstat(m_journal.handle(), &opened) != 0) ||
+        (stat(QFile::encodeName(m_journalName).constData(), &current) != 0) ||
+        (opened.st_dev != current.st_dev) || (opened.st_ino != current.st_ino))
+    {
+        m_journal.close();
+        if (!m_journal.open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to open %1 for writing").arg(m_journalName));
+            UnlockJournal();
+            return;
+        }
+    }
+#endif
+
+    QDataStream stream(&m_journal);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << filename << entry.m_id.m_inode << entry.m_id.m_size
+           << entry.m_id.m_mtime << entry.m_hash;
+
+    // Written out right away, in case the program doesn't end cleanly
+    m_journal.flush();
+
+    UnlockJournal();
+}
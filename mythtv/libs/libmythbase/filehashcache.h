@@ -0,0 +1,76 @@
+#ifndef FILEHASHCACHE_H_
+#define FILEHASHCACHE_H_
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include "mythbaseexp.h"
+
+/**
+ * Remembers the FileHash() of files, so that a file is not read again
+ * while it is unchanged.
+ *
+ * A file counts as unchanged while its path, inode, size and modification
+ * time are the same as when it was hashed.  New hashes are appended to a
+ * journal file as they are made, so that they are kept across restarts of
+ * the program.  The journal is compacted when it is loaded, if it holds
+ * many outdated records, and the records of files that were changed or
+ * removed are dropped then.  Programs that share a journal take turns
+ * with it, using flock() on a lock file next to it.
+ *
+ * Without a journal file the hashes are only kept in memory.  On Windows
+ * there are no inode numbers, so files are always read.
+ */
+class MBASE_PUBLIC FileHashCache
+{
+  public:
+    explicit FileHashCache(QString journal = QString());
+    ~FileHashCache();
+    FileHashCache(const FileHashCache &) = delete;            // not copyable
+    FileHashCache &operator=(const FileHashCache &) = delete; // not copyable
+
+    QString Hash(const QString &filename);
+    bool Lookup(const QString &filename, QString &hash);
+
+    static FileHashCache *GetGlobal(void);
+
+  private:
+    struct FileId
+    {
+        quint64 m_inode {0};
+        qint64  m_size  {0};
+        qint64  m_mtime {0}; ///< in nanoseconds
+
+        bool operator==(const FileId &other) const
+        {
+            return (m_inode == other.m_inode) && (m_size == other.m_size) &&
+                   (m_mtime == other.m_mtime);
+        }
+        bool operator!=(const FileId &other) const { return !(*this == other); }
+    };
+
+    struct Entry
+    {
+        FileId  m_id;
+        QString m_hash;
+    };
+
+    static bool GetFileId(const QString &filename, FileId &id);
+
+    bool LockJournal(void);
+    void UnlockJournal(void);
+    void Load(void);
+    bool Rewrite(void);
+    void Append(const QString &filename, const Entry &entry);
+
+    QMutex                m_lock;
+    QString               m_journalName;
+    QFile                 m_journal;
+    int                   m_lockFd {-1};
+    bool                  m_loaded {false};
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // FILEHASHCACHE_H_
@@ -3,7 +3,6 @@
 #include <QMutexLocker>
 #include <QWaitCondition>
 #include <QList>
-#include <QQueue>
 #include <QHash>
 #include <QFileInfo>
 #include <QStringList>
@@ -23,6 +22,8 @@
 #include "exitcodes.h"
 #include "compat.h"
 
+#include <array>
+#include <atomic>
 #include <csignal>
 #include <cstdarg>
 #include <cstdio>
@@ -31,6 +32,7 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <utility>
 #if HAVE_GETTIMEOFDAY
 #include <sys/time.h>
@@ -60,8 +62,101 @@ extern "C" {
 #include <android/log.h>
 #endif
 
+/// \brief Bounded lock-free queue of the LogRecords waiting for the
+///        logging thread.
+///
+/// Any thread may push, only the logging thread (or the thread calling
+/// LOG() once it has finished) may pop.  The slots are allocated once and
+/// reused, so queueing a message only moves its QString.  This is the
+/// single consumer case of Dmitry Vyukov's bounded MPMC queue: the sequence
+/// number of a slot tells whether it is free for the push at that position
+/// or holds the record for the pop at that position.
+class LogRecordQueue
+{
+  public:
+    LogRecordQueue()
+    {
+        for (size_t i = 0; i < kSize; ++i)
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /// Moves \p record into the queue, returns false if the queue is full.
+    bool push(LogRecord &record)
+    {
+        size_t pos = m_pushPos.load(std::memory_order_relaxed);
+        Slot *slot = nullptr;
+        while (true)
+        {
+            slot = &m_slots[pos & (kSize - 1)];
+            size_t seq = slot->m_sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<ptrdiff_t>(seq - pos);
+            if (diff == 0)
+            {
+                if (m_pushPos.compare_exchange_weak(pos, pos + 1))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_pushPos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->m_record = std::move(record);
+        slot->m_sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Moves the oldest record into \p record, returns false if there is
+    /// none or it has not been completely pushed yet.
+    bool pop(LogRecord &record)
+    {
+        size_t pos = m_popPos.load(std::memory_order_relaxed);
+        Slot &slot = m_slots[pos & (kSize - 1)];
+        if (slot.m_sequence.load(std::memory_order_acquire) != pos + 1)
+            return false;
+        record = std::move(slot.m_record);
+        slot.m_sequence.store(pos + kSize, std::memory_order_release);
+        m_popPos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// True if no record is queued or being queued.
+    bool isEmpty(void) const
+    {
+        return m_pushPos.load() == m_popPos.load();
+    }
+
+  private:
+    static constexpr size_t kSize { 4096 }; // must be a power of two
+
+    struct Slot
+    {
+        std::atomic<size_t> m_sequence {0};
+        LogRecord           m_record;
+    };
+
+    std::array<Slot, kSize> m_slots;
+    alignas(64) std::atomic<size_t> m_pushPos {0};
+    alignas(64) std::atomic<size_t> m_popPos  {0};
+};
+
+/// The queue is created on first use, as LOG() may be called by static
+/// initializers.
+static LogRecordQueue &logRecords(void)
+{
+    static LogRecordQueue s_queue;
+    return s_queue;
+}
+
+// Records the logging thread handles between checks for Qt events
+static constexpr int kMaxRecordsPerLoop { 256 };
+
 static QMutex                  logQueueMutex;
-static QQueue<LoggingItem *>   logQueue;
+static std::atomic<bool>       logThreadWaiting {false};
+static std::atomic<uint>       logDropped {0};
 
 static LoggerThread           *logThread = nullptr;
 static QMutex                  logThreadMutex;
@@ -122,17 +217,6 @@ void resetLogging(void)
     verboseInit();
 }
 
-LoggingItem::LoggingItem(const char *_file, const char *_function,
-                         int _line, LogLevel_t _level, LoggingType _type) :
-        ReferenceCounter("LoggingItem", false),
-        m_threadId((uint64_t)(QThread::currentThreadId())),
-        m_line(_line), m_type(_type), m_level(_level),
-        m_file(_file), m_function(_function)
-{
-    m_epoch = nowAsDuration<std::chrono::microseconds>();
-    setThreadTid();
-}
-
 QByteArray LoggingItem::toByteArray(void)
 {
     QVariantMap variant = QJsonWrapper::qobject2qvariant(this);
@@ -168,35 +252,35 @@ int64_t LoggingItem::getThreadTid(void)
     return m_tid;
 }
 
-/// \brief Set the thread ID of the thread that produced the LoggingItem.  This
-///        code is actually run in the thread in question as part of the call
-///        to LOG()
+/// \brief Get the thread ID of the calling thread, as part of the call to
+///        LOG().  It is looked up once per thread and remembered.
 /// \note  In different platforms, the actual value returned here will vary.
 ///        The intention is to get a thread ID that will map well to what is
 ///        shown in gdb.
-void LoggingItem::setThreadTid(void)
+static int64_t current_thread_tid(uint64_t threadId)
 {
-    QMutexLocker locker(&logThreadTidMutex);
+    thread_local int64_t t_tid = -1;
 
-    m_tid = logThreadTidHash.value(m_threadId, -1);
-    if (m_tid == -1)
+    if (t_tid == -1)
     {
-        m_tid = 0;
+        t_tid = 0;
 
 #if defined(Q_OS_ANDROID)
-        m_tid = (int64_t)gettid();
+        t_tid = (int64_t)gettid();
 #elif defined(linux)
-        m_tid = syscall(SYS_gettid);
+        t_tid = syscall(SYS_gettid);
 #elif defined(__FreeBSD__)
         long lwpid;
         int dummy = thr_self( &lwpid );
         (void)dummy;
-        m_tid = (int64_t)lwpid;
+        t_tid = (int64_t)lwpid;
 #elif CONFIG_DARWIN
-        m_tid = (int64_t)mach_thread_self();
+        t_tid = (int64_t)mach_thread_self();
 #endif
-        logThreadTidHash[m_threadId] = m_tid;
+        QMutexLocker locker(&logThreadTidMutex);
+        logThreadTidHash[threadId] = t_tid;
     }
+    return t_tid;
 }
 
 /// \brief Convert numerical timestamp to a readable date and time.
@@ -274,32 +358,45 @@ void LoggerThread::run(void)
     LOG(VB_GENERAL, LOG_INFO, "Added logging to the console");
 
     bool dieNow = false;
+    LogRecordQueue &queue = logRecords();
+    LogRecord record;
 
     QMutexLocker qLock(&logQueueMutex);
 
-    while (!m_aborted || !logQueue.isEmpty())
+    while (!m_aborted || !queue.isEmpty())
     {
         qLock.unlock();
         qApp->processEvents(QEventLoop::AllEvents, 10);
         qApp->sendPostedEvents(nullptr, QEvent::DeferredDelete);
 
-        qLock.relock();
-        if (logQueue.isEmpty())
+        // Records are taken without the lock, LOG() never waits for it.
+        int handled = 0;
+        while (handled < kMaxRecordsPerLoop && queue.pop(record))
         {
-            m_waitEmpty->wakeAll();
-            m_waitNotEmpty->wait(qLock.mutex(), 100);
-            continue;
+            handleRecord(record);
+            handled++;
         }
 
-        LoggingItem *item = logQueue.dequeue();
-        qLock.unlock();
-
-        fillItem(item);
-        handleItem(item);
-        logConsole(item);
-        item->DecrRef();
+        uint dropped = logDropped.exchange(0);
+        if (dropped)
+        {
+            LOG(VB_GENERAL, LOG_WARNING,
+                QString("Dropped %1 log messages, the queue was full")
+                    .arg(dropped));
+        }
 
         qLock.relock();
+        if (handled == 0 && queue.isEmpty())
+        {
+            m_waitEmpty->wakeAll();
+
+            // LOG() only wakes us if it sees this flag, so check the queue
+            // once more after setting it.
+            logThreadWaiting = true;
+            if (queue.isEmpty())
+                m_waitNotEmpty->wait(qLock.mutex(), 100);
+            logThreadWaiting = false;
+        }
     }
 
     qLock.unlock();
@@ -316,6 +413,51 @@ void LoggerThread::run(void)
     }
 }
 
+/// \brief  Turns a queued LogRecord into a LoggingItem and handles it.
+void LoggerThread::handleRecord(LogRecord &record)
+{
+    LoggingItem *item = LoggingItem::create(record);
+    fillItem(item);
+    handleItem(item);
+    logConsole(item);
+    item->DecrRef();
+}
+
+/// \brief  Queues a LogRecord for the logging thread, waking it if it is
+///         waiting.  If the queue is full the caller waits for the logging
+///         thread to make room, unless there is no logging thread to wait
+///         for, in which case the record is dropped.
+/// \param  record  The LogRecord to queue, its message is moved
+void LoggerThread::queueRecord(LogRecord &record)
+{
+    LogRecordQueue &queue = logRecords();
+
+    while (!queue.push(record))
+    {
+        LoggerThread *thread = logThread;
+        if (!thread || logThreadFinished ||
+            QThread::currentThread() == thread->qthread())
+        {
+            logDropped++;
+            return;
+        }
+
+        QMutexLocker qLock(&logQueueMutex);
+        thread->m_waitNotEmpty->wakeAll();
+        qLock.unlock();
+        std::this_thread::yield();
+    }
+
+    // Pairs with the logging thread setting logThreadWaiting before it
+    // checks the queue a last time, so that one of us sees the other.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (logThreadWaiting && logThread)
+    {
+        QMutexLocker qLock(&logQueueMutex);
+        logThread->m_waitNotEmpty->wakeAll();
+    }
+}
+
 /// \brief  Handles each LoggingItem.  There is a special case for
 ///         thread registration and deregistration which are also included in
 ///         the logging queue to keep the thread names in sync with the log
@@ -499,14 +641,14 @@ bool LoggerThread::flush(int timeoutMS)
 {
     QElapsedTimer t;
     t.start();
-    while (!m_aborted && !logQueue.isEmpty() && !t.hasExpired(timeoutMS))
+    while (!m_aborted && !logRecords().isEmpty() && !t.hasExpired(timeoutMS))
     {
         m_waitNotEmpty->wakeAll();
         int left = timeoutMS - t.elapsed();
         if (left > 0)
             m_waitEmpty->wait(&logQueueMutex, left);
     }
-    return logQueue.isEmpty();
+    return logRecords().isEmpty();
 }
 
 void LoggerThread::fillItem(LoggingItem *item)
@@ -523,19 +665,25 @@ void LoggerThread::fillItem(LoggingItem *item)
 }
 
 
-/// \brief  Create a new LoggingItem
-/// \param  _file   filename of the source file where the log message is from
-/// \param  _function source function where the log message is from
-/// \param  _line   line number in the source where the log message is from
-/// \param  _level  logging level of the message (LogLevel_t)
-/// \param  _type   type of logging message
+/// \brief  Create a new LoggingItem from a queued log message
+/// \param  record  the queued log message, its message is moved
 /// \return LoggingItem that was created
-LoggingItem *LoggingItem::create(const char *_file,
-                                 const char *_function,
-                                 int _line, LogLevel_t _level,
-                                 LoggingType _type)
+LoggingItem *LoggingItem::create(LogRecord &record)
 {
-    auto *item = new LoggingItem(_file, _function, _line, _level, _type);
+    auto *item = new LoggingItem;
+
+    item->m_threadId = record.m_threadId;
+    item->m_tid      = record.m_tid;
+    item->m_line     = record.m_line;
+    item->m_type     = (LoggingType)record.m_type;
+    item->m_level    = record.m_level;
+    item->m_epoch    = record.m_epoch;
+    item->m_file     = record.m_file;
+    item->m_function = record.m_function;
+    if (record.m_type & kRegistering)
+        item->m_threadName = std::move(record.m_message);
+    else
+        item->m_message = std::move(record.m_message);
 
     return item;
 }
@@ -552,8 +700,10 @@ LoggingItem *LoggingItem::create(QByteArray &buf)
 }
 
 
-/// \brief  Format and send a log message into the queue.  This is called from
-///         the LOG() macro.  The intention is minimal blocking of the caller.
+/// \brief  Send a log message into the queue.  This is called from the LOG()
+///         macro.  The intention is minimal blocking of the caller, so all
+///         formatting besides that of the message itself is left to the
+///         logging thread.
 /// \param  mask    Verbosity mask of the message (VB_*)
 /// \param  level   Log level of this message (LOG_* - matching syslog levels)
 /// \param  file    Filename of source code logging the message
@@ -566,36 +716,38 @@ void LogPrintLine( uint64_t mask, LogLevel_t level, const char *file, int line,
     int type = kMessage;
     type |= (mask & VB_FLUSH) ? kFlush : 0;
     type |= (mask & VB_STDIO) ? kStandardIO : 0;
-    LoggingItem *item = LoggingItem::create(file, function, line, level,
-                                            (LoggingType)type);
-    if (!item)
-        return;
-
-    item->m_message = std::move(message);
-
-    QMutexLocker qLock(&logQueueMutex);
 
 #if defined( _MSC_VER ) && defined( _DEBUG )
-        OutputDebugStringA( qPrintable(item->m_message) );
+        OutputDebugStringA( qPrintable(message) );
         OutputDebugStringA( "\n" );
 #endif
 
-    logQueue.enqueue(item);
+    LogRecord record;
+    record.m_file     = file;
+    record.m_function = function;
+    record.m_line     = line;
+    record.m_type     = type;
+    record.m_level    = level;
+    record.m_threadId = (uint64_t)(QThread::currentThreadId());
+    record.m_tid      = current_thread_tid(record.m_threadId);
+    record.m_epoch    = nowAsDuration<std::chrono::microseconds>();
+    record.m_message  = std::move(message);
+    LoggerThread::queueRecord(record);
 
     if (logThread && logThreadFinished && !logThread->isRunning())
     {
-        while (!logQueue.isEmpty())
+        QMutexLocker qLock(&logQueueMutex);
+        while (logRecords().pop(record))
         {
-            item = logQueue.dequeue();
-            qLock.unlock();
+            LoggingItem *item = LoggingItem::create(record);
             logThread->handleItem(item);
             logThread->logConsole(item);
             item->DecrRef();
-            qLock.relock();
         }
     }
     else if (logThread && !logThreadFinished && (type & kFlush))
     {
+        QMutexLocker qLock(&logQueueMutex);
         logThread->flush();
     }
 }
@@ -731,16 +883,17 @@ void loggingRegisterThread(const QString &name)
     if (logThreadFinished)
         return;
 
-    QMutexLocker qLock(&logQueueMutex);
-
-    LoggingItem *item = LoggingItem::create(__FILE__, __FUNCTION__,
-                                            __LINE__, LOG_DEBUG,
-                                            kRegistering);
-    if (item)
-    {
-        item->setThreadName((char *)name.toLocal8Bit().constData());
-        logQueue.enqueue(item);
-    }
+    LogRecord record;
+    record.m_file     = __FILE__;
+    record.m_function = __FUNCTION__;
+    record.m_line     = __LINE__;
+    record.m_type     = kRegistering;
+    record.m_level    = LOG_DEBUG;
+    record.m_threadId = (uint64_t)(QThread::currentThreadId());
+    record.m_tid      = current_thread_tid(record.m_threadId);
+    record.m_epoch    = nowAsDuration<std::chrono::microseconds>();
+    record.m_message  = name;
+    LoggerThread::queueRecord(record);
 }
 
 /// \brief  Deregister the current thread's name.  This is triggered by the
@@ -750,13 +903,16 @@ void loggingDeregisterThread(void)
     if (logThreadFinished)
         return;
 
-    QMutexLocker qLock(&logQueueMutex);
-
-    LoggingItem *item = LoggingItem::create(__FILE__, __FUNCTION__, __LINE__,
-                                            LOG_DEBUG,
-                                            kDeregistering);
-    if (item)
-        logQueue.enqueue(item);
+    LogRecord record;
+    record.m_file     = __FILE__;
+    record.m_function = __FUNCTION__;
+    record.m_line     = __LINE__;
+    record.m_type     = kDeregistering;
+    record.m_level    = LOG_DEBUG;
+    record.m_threadId = (uint64_t)(QThread::currentThreadId());
+    record.m_tid      = current_thread_tid(record.m_threadId);
+    record.m_epoch    = nowAsDuration<std::chrono::microseconds>();
+    LoggerThread::queueRecord(record);
 }
 
 
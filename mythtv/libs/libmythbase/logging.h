@@ -3,7 +3,6 @@
 
 #include <QMutexLocker>
 #include <QMutex>
-#include <QQueue>
 #include <QPointer>
 #include <QCoreApplication>
 
@@ -50,6 +49,22 @@ class LoggerThread;
 
 using tmType = struct tm;
 
+/// \brief A log message as queued by LOG().  It is turned into a LoggingItem
+///        by the logging thread, so that the thread calling LOG() does not
+///        have to allocate anything or convert the file and function names.
+struct LogRecord
+{
+    const char     *m_file       {nullptr}; ///< __FILE__, never freed
+    const char     *m_function   {nullptr}; ///< __FUNCTION__, never freed
+    int             m_line       {0};
+    int             m_type       {kMessage};
+    LogLevel_t      m_level      {LOG_INFO};
+    qulonglong      m_threadId   {UINT64_MAX};
+    qlonglong       m_tid        {0};
+    std::chrono::microseconds m_epoch {0us};
+    QString         m_message    {};        ///< thread name if registering
+};
+
 /// \brief The logging items that are generated by LOG() and are sent to the
 ///        console
 class LoggingItem: public QObject, public ReferenceCounter
@@ -73,15 +88,11 @@ class LoggingItem: public QObject, public ReferenceCounter
     Q_PROPERTY(QString message READ message WRITE setMessage)
 
     friend class LoggerThread;
-    friend void LogPrintLine(uint64_t mask, LogLevel_t level, const char *file, int line,
-                             const char *function, QString message);
 
   public:
     QString getThreadName(void);
     int64_t getThreadTid(void);
-    void setThreadTid(void);
-    static LoggingItem *create(const char *_file, const char *_function, int _line, LogLevel_t _level,
-                               LoggingType _type);
+    static LoggingItem *create(LogRecord &record);
     static LoggingItem *create(QByteArray &buf);
     QByteArray toByteArray(void);
     QString getTimestamp(const char *format = "yyyy-MM-dd HH:mm:ss") const;
@@ -142,8 +153,6 @@ class LoggingItem: public QObject, public ReferenceCounter
   private:
     LoggingItem()
         : ReferenceCounter("LoggingItem", false) {};
-    LoggingItem(const char *_file, const char *_function,
-                int _line, LogLevel_t _level, LoggingType _type);
     Q_DISABLE_COPY(LoggingItem);
 };
 
@@ -164,12 +173,16 @@ class LoggerThread : public QObject, public MThread
     bool flush(int timeoutMS = 200000);
     static void handleItem(LoggingItem *item);
     void fillItem(LoggingItem *item);
+    void handleRecord(LogRecord &record);
+    static void queueRecord(LogRecord &record);
   private:
     Q_DISABLE_COPY(LoggerThread);
     QWaitCondition *m_waitNotEmpty {nullptr};
                                     ///< Condition variable for waiting
                                     ///  for the queue to not be empty
                                     ///  Protected by logQueueMutex
+                                    ///  Only waited on when
+                                    ///  logThreadWaiting is set
     QWaitCondition *m_waitEmpty    {nullptr};
                                     ///< Condition variable for waiting
                                     ///  for the queue to be empty
@@ -1684,9 +1684,10 @@ bool MythCoreContext::CheckProtoVersion(MythSocket *socket,
     if (!socket)
         return false;
 
-    QStringList strlist(QString("MYTH_PROTO_VERSION %1 %2")
+    QStringList strlist(QString("MYTH_PROTO_VERSION %1 %2 %3")
                         .arg(MYTH_PROTO_VERSION,
-                             QString::fromUtf8(MYTH_PROTO_TOKEN)));
+                             QString::fromUtf8(MYTH_PROTO_TOKEN),
+                             MythSocket::kBinaryFramingCapability));
     socket->WriteStringList(strlist);
 
     if (!socket->ReadStringList(strlist, timeout) || strlist.empty())
@@ -1726,6 +1727,8 @@ bool MythCoreContext::CheckProtoVersion(MythSocket *socket,
                                      QString::fromUtf8(MYTH_PROTO_TOKEN)));
         }
 
+        socket->SetBinaryFraming(
+            strlist.mid(2).contains(MythSocket::kBinaryFramingCapability));
         return true;
     }
 
@@ -46,6 +46,7 @@
 #include <QDataStream>
 #include <QRegularExpression>
 #include <QRegularExpressionMatchIterator>
+#include <QtEndian>
 
 // Myth headers
 #include "mythcorecontext.h"
@@ -54,6 +55,7 @@
 #include "mythsocket.h"
 #include "mythcoreutil.h"
 #include "mythsystemlegacy.h"
+#include "filehashcache.h"
 
 #include "mythconfig.h" // for CONFIG_DARWIN
 
@@ -593,8 +595,30 @@ bool IsMACAddress(const QString& MAC)
     return true;
 }
 
+/**
+ * \brief Returns the hash used to identify video files, of the file's size
+ *        and its first and last 64 KiB, summed as little endian 64 bit words.
+ *
+ * Files that have been hashed before are not read again while they are
+ * unchanged, see FileHashCache.
+ */
 QString FileHash(const QString& filename)
 {
+    return FileHashCache::GetGlobal()->Hash(filename);
+}
+
+/**
+ * \brief Returns the FileHash() of a file, always reading it.
+ *
+ * Both blocks are read whole rather than a word at a time.  The hash is
+ * the same as when it was read through a QDataStream: a partial word at
+ * the end of a file is not summed, and neither is the last block of a
+ * file that is smaller than a block.
+ */
+QString ReadFileHash(const QString& filename)
+{
+    static constexpr qint64 kBlockSize { 65536 };
+
     QFile file(filename);
     QFileInfo fileinfo(file);
     qint64 initialsize = fileinfo.size();
@@ -612,21 +636,21 @@ QString FileHash(const QString& filename)
         return QString("NULL");
     }
 
-    file.seek(0);
-    QDataStream stream(&file);
-    stream.setByteOrder(QDataStream::LittleEndian);
-    for (quint64 tmp = 0, i = 0; i < 65536/sizeof(tmp); i++)
-    {
-        stream >> tmp;
-        hash += tmp;
-    }
+    QByteArray block(kBlockSize, Qt::Uninitialized);
 
-    file.seek(initialsize - 65536);
-    for (quint64 tmp = 0, i = 0; i < 65536/sizeof(tmp); i++)
+    auto sum_block = [&](qint64 offset)
     {
-        stream >> tmp;
-        hash += tmp;
-    }
+        if (!file.seek(offset))
+            return;
+
+        qint64 len = file.read(block.data(), kBlockSize);
+        for (qint64 i = 0; i + 8 <= len; i += 8)
+            hash += qFromLittleEndian<quint64>(block.constData() + i);
+    };
+
+    sum_block(0);
+    if (initialsize >= kBlockSize)
+        sum_block(initialsize - kBlockSize);
 
     file.close();
 
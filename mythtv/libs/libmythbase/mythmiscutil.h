@@ -85,6 +85,7 @@ MBASE_PUBLIC bool MythWakeup(const QString &wakeUpCommand,
     uint flags = kMSNone, std::chrono::seconds timeout = 0s);
 
 MBASE_PUBLIC QString FileHash(const QString& filename);
+MBASE_PUBLIC QString ReadFileHash(const QString& filename);
 
 /// Is A/V Sync destruction daemon is running on this host?
 MBASE_PUBLIC bool IsPulseAudioRunning(void);
@@ -8,6 +8,7 @@
 #include <QHostInfo>
 #include <QThread>
 #include <QMetaType>
+#include <QtEndian>
 
 // setsockopt -- has to be after Qt includes for Q_OS_WIN definition
 #if defined(Q_OS_WIN)
@@ -17,6 +18,11 @@
 #else
 #include <sys/socket.h>
 #endif
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <poll.h>
+#include <cerrno>
+#endif
 #include <unistd.h> // for usleep (and socket code on Q_OS_WIN)
 #include <algorithm> // for min/max
 using std::max;
@@ -63,6 +69,196 @@ static int x6 = qRegisterMetaType< QHostAddress >();
 int s_dummy_meta_variable_to_suppress_gcc_warning =
     x0 + x1 + x2 + x3 + x4 + x5 + x6;
 
+/*
+ * Binary framing of string lists
+ *
+ * The text framing sends the list joined with "[]:[]", prefixed with its
+ * size as 8 ASCII digits and spaces.  A binary frame starts with an 8 byte
+ * header whose first byte can never start a text size prefix:
+ *
+ *   byte 0    kBinaryFrameMagic
+ *   byte 1    flags, kBinaryFrameCompressed if the payload is qCompress()ed
+ *   byte 2-3  reserved, 0
+ *   byte 4-7  payload size, big endian
+ *
+ * The payload is a varint (7 bits per byte, low bits first) per string.
+ * If its low bit is set, the rest of it is the zigzag encoded value of a
+ * string holding a decimal integer, such as most fields of a ProgramInfo.
+ * Otherwise the rest is the size of the UTF-8 string that follows.
+ */
+static constexpr uchar kBinaryFrameMagic      { 0xFF };
+static constexpr uchar kBinaryFrameCompressed { 0x01 };
+
+// Payloads of at least this many bytes are sent compressed if that helps
+static constexpr int kBinaryCompressMinSize { 4096 };
+
+// Largest size the 8 digit text size prefix can hold
+static constexpr int kMaxFrameSize { 99999999 };
+
+static void put_varint(QByteArray &buf, quint64 value)
+{
+    while (value >= 0x80)
+    {
+        buf.append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buf.append(static_cast<char>(value));
+}
+
+static bool get_varint(const char *&p, const char *end, quint64 &value)
+{
+    value = 0;
+    for (int shift = 0; (shift < 64) && (p < end); shift += 7)
+    {
+        auto byte = static_cast<uchar>(*p++);
+        value |= static_cast<quint64>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/// Returns true if \p str is a decimal integer that QString::number()
+/// turns back into exactly \p str, i.e. without a '+' or leading zeros.
+static bool to_packed_int(const QString &str, qint64 &value)
+{
+    int len = str.size();
+    int i = (len > 0 && str[0] == '-') ? 1 : 0;
+    if ((len == i) || (len - i > 18))
+        return false;
+    if ((str[i] == '0') && ((len - i > 1) || (i == 1)))
+        return false;
+
+    value = 0;
+    for (; i < len; ++i)
+    {
+        ushort c = str[i].unicode();
+        if ((c < '0') || (c > '9'))
+            return false;
+        value = (value * 10) + (c - '0');
+    }
+    if (str[0] == '-')
+        value = -value;
+    return true;
+}
+
+/// Reads the payload size from the header of a binary frame.
+/// \return false if it is too large to be a valid frame.
+static bool get_binary_frame_size(const char *header, int &size)
+{
+    quint32 value = qFromBigEndian<quint32>(header + 4);
+    if (value > kMaxFrameSize)
+        return false;
+    size = static_cast<int>(value);
+    return true;
+}
+
+/// Encodes \p list as a binary frame, header included.
+QByteArray MythSocket::ToBinaryFrame(const QStringList &list)
+{
+    QByteArray payload;
+    payload.reserve(list.size() * 8);
+    for (const auto &str : list)
+    {
+        qint64 value = 0;
+        if (to_packed_int(str, value))
+        {
+            auto zigzag = (static_cast<quint64>(value) << 1) ^
+                          static_cast<quint64>(value >> 63);
+            put_varint(payload, (zigzag << 1) | 1);
+        }
+        else
+        {
+            QByteArray utf8 = str.toUtf8();
+            put_varint(payload, static_cast<quint64>(utf8.size()) << 1);
+            payload += utf8;
+        }
+    }
+
+    uchar flags = 0;
+    if (payload.size() >= kBinaryCompressMinSize)
+    {
+        QByteArray compressed = qCompress(payload, 1);
+        if (compressed.size() < payload.size())
+        {
+            payload = compressed;
+            flags |= kBinaryFrameCompressed;
+        }
+    }
+
+    QByteArray frame(8, '\0');
+    frame[0] = static_cast<char>(kBinaryFrameMagic);
+    frame[1] = static_cast<char>(flags);
+    qToBigEndian<quint32>(payload.size(), frame.data() + 4);
+    frame += payload;
+    return frame;
+}
+
+static bool from_binary_payload(QByteArray payload, uchar flags,
+                                QStringList &list)
+{
+    if (flags & kBinaryFrameCompressed)
+    {
+        // qUncompress() trusts the size in front of the data
+        if ((payload.size() < 4) ||
+            (qFromBigEndian<quint32>(payload.constData()) > kMaxFrameSize))
+            return false;
+        payload = qUncompress(payload);
+        if (payload.isEmpty())
+            return false;
+    }
+
+    const char *p   = payload.constData();
+    const char *end = p + payload.size();
+    while (p < end)
+    {
+        quint64 field = 0;
+        if (!get_varint(p, end, field))
+            return false;
+
+        if (field & 1)
+        {
+            quint64 zigzag = field >> 1;
+            auto value = static_cast<qint64>(zigzag >> 1) ^
+                         -static_cast<qint64>(zigzag & 1);
+            list << QString::number(value);
+        }
+        else
+        {
+            quint64 size = field >> 1;
+            if (size > static_cast<quint64>(end - p))
+                return false;
+            list << QString::fromUtf8(p, static_cast<int>(size));
+            p += size;
+        }
+    }
+    return true;
+}
+
+/** \brief Decodes a binary frame, header included.
+ *  \return false unless \p frame holds exactly one valid frame.
+ */
+bool MythSocket::FromBinaryFrame(const QByteArray &frame, QStringList &list)
+{
+    list.clear();
+
+    int size = 0;
+    if ((frame.size() < 8) ||
+        (static_cast<uchar>(frame[0]) != kBinaryFrameMagic) ||
+        !get_binary_frame_size(frame.constData(), size) ||
+        (size < 1) || (frame.size() - 8 != size))
+    {
+        return false;
+    }
+
+    if (!from_binary_payload(frame.mid(8), static_cast<uchar>(frame[1]), list))
+    {
+        list.clear();
+        return false;
+    }
+    return true;
+}
+
 static QString to_sample(const QByteArray &payload)
 {
     QString sample("");
@@ -418,9 +614,10 @@ bool MythSocket::Validate(std::chrono::milliseconds timeout, bool error_dialog_d
     if (m_isValidated)
         return true;
 
-    QStringList strlist(QString("MYTH_PROTO_VERSION %1 %2")
+    QStringList strlist(QString("MYTH_PROTO_VERSION %1 %2 %3")
                         .arg(MYTH_PROTO_VERSION,
-                             QString::fromUtf8(MYTH_PROTO_TOKEN)));
+                             QString::fromUtf8(MYTH_PROTO_TOKEN),
+                             kBinaryFramingCapability));
 
     WriteStringList(strlist);
 
@@ -454,6 +651,7 @@ bool MythSocket::Validate(std::chrono::milliseconds timeout, bool error_dialog_d
     {
         LOG(VB_GENERAL, LOG_NOTICE, QString("Using protocol version %1 %2")
             .arg(MYTH_PROTO_VERSION, QString::fromUtf8(MYTH_PROTO_TOKEN)));
+        SetBinaryFraming(strlist.mid(2).contains(kBinaryFramingCapability));
         m_isValidated = true;
     }
     else
@@ -551,6 +749,93 @@ int MythSocket::Read(char *data, int size,  std::chrono::milliseconds max_wait)
     return ret;
 }
 
+/** \brief Returns true if SendFile() is available on this platform.
+ */
+bool MythSocket::CanSendFile(void)
+{
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+/** \brief Sends \p size bytes of the file \p fd, starting at \p offset,
+ *         straight from the kernel to the socket.
+ *
+ *  The data is neither copied into user space nor through the write buffer
+ *  of the QTcpSocket, and is sent from the calling thread. Anything still
+ *  in that write buffer is sent first, which needs a trip to the socket
+ *  thread. Blocks until all of the data has been handed to the kernel.
+ *
+ *  \return the number of bytes sent, which is less than \p size if the
+ *          file ends first, or -1 on error or if !CanSendFile().
+ */
+int MythSocket::SendFile(int fd, long long offset, int size)
+{
+#ifdef __linux__
+    if (m_writesBuffered.fetchAndStoreOrdered(0))
+    {
+        bool ok = false;
+        QMetaObject::invokeMethod(
+            this, "FlushWritesReal",
+            (QThread::currentThread() != m_thread->qthread()) ?
+            Qt::BlockingQueuedConnection : Qt::DirectConnection,
+            Q_ARG(bool*, &ok));
+        if (!ok)
+            return -1;
+    }
+
+    int sock = GetSocketDescriptor();
+    if (sock < 0)
+        return -1;
+
+    off_t pos = offset;
+    int sent = 0;
+    while (sent < size)
+    {
+        ssize_t ret = sendfile(sock, fd, &pos, size - sent);
+        if (ret > 0)
+        {
+            sent += ret;
+            continue;
+        }
+        if (ret == 0)
+            break; // end of file
+
+        if (errno == EINTR)
+            continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "SendFile: Error, sendfile" + ENO);
+            return -1;
+        }
+
+        // The socket is non-blocking, wait for room in its send buffer
+        pollfd pfd { sock, POLLOUT, 0 };
+        int ready = poll(&pfd, 1, kLongTimeout.count());
+        if (ready == 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("SendFile: Error, timed out after %1 of %2 bytes")
+                    .arg(sent).arg(size));
+            return -1;
+        }
+        if ((ready < 0) && (errno != EINTR))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "SendFile: Error, poll" + ENO);
+            return -1;
+        }
+    }
+    return sent;
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(offset);
+    Q_UNUSED(size);
+    return -1;
+#endif
+}
+
 void MythSocket::Reset(void)
 {
     QMetaObject::invokeMethod(
@@ -717,31 +1002,58 @@ void MythSocket::WriteStringListReal(const QStringList *list, bool *ret)
         return;
     }
 
-    QString str = list->join("[]:[]");
-    if (str.isEmpty())
+    QByteArray payload;
+    bool binary = IsBinaryFraming();
+    if (binary)
     {
-        LOG(VB_GENERAL, LOG_ERR, LOC +
-            "WriteStringList: Error, joined null string.");
-        *ret = false;
-        return;
+        // Refused like the joined null string of the text framing
+        if (list->isEmpty() ||
+            ((list->size() == 1) && list->constFirst().isEmpty()))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                "WriteStringList: Error, empty string list.");
+            *ret = false;
+            return;
+        }
+        payload = ToBinaryFrame(*list);
     }
+    else
+    {
+        QString str = list->join("[]:[]");
+        if (str.isEmpty())
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                "WriteStringList: Error, joined null string.");
+            *ret = false;
+            return;
+        }
 
-    QByteArray utf8 = str.toUtf8();
-    int size = utf8.length();
+        QByteArray utf8 = str.toUtf8();
+        payload = payload.setNum(utf8.length());
+        payload += "        ";
+        payload.truncate(8);
+        payload += utf8;
+    }
+    int size = payload.length();
     int written = 0;
     int written_since_timer_restart = 0;
 
-    QByteArray payload;
-    payload = payload.setNum(size);
-    payload += "        ";
-    payload.truncate(8);
-    payload += utf8;
-    size = payload.length();
+    if (size - 8 > kMaxFrameSize)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("WriteStringList: Error, %1 bytes is too large.")
+                .arg(size - 8));
+        *ret = false;
+        return;
+    }
 
     if (VERBOSE_LEVEL_CHECK(VB_NETWORK, LOG_INFO))
     {
         QString msg = QString("write -> %1 %2")
-            .arg(m_tcpSocket->socketDescriptor(), 2).arg(payload.data());
+            .arg(m_tcpSocket->socketDescriptor(), 2)
+            .arg(binary ? QString("[binary %1 bytes] %2")
+                              .arg(size - 8).arg(list->join("[]:[]"))
+                        : QString(payload.data()));
 
         if (logLevel < LOG_DEBUG && msg.length() > 128)
         {
@@ -796,6 +1108,8 @@ void MythSocket::WriteStringListReal(const QStringList *list, bool *ret)
     }
 
     m_tcpSocket->flush();
+    if (m_tcpSocket->bytesToWrite() > 0)
+        m_writesBuffered.fetchAndStoreOrdered(1);
 
     *ret = true;
 }
@@ -843,9 +1157,19 @@ void MythSocket::ReadStringListReal(
         return;
     }
 
-    QString sizes = sizestr;
+    bool binary = static_cast<uchar>(sizestr[0]) == kBinaryFrameMagic;
+    auto flags = static_cast<uchar>(sizestr[1]);
     bool ok { false };
-    int btr = sizes.trimmed().toInt(&ok);
+    int btr = 0;
+    if (binary)
+    {
+        ok = get_binary_frame_size(sizestr.constData(), btr);
+    }
+    else
+    {
+        QString sizes = sizestr;
+        btr = sizes.trimmed().toInt(&ok);
+    }
 
     if (btr < 1)
     {
@@ -854,7 +1178,8 @@ void MythSocket::ReadStringListReal(
             QString("Protocol error: %1'%2' is not a valid size "
                     "prefix. %3 bytes pending.")
                 .arg(ok ? "" : "(parse failed) ",
-                     sizestr.data(), QString::number(pending)));
+                     binary ? QString("binary frame") : QString(sizestr.data()),
+                     QString::number(pending)));
         ResetReal();
         return;
     }
@@ -931,6 +1256,40 @@ void MythSocket::ReadStringListReal(
         }
     }
 
+    if (binary)
+    {
+        utf8.truncate(readoffset);
+        if (!from_binary_payload(utf8, flags, *list))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Protocol error: invalid binary frame of %1 bytes")
+                    .arg(readoffset));
+            list->clear();
+            ResetReal();
+            return;
+        }
+
+        if (VERBOSE_LEVEL_CHECK(VB_NETWORK, LOG_INFO))
+        {
+            QString msg = QString("read  <- %1 [binary %2 bytes] %3")
+                .arg(m_tcpSocket->socketDescriptor(), 2)
+                .arg(readoffset).arg(list->join("[]:[]"));
+
+            if (logLevel < LOG_DEBUG && msg.length() > 128)
+            {
+                msg.truncate(127);
+                msg += "…";
+            }
+            LOG(VB_NETWORK, LOG_INFO, LOC + msg);
+        }
+
+        m_dataAvailable.fetchAndStoreOrdered(
+            (m_tcpSocket->bytesAvailable() > 0) ? 1 : 0);
+
+        *ret = true;
+        return;
+    }
+
     QString str = QString::fromUtf8(utf8.data());
 
     if (VERBOSE_LEVEL_CHECK(VB_NETWORK, LOG_INFO))
@@ -964,6 +1323,24 @@ void MythSocket::ReadStringListReal(
 void MythSocket::WriteReal(const char *data, int size, int *ret)
 {
     *ret = m_tcpSocket->write(data, size);
+    if (m_tcpSocket->bytesToWrite() > 0)
+        m_writesBuffered.fetchAndStoreOrdered(1);
+}
+
+void MythSocket::FlushWritesReal(bool *ret)
+{
+    while (m_tcpSocket->bytesToWrite() > 0)
+    {
+        if (!m_tcpSocket->waitForBytesWritten(kLongTimeout.count()))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "FlushWrites: Error, " +
+                QString("%1 bytes not written")
+                    .arg(m_tcpSocket->bytesToWrite()));
+            *ret = false;
+            return;
+        }
+    }
+    *ret = true;
 }
 
 void MythSocket::ReadReal(char *data, int size, std::chrono::milliseconds max_wait_ms, int *ret)
@@ -49,6 +49,13 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     void SetReadyReadCallbackEnabled(bool enabled)
         { m_disableReadyReadCallback.fetchAndStoreOrdered((enabled) ? 0 : 1); }
 
+    /// Writes string lists with binary framing, once the peer has said it
+    /// can read it. Both framings are always accepted when reading.
+    void SetBinaryFraming(bool enabled)
+        { m_binaryFraming.fetchAndStoreOrdered((enabled) ? 1 : 0); }
+    bool IsBinaryFraming(void) const
+        { return m_binaryFraming.loadAcquire() != 0; }
+
     bool SendReceiveStringList(
         QStringList &list, uint min_reply_length = 0,
         std::chrono::milliseconds timeoutMS = kLongTimeout);
@@ -66,11 +73,20 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     // RemoteFile stuff
     int Write(const char *data, int size);
     int Read(char *data, int size,  std::chrono::milliseconds max_wait);
+    int SendFile(int fd, long long offset, int size);
+    static bool CanSendFile(void);
+
+    static QByteArray ToBinaryFrame(const QStringList &list);
+    static bool FromBinaryFrame(const QByteArray &frame, QStringList &list);
     void Reset(void);
 
     static constexpr std::chrono::milliseconds kShortTimeout { kMythSocketShortTimeout };
     static constexpr std::chrono::milliseconds kLongTimeout  { kMythSocketLongTimeout };
 
+    /// Capability appended to MYTH_PROTO_VERSION, and to its ACCEPT reply,
+    /// by peers that can read binary framed string lists.
+    static constexpr const char *kBinaryFramingCapability { "BINARY" };
+
   signals:
     void CallReadyRead(void);
 
@@ -88,6 +104,7 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     void DisconnectFromHostReal(void);
 
     void WriteReal(const char *data, int size, int *ret);
+    void FlushWritesReal(bool *ret);
     void ReadReal(char *data, int size, std::chrono::milliseconds max_wait_ms, int *ret);
     void ResetReal(void);
 
@@ -105,6 +122,10 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     MythSocketCBs  *m_callback         {nullptr}; // only set in ctor
     bool            m_useSharedThread;            // only set in ctor
     QAtomicInt      m_disableReadyReadCallback {false};
+    QAtomicInt      m_binaryFraming    {0};
+    /// Set when the QTcpSocket may still hold data not yet sent,
+    /// which SendFile() has to wait for.
+    QAtomicInt      m_writesBuffered   {0};
     bool            m_connected        {false};   // protected by m_lock
     /// This is used internally as a hint that there might be
     /// data available for reading.
@@ -17,6 +17,15 @@
 /** \brief Increment this whenever the MythTV network protocol changes.
  *   Note that the token currently cannot contain spaces.
  *
+ *   Clients may follow the token with optional capabilities, separated by
+ *   spaces. The server lists those it supports after its ACCEPT reply, and
+ *   servers that know none of them just ignore them. Currently there is:
+ *
+ *   BINARY (MythSocket::kBinaryFramingCapability)
+ *       Both ends switch to binary framed string lists after the reply,
+ *       see MythSocket::ToBinaryFrame(). Bindings that don't send it keep
+ *       the text framing.
+ *
  *   You must also update this value and any corresponding changes to the
  *   ProgramInfo network protocol layout in the following files:
  *
@@ -345,4 +345,51 @@ void TestLogging::test_logPropagateCalc (void)
 
 // logPropagateCalc
 
-QTEST_APPLESS_MAIN(TestLogging)
+void TestLogging::benchmark_LOG_data (void)
+{
+    QTest::addColumn<int>("level");
+
+    QTest::newRow("filtered") << static_cast<int>(LOG_DEBUG);
+    QTest::newRow("queued")   << static_cast<int>(LOG_INFO);
+}
+
+// Time spent in LOG() by the calling thread, when the message is filtered
+// out by its level and when it is queued for the logging thread.
+void TestLogging::benchmark_LOG (void)
+{
+    QFETCH(int, level);
+
+    // Fewer messages than the queue holds, so that LOG() never has to wait
+    // for the logging thread within a round.
+    static constexpr int kMessages { 1000 };
+    static constexpr int kRounds   { 50 };
+    const QString message("Benchmark message");
+
+    resetLogging();
+    verboseMask |= VB_FLUSH;
+    logStart("", false, 1, 0, LOG_INFO, false, false, false);
+
+    auto best = std::chrono::nanoseconds::max();
+    for (int round = 0; round < kRounds; ++round)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kMessages; ++i)
+            LOG(VB_GENERAL, static_cast<LogLevel_t>(level), message);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+
+        // Let the logging thread empty the queue between rounds
+        LOG(VB_FLUSH, LOG_INFO, "Benchmark round done");
+    }
+
+    qDebug() << QString("%1 ns per LOG()")
+        .arg(best.count() / static_cast<double>(kMessages), 0, 'f', 1);
+}
+
+void TestLogging::cleanupTestCase (void)
+{
+    logStop();
+}
+
+// The logging thread needs an application object
+QTEST_GUILESS_MAIN(TestLogging)
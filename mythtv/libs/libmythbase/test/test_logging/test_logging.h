@@ -19,6 +19,8 @@
  */
 
 #include <QtTest/QtTest>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <sstream>
 
@@ -48,4 +50,7 @@ private slots:
     static void test_verboseArgParse_level(void);
     static void test_logPropagateCalc_data(void);
     static void test_logPropagateCalc(void);
+    static void benchmark_LOG_data(void);
+    static void benchmark_LOG(void);
+    static void cleanupTestCase(void);
 };
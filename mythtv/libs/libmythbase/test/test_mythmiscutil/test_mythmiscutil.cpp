@@ -20,6 +20,8 @@
 #include <iostream>
 #include "test_mythmiscutil.h"
 
+#include "filehashcache.h"
+
 void TestMiscUtil::test_parse_cmdline_data(void)
 {
     QTest::addColumn<QString>("input");
@@ -95,5 +97,156 @@ void TestMiscUtil::test_parse_cmdline(void)
     QCOMPARE(output, expectedOutput);
 }
 
+// Writes a file of pseudo random bytes
+static bool write_test_file(const QString &filename, qint64 size, uint seed)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (auto & byte : data)
+    {
+        seed = (seed * 1103515245) + 12345;
+        byte = static_cast<char>(seed >> 16);
+    }
+
+    QFile file(filename);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+           (file.write(data) == size);
+}
+
+// The hash as it was computed before FileHash() read whole blocks
+static QString stream_file_hash(const QString &filename)
+{
+    QFile file(filename);
+    qint64 initialsize = QFileInfo(file).size();
+    if ((initialsize == 0) || !file.open(QIODevice::ReadOnly))
+        return QString("NULL");
+
+    quint64 hash = initialsize;
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    for (quint64 tmp = 0, i = 0; i < 65536/sizeof(tmp); i++)
+    {
+        stream >> tmp;
+        hash += tmp;
+    }
+
+    file.seek(initialsize - 65536);
+    for (quint64 tmp = 0, i = 0; i < 65536/sizeof(tmp); i++)
+    {
+        stream >> tmp;
+        hash += tmp;
+    }
+
+    return QString("%1").arg(hash, 0, 16);
+}
+
+void TestMiscUtil::test_filehash_data(void)
+{
+    QTest::addColumn<qint64>("size");
+
+    QTest::newRow("empty")        << 0LL;
+    QTest::newRow("partial word") << 5LL;
+    QTest::newRow("one word")     << 8LL;
+    QTest::newRow("small")        << 1003LL;
+    QTest::newRow("block - 1")    << 65535LL;
+    QTest::newRow("block")        << 65536LL;
+    QTest::newRow("block + 1")    << 65537LL;
+    QTest::newRow("two blocks")   << 131072LL;
+    QTest::newRow("large")        << 1000003LL;
+}
+
+void TestMiscUtil::test_filehash(void)
+{
+    QFETCH(qint64, size);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString filename = dir.filePath("video.mkv");
+    QVERIFY(write_test_file(filename, size, static_cast<uint>(size)));
+
+    QCOMPARE(ReadFileHash(filename), stream_file_hash(filename));
+}
+
+void TestMiscUtil::test_filehash_cache(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString filename = dir.filePath("video.mkv");
+    QString journal = dir.filePath("cache/filehash.journal");
+    QVERIFY(write_test_file(filename, 200000, 1));
+
+    QString hash;
+    {
+        FileHashCache cache(journal);
+        QVERIFY(!cache.Lookup(filename, hash));
+        QCOMPARE(cache.Hash(filename), ReadFileHash(filename));
+        QVERIFY(cache.Lookup(filename, hash));
+        QCOMPARE(hash, ReadFileHash(filename));
+    }
+
+    // Kept in the journal
+    {
+        FileHashCache cache(journal);
+        hash.clear();
+        QVERIFY(cache.Lookup(filename, hash));
+        QCOMPARE(hash, ReadFileHash(filename));
+    }
+
+    // Changed files are read again
+    QVERIFY(write_test_file(filename, 300000, 2));
+    {
+        FileHashCache cache(journal);
+        QVERIFY(!cache.Lookup(filename, hash));
+        QCOMPARE(cache.Hash(filename), ReadFileHash(filename));
+        QVERIFY(cache.Lookup(filename, hash));
+    }
+
+    // Programs sharing the journal keep each other's hashes
+    QString other = dir.filePath("other.mkv");
+    QVERIFY(write_test_file(other, 100000, 3));
+    {
+        FileHashCache first(journal);
+        FileHashCache second(journal);
+        QVERIFY(first.Lookup(filename, hash));
+        QVERIFY(second.Lookup(filename, hash));
+        QCOMPARE(second.Hash(other), ReadFileHash(other));
+        QVERIFY(!first.Lookup(other, hash));
+    }
+    {
+        FileHashCache cache(journal);
+        QVERIFY(cache.Lookup(filename, hash));
+        QVERIFY(cache.Lookup(other, hash));
+    }
+
+    // Removed files are dropped when the journal is rewritten
+    QVERIFY(QFile::remove(other));
+    {
+        QFile file(journal);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Append));
+        QCOMPARE(file.write("x", 1), 1LL);
+    }
+    qint64 before = QFileInfo(journal).size();
+    {
+        FileHashCache cache(journal);
+        QVERIFY(cache.Lookup(filename, hash));
+    }
+    QVERIFY(QFileInfo(journal).size() < before - 1);
+    {
+        FileHashCache cache(journal);
+        QVERIFY(cache.Lookup(filename, hash));
+        QCOMPARE(hash, ReadFileHash(filename));
+    }
+
+    // Without a journal nothing is kept
+    {
+        FileHashCache cache;
+        QVERIFY(!cache.Lookup(filename, hash));
+        QCOMPARE(cache.Hash(filename), ReadFileHash(filename));
+        QVERIFY(cache.Lookup(filename, hash));
+    }
+    {
+        FileHashCache cache;
+        QVERIFY(!cache.Lookup(filename, hash));
+    }
+}
 
 QTEST_APPLESS_MAIN(TestMiscUtil)
@@ -30,4 +30,7 @@ class TestMiscUtil : public QObject
 private slots:
     static void test_parse_cmdline_data(void);
     static void test_parse_cmdline(void);
+    static void test_filehash_data(void);
+    static void test_filehash(void);
+    static void test_filehash_cache(void);
 };
@@ -0,0 +1,164 @@
+/*
+ *  Class TestMythSocket
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include "test_mythsocket.h"
+
+#include <cstdint>
+
+#include <QtEndian>
+
+#include "mythsocket.h"
+
+// Builds a binary frame around a payload, valid or not
+static QByteArray make_frame(const QByteArray &payload, char flags = 0,
+                             quint32 size = UINT32_MAX)
+{
+    QByteArray frame(8, '\0');
+    frame[0] = '\xff';
+    frame[1] = flags;
+    qToBigEndian<quint32>((size == UINT32_MAX) ? payload.size() : size,
+                          frame.data() + 4);
+    return frame + payload;
+}
+
+void TestMythSocket::binary_ints_data(void)
+{
+    QTest::addColumn<QString>("str");
+    QTest::addColumn<int>("payload_size");
+
+    // Integers QString::number() gives back unchanged are packed
+    QTest::newRow("zero")        << "0"                    << 1;
+    QTest::newRow("one")         << "1"                    << 1;
+    QTest::newRow("minus one")   << "-1"                   << 1;
+    QTest::newRow("18 digits")   << "123456789012345678"   << 9;
+    QTest::newRow("-18 digits")  << "-123456789012345678"  << 9;
+    QTest::newRow("max 18")      << "999999999999999999"   << 9;
+    QTest::newRow("min 18")      << "-999999999999999999"  << 9;
+
+    // Everything else is sent as a string
+    QTest::newRow("minus zero")  << "-0"                   << 3;
+    QTest::newRow("leading 0")   << "007"                  << 4;
+    QTest::newRow("-leading 0")  << "-007"                 << 5;
+    QTest::newRow("plus")        << "+5"                   << 3;
+    QTest::newRow("minus")       << "-"                    << 2;
+    QTest::newRow("space")       << " 1"                   << 3;
+    QTest::newRow("suffix")      << "12a"                  << 4;
+    QTest::newRow("empty")       << ""                     << 1;
+    QTest::newRow("19 digits")   << "1234567890123456789"  << 20;
+    QTest::newRow("-19 digits")  << "-1234567890123456789" << 21;
+    QTest::newRow("int64 max")   << "9223372036854775807"  << 20;
+    QTest::newRow("int64 min")   << "-9223372036854775808" << 21;
+}
+
+void TestMythSocket::binary_ints(void)
+{
+    QFETCH(QString, str);
+    QFETCH(int, payload_size);
+
+    QByteArray frame = MythSocket::ToBinaryFrame(QStringList(str));
+    QCOMPARE(frame.size(), 8 + payload_size);
+
+    QStringList list;
+    QVERIFY(MythSocket::FromBinaryFrame(frame, list));
+    QCOMPARE(list, QStringList(str));
+}
+
+void TestMythSocket::binary_utf8(void)
+{
+    QStringList sent {
+        "QUERY_RECORDING BASENAME",
+        QString::fromUtf8("Caf\xc3\xa9 \xe6\x97\xa5\xe6\x9c\xac \xf0\x9f\x93\xba"),
+        "",
+        "[]:[]",
+        "1007_20210421132603.ts",
+        "42",
+        "",
+    };
+
+    QByteArray frame = MythSocket::ToBinaryFrame(sent);
+    QCOMPARE(frame.at(1) & 1, 0);
+
+    QStringList received;
+    QVERIFY(MythSocket::FromBinaryFrame(frame, received));
+    QCOMPARE(received, sent);
+}
+
+void TestMythSocket::binary_compressed(void)
+{
+    QStringList sent;
+    for (int i = 0; i < 2000; ++i)
+        sent << "Some Recording Title" << QString::number(i * 1000003LL) << "";
+
+    QByteArray frame = MythSocket::ToBinaryFrame(sent);
+    QCOMPARE(frame.at(1) & 1, 1);
+    QVERIFY(frame.size() < sent.join("[]:[]").size() / 2);
+
+    QStringList received;
+    QVERIFY(MythSocket::FromBinaryFrame(frame, received));
+    QCOMPARE(received, sent);
+}
+
+void TestMythSocket::binary_truncated_data(void)
+{
+    QTest::addColumn<QByteArray>("frame");
+
+    QByteArray frame = MythSocket::ToBinaryFrame({ "hello", "42" });
+    QTest::newRow("nothing")       << QByteArray();
+    QTest::newRow("magic only")    << frame.left(1);
+    QTest::newRow("short header")  << frame.left(7);
+    QTest::newRow("header only")   << frame.left(8);
+    QTest::newRow("short payload") << frame.left(frame.size() - 1);
+    QTest::newRow("trailing byte") << frame + 'x';
+    QTest::newRow("empty payload") << make_frame(QByteArray());
+
+    // Frames whose size is right, but whose payload is cut short
+    QTest::newRow("cut string")    << make_frame("\x0ahell");
+    QTest::newRow("cut varint")    << make_frame("\x0ahello\x80");
+    QTest::newRow("cut compressed")
+        << make_frame(qCompress(QByteArray(8192, '\x00')).left(20), 1);
+}
+
+void TestMythSocket::binary_truncated(void)
+{
+    QFETCH(QByteArray, frame);
+
+    QStringList list { "stale" };
+    QVERIFY(!MythSocket::FromBinaryFrame(frame, list));
+    QVERIFY(list.isEmpty());
+}
+
+void TestMythSocket::binary_oversized(void)
+{
+    QStringList list;
+
+    // A size that the 8 digit text size prefix couldn't hold either
+    QByteArray huge = make_frame(QByteArray(1, '\x00'), 0, 100000000);
+    QVERIFY(!MythSocket::FromBinaryFrame(huge, list));
+
+    // A string longer than the rest of the payload
+    QVERIFY(!MythSocket::FromBinaryFrame(make_frame("\x80\x80\x80\x80\x10xx"), list));
+
+    // A varint longer than 64 bits
+    QVERIFY(!MythSocket::FromBinaryFrame(make_frame(QByteArray(11, '\x80')), list));
+
+    // Compressed data claiming to expand to more than a frame can hold
+    QByteArray bomb = qCompress(QByteArray(8192, '\x00'));
+    qToBigEndian<quint32>(0xffffffff, bomb.data());
+    QVERIFY(!MythSocket::FromBinaryFrame(make_frame(bomb, 1), list));
+}
+
+QTEST_APPLESS_MAIN(TestMythSocket)
@@ -1,4 +1,5 @@
 // C++ headers
+#include <algorithm>
 #include <cerrno>
 #include <csignal>
 #include <cstdio>
@@ -13,6 +14,7 @@
 #include <QString>
 
 // MythTV headers
+#include "mythconfig.h"
 #include "threadedfilewriter.h"
 #include "mythlogging.h"
 #include "mythcorecontext.h"
@@ -42,6 +44,7 @@ void TFWSyncThread::run(void)
 const uint ThreadedFileWriter::kMaxBufferSize   = 8 * 1024 * 1024;
 const uint ThreadedFileWriter::kMinWriteSize    = 64 * 1024;
 const uint ThreadedFileWriter::kMaxBlockSize    = 1 * 1024 * 1024;
+const uint ThreadedFileWriter::kPreallocSize    = 64 * 1024 * 1024;
 
 /** \class ThreadedFileWriter
  *  \brief This class supports the writing of recordings to disk.
@@ -52,6 +55,11 @@ const uint ThreadedFileWriter::kMaxBlockSize    = 1 * 1024 * 1024;
  *   using another thread. The goal here so to block as little as
  *   possible when the classes using this class want to add data
  *   to the stream.
+ *
+ *   "TFWPreallocate" reserves disk space ahead of the write position to reduce fragmentation when
+ *   several recordings are written to the same disk, the reservation
+ *   past the end of the file is released when it is closed.
+ *   "TFWDropCache" drops the synced pages from the page cache.
  */
 
 /** \fn ThreadedFileWriter::ReOpen(QString)
@@ -68,6 +76,7 @@ bool ThreadedFileWriter::ReOpen(const QString& newFilename)
 
     if (m_fd >= 0)
     {
+        TrimPreallocation();
         close(m_fd);
         m_fd = -1;
     }
@@ -92,6 +101,10 @@ bool ThreadedFileWriter::ReOpen(const QString& newFilename)
 bool ThreadedFileWriter::Open(void)
 {
     m_ignoreWrites = false;
+    m_preallocEnd = 0;
+
+    m_preallocate = gCoreContext->GetBoolSetting("TFWPreallocate", false);
+    m_dropCache = gCoreContext->GetBoolSetting("TFWDropCache", false);
 
     if (m_filename == "-")
         m_fd = fileno(stdout);
@@ -171,8 +184,11 @@ ThreadedFileWriter::~ThreadedFileWriter()
         m_syncThread = nullptr;
     }
 
+    LogStats();
+
     if (m_fd >= 0)
     {
+        TrimPreallocation();
         close(m_fd);
         m_fd = -1;
     }
@@ -364,7 +380,102 @@ void ThreadedFileWriter::Sync(void) const
 #else
         fsync(m_fd);
 #endif
+#if HAVE_POSIX_FADVISE
+        // The data is on disk now, so there is no need to keep it in
+        // the page cache where it would push out data other recordings
+        // and playback actually need.
+        if (m_dropCache)
+            posix_fadvise(m_fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    }
+}
+
+/** \fn ThreadedFileWriter::LogStats(void) const
+ *  \brief Logs throughput and latency of the writes to this file.
+ */
+void ThreadedFileWriter::LogStats(void) const
+{
+    Stats stats;
+    {
+        QMutexLocker locker(&m_bufLock);
+        stats = m_stats;
+    }
+    if (!stats.m_writes)
+        return;
+
+    LOG(VB_FILE, LOG_INFO, LOC +
+        QString("%1 MB in %2 writes, avg %3 ms max %4 ms, "
+                "%5 syncs avg %6 ms max %7 ms, %8 MB/s while writing")
+        .arg(stats.m_bytesWritten / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(stats.m_writes)
+        .arg(stats.m_writeNsecs / (stats.m_writes * 1e6), 0, 'f', 2)
+        .arg(stats.m_maxWriteNsecs / 1e6, 0, 'f', 2)
+        .arg(stats.m_syncs)
+        .arg(stats.m_syncs ? stats.m_syncNsecs / (stats.m_syncs * 1e6) : 0.0,
+             0, 'f', 2)
+        .arg(stats.m_maxSyncNsecs / 1e6, 0, 'f', 2)
+        .arg(stats.m_writeNsecs ?
+             (stats.m_bytesWritten * 1e3) / (1024.0 * 1024.0) /
+             (stats.m_writeNsecs / 1e6) : 0.0, 0, 'f', 1));
+}
+
+/** \fn ThreadedFileWriter::Preallocate(uint)
+ *  \brief Reserves disk space ahead of the current write position.
+ *
+ *  The space is allocated with FALLOC_FL_KEEP_SIZE so the file size
+ *  seen by readers does not change. This is a no-op on systems and
+ *  filesystems without fallocate() support.
+ */
+void ThreadedFileWriter::Preallocate(uint count)
+{
+#ifdef __linux__
+    off_t pos = lseek(m_fd, 0, SEEK_CUR);
+    if (pos < 0 || pos + count <= m_preallocEnd)
+        return;
+
+    if (fallocate(m_fd, FALLOC_FL_KEEP_SIZE, pos, kPreallocSize) < 0)
+    {
+        LOG(VB_FILE, LOG_INFO, LOC + "Preallocation not supported" + ENO);
+        m_preallocate = false;
+        return;
+    }
+    m_preallocEnd = pos + kPreallocSize;
+#else
+    (void) count;
+    m_preallocate = false;
+#endif
+}
+
+/** \fn ThreadedFileWriter::TrimPreallocation(void)
+ *  \brief Releases the space Preallocate() reserved past the end of the
+ *         file, before the file is closed.
+ *
+ *  FALLOC_FL_KEEP_SIZE blocks past the end of the file are otherwise kept
+ *  allocated until the file is deleted.
+ */
+void ThreadedFileWriter::TrimPreallocation(void)
+{
+#ifdef __linux__
+    if (m_preallocEnd <= 0)
+        return;
+
+    struct stat st {};
+    if ((fstat(m_fd, &st) == 0) && (st.st_size < m_preallocEnd))
+    {
+        if (fallocate(m_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                      st.st_size, m_preallocEnd - st.st_size) < 0)
+        {
+            // Truncating releases blocks past the end on filesystems
+            // that can't punch holes
+            if (ftruncate(m_fd, st.st_size) < 0)
+            {
+                LOG(VB_FILE, LOG_WARNING, LOC +
+                    "Unable to release preallocated space" + ENO);
+            }
+        }
     }
+#endif
+    m_preallocEnd = 0;
 }
 
 /** \fn ThreadedFileWriter::SetWriteBufferMinWriteSize(uint)
@@ -389,10 +500,19 @@ void ThreadedFileWriter::SyncLoop(void)
     {
         locker.unlock();
 
+        MythTimer syncTimer;
+        syncTimer.start();
+
         Sync();
 
+        auto nsecs = static_cast<uint64_t>(syncTimer.nsecsElapsed().count());
+
         locker.relock();
 
+        m_stats.m_syncs++;
+        m_stats.m_syncNsecs += nsecs;
+        m_stats.m_maxSyncNsecs = std::max(m_stats.m_maxSyncNsecs, nsecs);
+
         if (m_ignoreWrites && m_registered)
         {
             // we aren't going to write to the disk anymore, so can de-register
@@ -420,8 +540,10 @@ void ThreadedFileWriter::DiskLoop(void)
     // This timer makes sure we do.
     MythTimer minWriteTimer;
     MythTimer lastRegisterTimer;
+    MythTimer lastStatsTimer;
     minWriteTimer.start();
     lastRegisterTimer.start();
+    lastStatsTimer.start();
 
     uint64_t total_written = 0LL;
 
@@ -493,7 +615,15 @@ void ThreadedFileWriter::DiskLoop(void)
         {
             locker.unlock();
 
-            int ret = write(m_fd, (char *)data + tot, sz - tot);
+            if (m_preallocate)
+                Preallocate(sz - tot);
+
+            MythTimer callTimer;
+            callTimer.start();
+
+            ssize_t ret = write(m_fd, (char *)data + tot, sz - tot);
+
+            auto nsecs = static_cast<uint64_t>(callTimer.nsecsElapsed().count());
 
             if (ret < 0)
             {
@@ -526,6 +656,12 @@ void ThreadedFileWriter::DiskLoop(void)
 
             locker.relock();
 
+            m_stats.m_writes++;
+            m_stats.m_writeNsecs += nsecs;
+            m_stats.m_maxWriteNsecs = std::max(m_stats.m_maxWriteNsecs, nsecs);
+            if (ret > 0)
+                m_stats.m_bytesWritten += ret;
+
             if ((tot < sz) && !m_inDtor)
                 m_bufferHasData.wait(locker.mutex(), 50);
         }
@@ -539,6 +675,14 @@ void ThreadedFileWriter::DiskLoop(void)
             lastRegisterTimer.restart();
         }
 
+        if (lastStatsTimer.elapsed() >= 60s && VERBOSE_LEVEL_CHECK(VB_FILE, LOG_INFO))
+        {
+            locker.unlock();
+            LogStats();
+            locker.relock();
+            lastStatsTimer.restart();
+        }
+
         buf->lastUsed = MythDate::current();
         m_emptyBuffers.push_back(buf);
 
@@ -68,13 +68,31 @@ class MBASE_PUBLIC ThreadedFileWriter
     void DiskLoop(void);
     void SyncLoop(void);
     void TrimEmptyBuffers(void);
+    void Preallocate(uint count);
+    void TrimPreallocation(void);
+    void LogStats(void) const;
 
   private:
+    /// Throughput and latency counters, logged by LogStats()
+    struct Stats
+    {
+        uint64_t m_bytesWritten   {0};
+        uint64_t m_writes         {0};
+        uint64_t m_writeNsecs     {0};
+        uint64_t m_maxWriteNsecs  {0};
+        uint64_t m_syncs          {0};
+        uint64_t m_syncNsecs      {0};
+        uint64_t m_maxSyncNsecs   {0};
+    };
+
     // file info
     QString         m_filename;
     int             m_flags;
     mode_t          m_mode;
     int             m_fd                 {-1};
+    bool            m_preallocate        {false};
+    bool            m_dropCache          {false};
+    long long       m_preallocEnd        {0};     // used by DiskLoop while open
 
     // state
     bool            m_flush              {false};         // protected by buflock
@@ -82,6 +100,7 @@ class MBASE_PUBLIC ThreadedFileWriter
     bool            m_ignoreWrites       {false};         // protected by buflock
     uint            m_tfwMinWriteSize    {kMinWriteSize}; // protected by buflock
     uint            m_totalBufferUse     {0};             // protected by buflock
+    Stats           m_stats;                              // protected by buflock
 
     // buffers
     class TFWBuffer
@@ -110,6 +129,8 @@ class MBASE_PUBLIC ThreadedFileWriter
     static const uint kMinWriteSize;
     /// Maximum block size to write at a time
     static const uint kMaxBlockSize;
+    /// Amount of disk space to reserve ahead of the write position
+    static const uint kPreallocSize;
 
     bool m_warned                        {false};
     bool m_blocking                      {false};
@@ -1,7 +1,26 @@
+// C++ headers
+#include <algorithm>
+#include <deque>
 #include <map>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+// POSIX headers
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
+// Qt headers
 #include <QDir>
+#include <QMutex>
+#include <QRunnable>
 #include <QUrl>
+#include <QWaitCondition>
 
 #include "mythcorecontext.h"
 #include "dbaccess.h"
@@ -11,6 +30,7 @@
 #include "mythlogging.h"
 #include "videoutils.h"
 #include "storagegroup.h"
+#include "mthreadpool.h"
 
 namespace
 {
@@ -42,73 +62,315 @@ namespace
         }
     };
 
-    bool scan_dir(const QString &start_path, DirectoryHandler *handler,
-                  const ext_lookup &ext_settings)
+    struct dir_entry
+    {
+        QString name;
+        bool    is_dir {false};
+    };
+
+    struct dir_listing
+    {
+        bool ok {false};
+        bool is_disc {false}; // has a VIDEO_TS or BDMV directory
+        std::vector<dir_entry> entries;
+    };
+
+    void add_entry(dir_listing &listing, const QString &name, bool is_dir)
+    {
+        // Compared like QDir::exists() does on case insensitive mounts
+        if (is_dir &&
+            ((name.compare("VIDEO_TS", Qt::CaseInsensitive) == 0) ||
+             (name.compare("BDMV", Qt::CaseInsensitive) == 0)))
+            listing.is_disc = true;
+        listing.entries.push_back({name, is_dir});
+    }
+
+#ifdef __linux__
+    // Resolves entries whose type getdents didn't give, and symbolic links
+    unsigned char entry_type(int dir_fd, const char *name)
+    {
+#ifdef STATX_TYPE
+        struct statx stx {};
+        if (statx(dir_fd, name, AT_STATX_DONT_SYNC, STATX_TYPE, &stx) != 0)
+            return DT_UNKNOWN;
+        mode_t mode = stx.stx_mode;
+#else
+        struct stat st {};
+        if (fstatat(dir_fd, name, &st, 0) != 0)
+            return DT_UNKNOWN;
+        mode_t mode = st.st_mode;
+#endif
+        if (S_ISDIR(mode))
+            return DT_DIR;
+        if (S_ISREG(mode))
+            return DT_REG;
+        return DT_UNKNOWN;
+    }
+
+    // Lists a directory with getdents64, which gives the type of most
+    // entries without them having to be stat'ed one by one
+    bool list_dir(const QString &path, dir_listing &listing)
     {
-        QDir d(start_path);
+        static constexpr size_t kDentsBufferSize { 256 * 1024 };
+
+        int fd = open(QFile::encodeName(path).constData(),
+                      O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            // Like QDir, a directory that can't be read counts as empty
+            return (errno != ENOENT) && (errno != ENOTDIR);
+        }
+
+        std::vector<char> buffer(kDentsBufferSize);
+
+        while (true)
+        {
+            long nread = syscall(SYS_getdents64, fd, buffer.data(),
+                                 buffer.size());
+            if (nread <= 0)
+                break;
+
+            for (long pos = 0; pos < nread; )
+            {
+                auto *dent = reinterpret_cast<struct dirent64 *>(
+                    buffer.data() + pos);
+                pos += dent->d_reclen;
+
+                // Skips "." and "..", and hidden entries like QDir does
+                if (dent->d_name[0] == '.')
+                    continue;
+
+                unsigned char type = dent->d_type;
+                if (type == DT_UNKNOWN || type == DT_LNK)
+                    type = entry_type(fd, dent->d_name);
+
+                // Other types, and dangling links, are skipped by QDir too
+                if (type == DT_DIR || type == DT_REG)
+                    add_entry(listing, QFile::decodeName(dent->d_name),
+                              type == DT_DIR);
+            }
+        }
+
+        close(fd);
+
+        std::sort(listing.entries.begin(), listing.entries.end(),
+                  [](const dir_entry &a, const dir_entry &b)
+                  { return a.name.compare(b.name, Qt::CaseInsensitive) < 0; });
+
+        return true;
+    }
+#else
+    bool list_dir(const QString &path, dir_listing &listing)
+    {
+        QDir d(path);
 
         // Return a fail if directory doesn't exist.
         if (!d.exists())
             return false;
-        
+
         d.setFilter(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
         QFileInfoList list = d.entryInfoList();
-        // An empty directory is fine
-        if (list.isEmpty())
+
+        for (const auto& entry : qAsConst(list))
+            add_entry(listing, entry.fileName(), entry.isDir());
+
+        return true;
+    }
+#endif
+
+    QString suffix_of(const QString &file_name)
+    {
+        int dot = file_name.lastIndexOf('.');
+        return (dot < 0) ? QString() : file_name.mid(dot + 1);
+    }
+
+    /**
+     * Walks a directory tree, listing its directories in parallel.
+     *
+     * The subdirectories of each directory that is walked are queued to
+     * be listed by the threads of a pool, in the order they will be
+     * walked in, and at most kReadAhead listings are made ahead of the
+     * walk.  The handler is only called from the walking thread, in the
+     * same order as a plain recursive walk would.
+     */
+    class dir_walker
+    {
+      public:
+        explicit dir_walker(const ext_lookup &ext_settings) :
+            m_extSettings(ext_settings)
+        {
+            m_pool.setMaxThreadCount(kScanThreads);
+        }
+
+        ~dir_walker()
+        {
+            m_pool.waitForDone();
+        }
+
+        bool walk(const QString &start_path, DirectoryHandler *handler)
+        {
+            QString path = QFileInfo(start_path).absoluteFilePath();
+
+            // The start directory is walked even if it is a disc itself
+            start(path);
+            dir_listing listing = take(path);
+
+            if (!listing.ok)
+                return false;
+
+            walk_dir(path, listing, handler);
             return true;
+        }
 
-        QDir dir_tester;
+      private:
+        static constexpr int kScanThreads { 4 };
+        /// Directories listed ahead of the walk, at most
+        static constexpr int kReadAhead   { 64 };
 
-        for (const auto& entry : qAsConst(list))
+        class list_task : public QRunnable
         {
-            if (entry.fileName() == "Thumbs.db")
-                continue;
+          public:
+            list_task(dir_walker &walker, QString path) :
+                m_walker(walker), m_path(std::move(path)) {}
+
+            void run(void) override // QRunnable
+            {
+                m_walker.list(m_path);
+            }
+
+          private:
+            dir_walker &m_walker;
+            QString     m_path;
+        };
+
+        static QString join(const QString &dir, const QString &name)
+        {
+            return dir.endsWith('/') ? dir + name : dir + '/' + name;
+        }
 
-            if (!entry.isDir() &&
-                ext_settings.extension_ignored(entry.suffix())) continue;
+        void start(const QString &path)
+        {
+            m_ahead++;
+            m_pool.start(new list_task(*this, path), "DirScan");
+        }
 
-            bool add_as_file = true;
+        // Starts listing the queued directories, up to the read ahead limit
+        void dispatch(void)
+        {
+            while (!m_pending.empty() && (m_ahead < kReadAhead))
+            {
+                start(m_pending.front());
+                m_pending.pop_front();
+            }
+        }
 
-            if (entry.isDir())
+        // Runs on the pool
+        void list(const QString &path)
+        {
+            dir_listing listing;
+            listing.ok = list_dir(path, listing);
+
+            QMutexLocker locker(&m_lock);
+            m_listings[path] = std::move(listing);
+            m_ready.wakeAll();
+        }
+
+        // Waits for the listing of a directory, listing it right away
+        // if it hasn't been started yet
+        dir_listing take(const QString &path)
+        {
+            auto pending = std::find(m_pending.begin(), m_pending.end(), path);
+            if (pending != m_pending.end())
             {
-                add_as_file = false;
+                m_pending.erase(pending);
+                start(path);
+            }
 
-                dir_tester.setPath(entry.absoluteFilePath() + "/VIDEO_TS");
-                QDir bd_dir_tester;
-                bd_dir_tester.setPath(entry.absoluteFilePath() + "/BDMV");
-                if (dir_tester.exists() || bd_dir_tester.exists())
+            dir_listing listing;
+            {
+                QMutexLocker locker(&m_lock);
+
+                auto it = m_listings.find(path);
+                while (it == m_listings.end())
                 {
-                    add_as_file = true;
+                    m_ready.wait(&m_lock);
+                    it = m_listings.find(path);
                 }
-                else
+
+                listing = std::move(it->second);
+                m_listings.erase(it);
+            }
+
+            m_ahead--;
+            dispatch();
+            return listing;
+        }
+
+        void walk_dir(const QString &path, const dir_listing &listing,
+                      DirectoryHandler *handler)
+        {
+            // Queued ahead of the subdirectories of the parent directories,
+            // which are walked after these
+            std::vector<QString> subdirs;
+            for (const auto & entry : listing.entries)
+            {
+                if (entry.is_dir && entry.name != "Thumbs.db")
+                    subdirs.push_back(join(path, entry.name));
+            }
+            m_pending.insert(m_pending.begin(), subdirs.begin(), subdirs.end());
+            dispatch();
+
+            for (const auto & entry : listing.entries)
+            {
+                if (entry.name == "Thumbs.db")
+                    continue;
+
+                QString fq_name = join(path, entry.name);
+                QString suffix = suffix_of(entry.name);
+
+                if (entry.is_dir)
                 {
+                    dir_listing sub = take(fq_name);
+
+                    if (!sub.is_disc)
+                    {
 #if 0
-                    LOG(VB_GENERAL, LOG_DEBUG, 
-                        QString(" -- Dir : %1").arg(entry.!absoluteFilePath()));
+                        LOG(VB_GENERAL, LOG_DEBUG,
+                            QString(" -- Dir : %1").arg(fq_name));
 #endif
-                    DirectoryHandler *dh =
-                            handler->newDir(entry.fileName(),
-                                            entry.absoluteFilePath());
-
-                    // Since we are dealing with a subdirectory failure is fine,
-                    // so we'll just ignore the failue and continue
-                    (void) scan_dir(entry.absoluteFilePath(), dh, ext_settings);
+                        DirectoryHandler *dh =
+                                handler->newDir(entry.name, fq_name);
+
+                        // Since we are dealing with a subdirectory failure
+                        // is fine, so we'll just ignore it and continue
+                        walk_dir(fq_name, sub, dh);
+                        continue;
+                    }
+                }
+                else if (m_extSettings.extension_ignored(suffix))
+                {
+                    continue;
                 }
-            }
 
-            if (add_as_file)
-            {
 #if 0
                 LOG(VB_GENERAL, LOG_DEBUG,
-                    QString(" -- File : %1").arg(entry.fileName()));
+                    QString(" -- File : %1").arg(entry.name));
 #endif
-                handler->handleFile(entry.fileName(), entry.absoluteFilePath(),
-                                    entry.suffix(), "");
+                handler->handleFile(entry.name, fq_name, suffix, "");
             }
         }
 
-        return true;
-    }
+        const ext_lookup   &m_extSettings;
+        MThreadPool         m_pool {"DirScan"};
+
+        // Only used by the walking thread
+        std::deque<QString> m_pending;    // to be listed, in walk order
+        int                 m_ahead {0};  // started and not taken yet
+
+        QMutex              m_lock;
+        QWaitCondition      m_ready;
+        std::map<QString, dir_listing> m_listings; // listed, not taken yet
+    };
 
     bool scan_sg_dir(const QString &start_path, const QString &host,
                      const QString &base_path, DirectoryHandler *handler,
@@ -237,7 +499,8 @@ bool ScanVideoDirectory(const QString &start_path, DirectoryHandler *handler,
             QString("MythVideo::ScanVideoDirectory Scanning (%1)")
                 .arg(start_path));
 
-        if (!scan_dir(start_path, handler, extlookup))
+        dir_walker walker(extlookup);
+        if (!walker.walk(start_path, handler))
         {
             LOG(VB_GENERAL, LOG_ERR,
                 QString("MythVideo::ScanVideoDirectory failed to scan %1")
@@ -0,0 +1,202 @@
+/*
+ *  Class TestDirScan
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include "test_dirscan.h"
+
+#include "dbaccess.h"
+#include "dirscan.h"
+
+namespace
+{
+    // Records the calls ScanVideoDirectory() makes
+    class recorder : public DirectoryHandler
+    {
+      public:
+        DirectoryHandler *newDir(const QString &dir_name,
+                                 const QString &fq_dir_name) override // DirectoryHandler
+        {
+            m_calls << QString("dir %1 %2").arg(dir_name, fq_dir_name);
+            return this;
+        }
+
+        void handleFile(const QString &file_name,
+                        const QString &fq_file_name,
+                        const QString &extension,
+                        const QString &host) override // DirectoryHandler
+        {
+            m_calls << QString("file %1 %2 %3 %4")
+                .arg(file_name, fq_file_name, extension, host);
+        }
+
+        QStringList m_calls;
+    };
+
+    // The recursion ScanVideoDirectory() used to do with QDir
+    bool old_scan_dir(const QString &start_path, DirectoryHandler *handler)
+    {
+        QDir d(start_path);
+
+        if (!d.exists())
+            return false;
+
+        d.setFilter(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+        QFileInfoList list = d.entryInfoList();
+
+        QDir dir_tester;
+
+        for (const auto& entry : qAsConst(list))
+        {
+            if (entry.fileName() == "Thumbs.db")
+                continue;
+
+            if (!entry.isDir() && (entry.suffix() == "txt"))
+                continue;
+
+            bool add_as_file = true;
+
+            if (entry.isDir())
+            {
+                add_as_file = false;
+
+                dir_tester.setPath(entry.absoluteFilePath() + "/VIDEO_TS");
+                QDir bd_dir_tester;
+                bd_dir_tester.setPath(entry.absoluteFilePath() + "/BDMV");
+                if (dir_tester.exists() || bd_dir_tester.exists())
+                {
+                    add_as_file = true;
+                }
+                else
+                {
+                    DirectoryHandler *dh =
+                            handler->newDir(entry.fileName(),
+                                            entry.absoluteFilePath());
+                    (void) old_scan_dir(entry.absoluteFilePath(), dh);
+                }
+            }
+
+            if (add_as_file)
+            {
+                handler->handleFile(entry.fileName(), entry.absoluteFilePath(),
+                                    entry.suffix(), "");
+            }
+        }
+
+        return true;
+    }
+
+    QStringList scan(const QString &path, bool *ok = nullptr)
+    {
+        FileAssociations::ext_ignore_list ext_list;
+        ext_list.emplace_back("txt", true);
+        ext_list.emplace_back("mkv", false);
+
+        recorder rec;
+        bool scanned = ScanVideoDirectory(path, &rec, ext_list, true);
+        if (ok)
+            *ok = scanned;
+        return rec.m_calls;
+    }
+
+    QStringList old_scan(const QString &path)
+    {
+        recorder rec;
+        (void) old_scan_dir(path, &rec);
+        return rec.m_calls;
+    }
+
+    bool make_file(const QString &path)
+    {
+        QFileInfo info(path);
+        QFile file(path);
+        return QDir().mkpath(info.absolutePath()) &&
+               file.open(QIODevice::WriteOnly) &&
+               (file.write("x") == 1);
+    }
+}
+
+void TestDirScan::initTestCase(void)
+{
+    QVERIFY(m_dir.isValid());
+
+    const QStringList files {
+        "tree/b.mkv",
+        "tree/A.avi",
+        "tree/c.txt",
+        "tree/noextension",
+        "tree/.hidden.mkv",
+        "tree/Thumbs.db",
+        "tree/.hiddendir/z.mkv",
+        "tree/Movies/x.mkv",
+        "tree/Movies/Sub/y.mkv",
+        "tree/Movies/Sub/Deeper/w.mkv",
+        "tree/Empty/.keep",
+        "tree/Disc/VIDEO_TS/VTS_01_1.VOB",
+        "tree/BluRay/BDMV/index.bdmv",
+        "tree/zeta/Alpha/v.mkv",
+        "tree/zeta/beta/u.mkv",
+        "lower/Disc/video_ts/VTS_01_1.VOB",
+    };
+
+    for (const auto & file : files)
+        QVERIFY(make_file(m_dir.filePath(file)));
+}
+
+void TestDirScan::test_tree(void)
+{
+    QString path = m_dir.filePath("tree");
+    QStringList calls = scan(path);
+
+    QCOMPARE(calls, old_scan(path));
+
+    // Spot checks, in case both get it wrong the same way
+    QVERIFY(calls.contains(QString("file Disc %1/Disc  ").arg(path)));
+    QVERIFY(calls.contains(QString("file BluRay %1/BluRay  ").arg(path)));
+    QVERIFY(calls.filter("hidden").isEmpty());
+    QVERIFY(calls.filter("Thumbs.db").isEmpty());
+    QVERIFY(calls.filter("c.txt").isEmpty());
+    QVERIFY(calls.filter("VTS_01_1").isEmpty());
+}
+
+void TestDirScan::test_disc_root(void)
+{
+    // A disc directory that is scanned itself is walked into
+    QString path = m_dir.filePath("tree/Disc");
+    QStringList calls = scan(path);
+
+    QCOMPARE(calls, old_scan(path));
+    QVERIFY(calls.contains(QString("dir VIDEO_TS %1/VIDEO_TS").arg(path)));
+}
+
+void TestDirScan::test_lowercase_disc(void)
+{
+    // As QDir::exists() finds them on case insensitive mounts
+    QString path = m_dir.filePath("lower");
+    QStringList calls = scan(path);
+
+    QCOMPARE(calls, QStringList(QString("file Disc %1/Disc  ").arg(path)));
+}
+
+void TestDirScan::test_missing(void)
+{
+    bool ok = true;
+    QStringList calls = scan(m_dir.filePath("missing"), &ok);
+
+    QVERIFY(!ok);
+    QVERIFY(calls.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestDirScan)
@@ -375,9 +375,15 @@ void MythSocketManager::HandleVersion(MythSocket *socket,
         return;
     }
 
+    // Extra tokens are optional capabilities, the reply lists those we
+    // accept. The reply itself is still sent with the text framing.
+    bool binary = slist.mid(3).contains(MythSocket::kBinaryFramingCapability);
     LOG(VB_SOCKET, LOG_DEBUG, LOC + "Client validated");
     retlist << "ACCEPT" << MYTH_PROTO_VERSION;
+    if (binary)
+        retlist << MythSocket::kBinaryFramingCapability;
     socket->WriteStringList(retlist);
+    socket->SetBinaryFraming(binary);
     socket->m_isValidated = true;
 }
 
@@ -0,0 +1,160 @@
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QBuffer>
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+#include <QTextCodec>
+#endif
+#include "mythversion.h"
+#include "mythdate.h"
+#include "test_serializers.h"
+#include "datacontracts/programAndChannel.h"
+#include "datacontracts/programList.h"
+#include "datacontracts/recording.h"
+#include "serializers/jsonSerializer.h"
+#include "serializers/bufferedJsonSerializer.h"
+
+static constexpr int kProgramCount { 5000 };
+
+template <typename T>
+static QByteArray serialize(const QObject *pObject)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    T serializer(&buffer, "GetRecordedList");
+    serializer.Serialize(pObject, "ProgramList");
+    return buffer.data();
+}
+
+void TestSerializers::initTestCase(void)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+    // JSONSerializer writes in the locale's encoding, which is UTF-8 on
+    // any real backend but not necessarily where the tests run.
+    QTextCodec::setCodecForLocale(QTextCodec::codecForName("UTF-8"));
+#endif
+
+    // About the size of a large Dvr/GetRecordedList response
+    QDateTime start = MythDate::fromString("2021-01-01T20:00:00Z");
+
+    m_programs = new DTC::ProgramList();
+    for (int i = 0; i < kProgramCount; ++i)
+    {
+        DTC::Program *pProgram = m_programs->AddNewProgram();
+        pProgram->setStartTime  (start.addSecs(i * 1800));
+        pProgram->setEndTime    (start.addSecs((i + 1) * 1800));
+        pProgram->setTitle      (QString("Big Buck Bunny %1").arg(i % 50));
+        pProgram->setSubTitle   (QString("Episode \"%1\"").arg(i));
+        pProgram->setDescription("Follow a day of the life of Big Buck Bunny "
+                                 "when he meets three bullying rodents: "
+                                 "Frank, Rinky, and Gamera.\n"
+                                 "Überraschung / ça va?");
+        pProgram->setCategory   ("movie");
+        pProgram->setInetref    ("10378");
+        pProgram->setSeason     (i / 20);
+        pProgram->setEpisode    (i % 20);
+        pProgram->setStars      (0.75);
+        pProgram->setFileSize   (1234567890LL + i);
+        pProgram->setFileName   (QString("1119_%1.ts").arg(i));
+
+        DTC::ChannelInfo *pChannel = pProgram->Channel();
+        pChannel->setChanId      (1000 + (i % 30));
+        pChannel->setChanNum     (QString::number(i % 30));
+        pChannel->setCallSign    ("WEATH");
+        pChannel->setChannelName ("The Weather Channel");
+
+        DTC::RecordingInfo *pRecording = pProgram->Recording();
+        pRecording->setRecordedId(i + 1);
+        pRecording->setStatus    (RecStatus::Recorded);
+        pRecording->setStartTs   (start.addSecs(i * 1800));
+        pRecording->setEndTs     (start.addSecs((i + 1) * 1800));
+        pRecording->setRecGroup  ("Default");
+    }
+
+    m_programs->setStartIndex    ( 0 );
+    m_programs->setCount         ( kProgramCount );
+    m_programs->setTotalAvailable( kProgramCount );
+    m_programs->setAsOf          ( start );
+    m_programs->setVersion       ( MYTH_BINARY_VERSION );
+    m_programs->setProtoVer      ( MYTH_PROTO_VERSION  );
+}
+
+void TestSerializers::cleanupTestCase(void)
+{
+    delete m_programs;
+}
+
+void TestSerializers::test_json_matches(void)
+{
+    QByteArray expected = serialize<JSONSerializer>(m_programs);
+    QByteArray actual   = serialize<BufferedJSONSerializer>(m_programs);
+
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(actual, expected);
+}
+
+void TestSerializers::test_json_escapes(void)
+{
+    auto *pChannel = new DTC::ChannelInfo();
+    pChannel->setChannelName(QString("\"a\\b/c\"\b\f\n\r\t") + QChar(0x01) +
+                             QChar(0x1F) + QString("é中"));
+
+    QByteArray expected = serialize<JSONSerializer>(pChannel);
+    QByteArray actual   = serialize<BufferedJSONSerializer>(pChannel);
+    QCOMPARE(actual, expected);
+
+    delete pChannel;
+}
+
+void TestSerializers::test_json_value(void)
+{
+    QVariantMap map { { "one", 1 }, { "two", "2/2" } };
+    QStringList list { "a", "b\"c" };
+
+    for (const QVariant &value : { QVariant(true), QVariant(-42),
+                                   QVariant(123456789012LL), QVariant(0.5),
+                                   QVariant("text\n"), QVariant(map),
+                                   QVariant(list) })
+    {
+        QBuffer expected;
+        expected.open(QIODevice::WriteOnly);
+        JSONSerializer(&expected, "Test").Serialize(value, "QValue");
+
+        QBuffer actual;
+        actual.open(QIODevice::WriteOnly);
+        BufferedJSONSerializer(&actual, "Test").Serialize(value, "QValue");
+
+        QCOMPARE(actual.data(), expected.data());
+    }
+}
+
+void TestSerializers::benchmark_json(void)
+{
+    QBENCHMARK
+    {
+        serialize<JSONSerializer>(m_programs);
+    }
+}
+
+void TestSerializers::benchmark_buffered_json(void)
+{
+    QBENCHMARK
+    {
+        serialize<BufferedJSONSerializer>(m_programs);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestSerializers)
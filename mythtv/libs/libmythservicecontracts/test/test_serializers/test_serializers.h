@@ -0,0 +1,41 @@
+/*
+ *  Class TestSerializers
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest>
+
+namespace DTC
+{
+class ProgramList;
+}
+
+class TestSerializers: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase(void);
+    void cleanupTestCase(void);
+    void test_json_matches(void);
+    static void test_json_escapes(void);
+    static void test_json_value(void);
+    void benchmark_json(void);
+    void benchmark_buffered_json(void);
+
+private:
+    DTC::ProgramList *m_programs {nullptr};
+};
@@ -1528,13 +1528,20 @@ void AvFormatDecoder::InitVideoCodec(AVStream *stream, AVCodecContext *enc,
             enc->skip_top    = (total_blocks + 3) / 4;
             enc->skip_bottom = (total_blocks + 3) / 4;
         }
-
-        if (FlagIsSet(kDecodeLowRes))
-            enc->lowres = 2; // 1 = 1/2 size, 2 = 1/4 size
     }
-    else if (codec1 && (AV_CODEC_ID_H264 == codec1->id) && FlagIsSet(kDecodeNoLoopFilter))
+
+    // Only some decoders (MPEG-1/2, MPEG-4 part 2, MJPEG...) can skip the
+    // work for the detail that lowres throws away. For the others, H.264
+    // and HEVC among them, the caller has to reduce the frames itself.
+    if (codec1 && FlagIsSet(kDecodeLowRes) && (codec1->max_lowres > 0))
+        enc->lowres = std::min(2, static_cast<int>(codec1->max_lowres)); // 1 = 1/2 size, 2 = 1/4 size
+
+    if (codec1 && ((AV_CODEC_ID_H264 == codec1->id) ||
+                   (AV_CODEC_ID_HEVC == codec1->id)) &&
+        FlagIsSet(kDecodeNoLoopFilter))
     {
         enc->flags &= ~AV_CODEC_FLAG_LOOP_FILTER;
+        enc->flags2 |= AV_CODEC_FLAG2_FAST;
         enc->skip_loop_filter = AVDISCARD_ALL;
     }
 
@@ -2431,8 +2438,12 @@ int AvFormatDecoder::ScanStreams(bool novideo)
                 m_useFrameTiming = true;
             }
 
-            if (FlagIsSet(kDecodeSingleThreaded))
+            // Lowres decoding has only ever been used single threaded
+            if (FlagIsSet(kDecodeSingleThreaded) ||
+                (FlagIsSet(kDecodeLowRes) && codec && (codec->max_lowres > 0)))
+            {
                 thread_count = 1;
+            }
 
             if (HAVE_THREADS)
             {
@@ -5,10 +5,16 @@
  * License: GPL v2
  */
 
+#include <algorithm>
+#include <climits>
+
 #include <QDateTime>
+#include <QSaveFile>
+#include <QDir>
 
 #include "eitcache.h"
 #include "mythcontext.h"
+#include "mythdirs.h"
 #include "mythdb.h"
 #include "mythlogging.h"
 #include "mythdate.h"
@@ -18,15 +24,57 @@
 // Highest version number. version is 5bits
 const uint EITCache::kVersionMax = 31;
 
+// Maximum number of rows written to the database per statement
+static constexpr size_t kBulkRows { 256 };
+
+// Seconds between writes of the snapshot
+static constexpr uint kSnapshotInterval { 10 * 60 };
+
+// Channel statistics are pruned from the database after a day, so older
+// snapshots of a channel can't be checked against it
+static constexpr uint kSnapshotMaxAge { 12 * 60 * 60 };
+
+static constexpr uint32_t kSnapshotMagic   { 0x4d455443 }; // "METC"
+static constexpr uint32_t kSnapshotVersion { 1 };
+
+/*
+ * The snapshot is written in host byte order: this header, then the
+ * channels sorted by chanid and last the entries of all channels sorted
+ * by key, each channel covering a contiguous range of them.
+ */
+struct SnapshotHeader
+{
+    uint32_t m_magic    {kSnapshotMagic};
+    uint32_t m_version  {kSnapshotVersion};
+    uint32_t m_channels {0};
+    uint32_t m_written  {0};
+    uint64_t m_entries  {0};
+};
+
+struct SnapshotChannel
+{
+    uint32_t m_chanid   {0};
+    uint32_t m_written  {0}; // when this backend last wrote the channel to the DB
+    uint64_t m_first    {0};
+    uint64_t m_count    {0};
+};
+
+static QString snapshot_path(void)
+{
+    return GetCacheDir() + "/eitcache.bin";
+}
+
 EITCache::EITCache()
 {
     // 24 hours ago
     m_lastPruneTime = MythDate::current().toUTC().toSecsSinceEpoch() - 86400;
+    m_lastSnapshotTime = MythDate::current().toSecsSinceEpoch();
 }
 
 EITCache::~EITCache()
 {
     WriteToDB();
+    WriteSnapshot();
 }
 
 void EITCache::ResetStatistics(void)
@@ -45,16 +93,42 @@ void EITCache::ResetStatistics(void)
 
 QString EITCache::GetStatistics(void) const
 {
-    QMutexLocker locker(&m_eventMapLock);
+    EITCacheStatistics s = GetCounters();
     return QString(
         "EITCache Access:%1 Hits:%2 "
         "Table:%3 Version:%4 Endtime:%5 New:%6 "
         "Pruned:%7 Pruned Hits:%8 Future:%9 Wrong Channel:%10 "
-        "Hit Ratio:%11")
-        .arg(m_accessCnt).arg(m_hitCnt)
-        .arg(m_tblChgCnt).arg(m_verChgCnt).arg(m_endChgCnt).arg(m_entryCnt)
-        .arg(m_pruneCnt).arg(m_prunedHitCnt).arg(m_futureHitCnt).arg(m_wrongChannelHitCnt)
-        .arg((m_hitCnt+m_prunedHitCnt+m_futureHitCnt+m_wrongChannelHitCnt)/(double)m_accessCnt);
+        "Hit Ratio:%11 Entries:%12")
+        .arg(s.m_access).arg(s.m_hit)
+        .arg(s.m_tableChange).arg(s.m_versionChange).arg(s.m_endtimeChange).arg(s.m_new)
+        .arg(s.m_pruned).arg(s.m_prunedHit).arg(s.m_futureHit).arg(s.m_wrongChannelHit)
+        .arg((s.m_hit+s.m_prunedHit+s.m_futureHit+s.m_wrongChannelHit)/(double)s.m_access)
+        .arg(s.m_entries);
+}
+
+EITCacheStatistics EITCache::GetCounters(void) const
+{
+    EITCacheStatistics stats;
+    stats.m_access          = m_accessCnt;
+    stats.m_hit             = m_hitCnt;
+    stats.m_tableChange     = m_tblChgCnt;
+    stats.m_versionChange   = m_verChgCnt;
+    stats.m_endtimeChange   = m_endChgCnt;
+    stats.m_new             = m_entryCnt;
+    stats.m_pruned          = m_pruneCnt;
+    stats.m_prunedHit       = m_prunedHitCnt;
+    stats.m_futureHit       = m_futureHitCnt;
+    stats.m_wrongChannelHit = m_wrongChannelHitCnt;
+
+    for (const auto &stripe : m_stripes)
+    {
+        QMutexLocker locker(&stripe.m_lock);
+        stats.m_channels += std::count(stripe.m_channels.cbegin(),
+                                       stripe.m_channels.cend(), true);
+        stats.m_entries  += stripe.m_used;
+        stats.m_memory   += stripe.m_table.capacity() * sizeof(Entry);
+    }
+    return stats;
 }
 
 /*
@@ -89,12 +163,85 @@ static inline bool modified(uint64_t sig)
     return (sig >> 63) != 0U;
 }
 
-static void replace_in_db(QStringList &value_clauses,
-                          uint chanid, uint eventid, uint64_t sig)
+static inline uint64_t construct_key(uint chanid, uint eventid)
+{
+    return ((uint64_t) chanid << 32) | eventid;
+}
+
+static inline uint extract_chanid(uint64_t key)
+{
+    return key >> 32;
+}
+
+static inline uint extract_eventid(uint64_t key)
+{
+    return key & 0xffffffff;
+}
+
+static inline size_t hash_key(uint64_t key)
+{
+    // Fibonacci hashing, folding the well mixed high bits into the low ones
+    key *= 0x9E3779B97F4A7C15ULL;
+    return key ^ (key >> 32);
+}
+
+/// Returns the smallest table size holding \p entries with a load factor
+/// of at most 3/4.
+static size_t table_capacity(size_t entries)
+{
+    if (!entries)
+        return 0;
+    size_t capacity = 1024;
+    while (entries * 4 > capacity * 3)
+        capacity *= 2;
+    return capacity;
+}
+
+/** \brief Returns the slot holding \p key, or the empty slot where it
+ *         belongs, or nullptr if the table is empty.
+ */
+EITCache::Entry *EITCache::Stripe::Find(uint64_t key)
+{
+    if (m_table.empty())
+        return nullptr;
+
+    size_t mask = m_table.size() - 1;
+    size_t i = hash_key(key) & mask;
+    while (m_table[i].m_key && m_table[i].m_key != key)
+        i = (i + 1) & mask;
+    return &m_table[i];
+}
+
+void EITCache::Stripe::Insert(uint64_t key, uint64_t sig)
+{
+    if ((m_used + 1) * 4 > m_table.size() * 3)
+        Rehash(table_capacity(m_used + 1));
+
+    Entry *entry = Find(key);
+    if (!entry->m_key)
+    {
+        entry->m_key = key;
+        m_used++;
+    }
+    entry->m_sig = sig;
+}
+
+/** \brief Moves all entries into a table of \p capacity slots, dropping
+ *         the slots whose key was cleared.
+ */
+void EITCache::Stripe::Rehash(size_t capacity)
 {
-    value_clauses << QString("(%1,%2,%3,%4,%5)")
-        .arg(chanid).arg(eventid).arg(extract_table_id(sig))
-        .arg(extract_version(sig)).arg(extract_endtime(sig));
+    std::vector<Entry> old(capacity);
+    old.swap(m_table);
+    m_used = 0;
+    for (const auto &entry : old)
+    {
+        if (entry.m_key)
+        {
+            *Find(entry.m_key) = entry;
+            m_used++;
+        }
+    }
 }
 
 static void delete_in_db(uint endtime)
@@ -169,7 +316,9 @@ static bool lock_channel(uint chanid, uint endtime)
     return true;
 }
 
-static void unlock_channel(uint chanid, uint updated)
+/// Releases the lock of a channel and records its statistics.
+/// \return the time recorded as when the channel was written.
+static uint unlock_channel(uint chanid, uint updated)
 {
     MSqlQuery query(MSqlQuery::InitCon());
 
@@ -199,13 +348,47 @@ static void unlock_channel(uint chanid, uint updated)
 
     if (!query.exec())
         MythDB::DBError("Error inserting eit statistics", query);
+
+    return now;
 }
 
+/// Returns when the cache of a channel was last written to the database,
+/// by any backend.
+static uint last_written(uint chanid)
+{
+    MSqlQuery query(MSqlQuery::InitCon());
+
+    QString qstr =
+        "SELECT MAX(endtime) "
+        "FROM eit_cache "
+        "WHERE chanid  = :CHANID   AND "
+        "      status  = :STATUS";
 
-event_map_t * EITCache::LoadChannel(uint chanid)
+    query.prepare(qstr);
+    query.bindValue(":CHANID",  chanid);
+    query.bindValue(":STATUS",  STATISTIC);
+
+    if (!query.exec() || !query.next())
+    {
+        MythDB::DBError("Error checking eit statistics", query);
+        return UINT_MAX;
+    }
+
+    return query.value(0).toUInt();
+}
+
+
+/** \brief Loads the cached events of a channel, from the snapshot if it is
+ *         still valid or else from the database.
+ *  \return false if the channel is cached by another backend.
+ */
+bool EITCache::LoadChannel(Stripe &stripe, uint chanid)
 {
     if (!lock_channel(chanid, m_lastPruneTime))
-        return nullptr;
+        return false;
+
+    if (LoadChannelFromSnapshot(stripe, chanid))
+        return true;
 
     MSqlQuery query(MSqlQuery::InitCon());
 
@@ -218,17 +401,16 @@ event_map_t * EITCache::LoadChannel(uint chanid)
 
     query.prepare(qstr);
     query.bindValue(":CHANID",   chanid);
-    query.bindValue(":ENDTIME",  m_lastPruneTime);
+    query.bindValue(":ENDTIME",  m_lastPruneTime.load());
     query.bindValue(":STATUS",   EITDATA);
 
     if (!query.exec() || !query.isActive())
     {
         MythDB::DBError("Error loading eitcache", query);
-        return nullptr;
+        return false;
     }
 
-    auto *eventMap = new event_map_t();
-
+    uint loaded = 0;
     while (query.next())
     {
         uint eventid = query.value(0).toUInt();
@@ -236,151 +418,415 @@ event_map_t * EITCache::LoadChannel(uint chanid)
         uint version = query.value(2).toUInt();
         uint endtime = query.value(3).toUInt();
 
-        (*eventMap)[eventid] = construct_sig(tableid, version, endtime, false);
+        stripe.Insert(construct_key(chanid, eventid),
+                      construct_sig(tableid, version, endtime, false));
+        loaded++;
     }
 
-    if (!eventMap->empty())
+    if (loaded)
         LOG(VB_EIT, LOG_INFO, LOC + QString("Loaded %1 entries for channel %2")
-                .arg(eventMap->size()).arg(chanid));
+                .arg(loaded).arg(chanid));
 
-    m_entryCnt += eventMap->size();
-    return eventMap;
+    m_entryCnt += loaded;
+    return true;
 }
 
-bool EITCache::WriteChannelToDB(QStringList &value_clauses, uint chanid)
+/** \brief Loads the cached events of a channel from the snapshot, unless
+ *         another backend has written them to the database since.
+ *
+ *  Must be called with the lock of \p stripe held.
+ */
+bool EITCache::LoadChannelFromSnapshot(Stripe &stripe, uint chanid)
 {
-    event_map_t * eventMap = m_channelMap[chanid];
+    QMutexLocker locker(&m_snapshotLock);
+    OpenSnapshot();
+    if (!m_snapshotData)
+        return false;
+
+    const auto *header   = reinterpret_cast<const SnapshotHeader*>(m_snapshotData);
+    const auto *channels = reinterpret_cast<const SnapshotChannel*>(header + 1);
+    const auto *entries  = reinterpret_cast<const Entry*>(channels + header->m_channels);
+    const auto *end      = channels + header->m_channels;
 
-    if (!eventMap)
+    const auto *channel = std::lower_bound(channels, end, chanid,
+        [](const SnapshotChannel &c, uint id) { return c.m_chanid < id; });
+    if (channel == end || channel->m_chanid != chanid)
+        return false;
+
+    uint now = MythDate::current().toSecsSinceEpoch();
+    if (channel->m_written + kSnapshotMaxAge < now ||
+        last_written(chanid) > channel->m_written)
+    {
+        LOG(VB_EIT, LOG_DEBUG, LOC +
+            QString("Snapshot of channel %1 is out of date").arg(chanid));
         return false;
+    }
+    stripe.m_written[chanid] = channel->m_written;
+
+    uint lastPruneTime = m_lastPruneTime;
+    uint loaded = 0;
+    for (uint64_t i = 0; i < channel->m_count; ++i)
+    {
+        const Entry &entry = entries[channel->m_first + i];
+        if (extract_endtime(entry.m_sig) > lastPruneTime)
+        {
+            stripe.Insert(entry.m_key, entry.m_sig);
+            loaded++;
+        }
+    }
+
+    LOG(VB_EIT, LOG_INFO, LOC + QString("Loaded %1 entries for channel %2 "
+                                        "from snapshot")
+            .arg(loaded).arg(chanid));
+
+    m_entryCnt += loaded;
+    return true;
+}
+
+/** \brief Maps the snapshot written by a previous run, the first time it
+ *         is needed. Must be called with m_snapshotLock held.
+ */
+void EITCache::OpenSnapshot(void)
+{
+    if (m_snapshotOpened)
+        return;
+    m_snapshotOpened = true;
+
+    m_snapshot.setFileName(snapshot_path());
+    if (!m_snapshot.exists() || !m_snapshot.open(QIODevice::ReadOnly))
+        return;
 
-    uint size    = eventMap->size();
-    uint updated = 0;
-    uint removed = 0;
+    qint64 size = m_snapshot.size();
+    uchar *data = nullptr;
+    if (size >= (qint64) sizeof(SnapshotHeader))
+        data = m_snapshot.map(0, size);
+
+    bool valid = false;
+    const auto *header = reinterpret_cast<const SnapshotHeader*>(data);
+    if (data && header->m_magic == kSnapshotMagic &&
+        header->m_version == kSnapshotVersion &&
+        (uint64_t) size == sizeof(SnapshotHeader) +
+                           header->m_channels * sizeof(SnapshotChannel) +
+                           header->m_entries * sizeof(Entry))
+    {
+        const auto *channels =
+            reinterpret_cast<const SnapshotChannel*>(header + 1);
+        const auto *end = channels + header->m_channels;
+        valid = std::all_of(channels, end,
+            [header](const SnapshotChannel &c)
+            { return c.m_first + c.m_count <= header->m_entries; });
+    }
 
-    event_map_t::iterator it = eventMap->begin();
-    while (it != eventMap->end())
+    if (!valid)
     {
-        if (extract_endtime(*it) > m_lastPruneTime)
+        LOG(VB_GENERAL, LOG_WARNING, LOC +
+            QString("Ignoring invalid snapshot %1").arg(m_snapshot.fileName()));
+        if (data)
+            m_snapshot.unmap(data);
+        m_snapshot.close();
+        return;
+    }
+
+    m_snapshotData = data;
+    LOG(VB_EIT, LOG_INFO, LOC + QString("Mapped snapshot of %1 entries "
+                                        "for %2 channels")
+            .arg(header->m_entries).arg(header->m_channels));
+}
+
+/** \brief Writes the cache to the snapshot file.
+ *
+ *  Only entries that are in sync with the database are written. Each
+ *  channel is stamped with when this backend last wrote it to the database,
+ *  so that it is not loaded back once another backend has written it since.
+ *  Channels of the previous snapshot that are not cached are carried over,
+ *  so that they can still be loaded from the snapshot after a restart.
+ */
+void EITCache::WriteSnapshot(void)
+{
+    uint now = MythDate::current().toSecsSinceEpoch();
+    uint lastPruneTime = m_lastPruneTime;
+    std::vector<Entry> entries;
+    QMap<uint,uint> written;
+
+    for (auto &stripe : m_stripes)
+    {
+        QMutexLocker locker(&stripe.m_lock);
+        for (auto it = stripe.m_written.cbegin();
+             it != stripe.m_written.cend(); ++it)
+        {
+            written[it.key()] = *it;
+        }
+        for (const auto &entry : stripe.m_table)
         {
-            if (modified(*it))
+            if (entry.m_key && !modified(entry.m_sig) &&
+                extract_endtime(entry.m_sig) > lastPruneTime &&
+                stripe.m_written.contains(extract_chanid(entry.m_key)))
             {
-                replace_in_db(value_clauses, chanid, it.key(), *it);
-                updated++;
-                *it &= ~(uint64_t)0 >> 1; // mark as synced
+                entries.push_back(entry);
             }
-            ++it;
         }
-        else
+    }
+
+    QMutexLocker locker(&m_snapshotLock);
+    OpenSnapshot();
+    if (m_snapshotData)
+    {
+        const auto *header   = reinterpret_cast<const SnapshotHeader*>(m_snapshotData);
+        const auto *channels = reinterpret_cast<const SnapshotChannel*>(header + 1);
+        const auto *old      = reinterpret_cast<const Entry*>(channels + header->m_channels);
+
+        for (uint32_t c = 0; c < header->m_channels; ++c)
         {
-            // Event is too old; remove from eit cache in memory
-            it = eventMap->erase(it);
-            removed++;
+            const SnapshotChannel &channel = channels[c];
+            if (written.contains(channel.m_chanid) ||
+                channel.m_written + kSnapshotMaxAge < now)
+                continue;
+
+            written[channel.m_chanid] = channel.m_written;
+            for (uint64_t i = 0; i < channel.m_count; ++i)
+            {
+                const Entry &entry = old[channel.m_first + i];
+                if (extract_endtime(entry.m_sig) > lastPruneTime)
+                    entries.push_back(entry);
+            }
         }
+
+        m_snapshot.unmap(m_snapshotData);
+        m_snapshotData = nullptr;
     }
-    unlock_channel(chanid, updated);
+    m_snapshot.close();
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) { return a.m_key < b.m_key; });
 
-    if (updated)
+    std::vector<SnapshotChannel> channels;
+    channels.reserve(written.size());
+    size_t first = 0;
+    for (auto it = written.cbegin(); it != written.cend(); ++it)
     {
-        LOG(VB_EIT, LOG_INFO, LOC + QString("Writing %1 modified entries of %2 "
-                                      "for channel %3 to database.")
-                .arg(updated).arg(size).arg(chanid));
+        size_t last = first;
+        while (last < entries.size() &&
+               extract_chanid(entries[last].m_key) == it.key())
+        {
+            last++;
+        }
+        channels.push_back({it.key(), it.value(), first, last - first});
+        first = last;
     }
-    if (removed)
+
+    SnapshotHeader header;
+    header.m_channels = channels.size();
+    header.m_written  = now;
+    header.m_entries  = entries.size();
+
+    QDir().mkpath(GetCacheDir());
+    QSaveFile file(snapshot_path());
+    auto write_block = [&file](const void *data, size_t size)
+        { return file.write(static_cast<const char*>(data), size) == (qint64) size; };
+    if (!file.open(QIODevice::WriteOnly) ||
+        !write_block(&header, sizeof(header)) ||
+        !write_block(channels.data(), channels.size() * sizeof(SnapshotChannel)) ||
+        !write_block(entries.data(), entries.size() * sizeof(Entry)) ||
+        !file.commit())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Failed to write snapshot %1: %2")
+                .arg(file.fileName(), file.errorString()));
+    }
+    else
     {
-        LOG(VB_EIT, LOG_INFO, LOC + QString("Removed %1 old entries of %2 "
-                                      "for channel %3 from cache.")
-                .arg(removed).arg(size).arg(chanid));
+        LOG(VB_EIT, LOG_INFO, LOC + QString("Wrote snapshot of %1 entries "
+                                            "for %2 channels")
+                .arg(entries.size()).arg(channels.size()));
     }
-    m_pruneCnt += removed;
 
-    return true;
+    m_snapshotOpened = false;
+    OpenSnapshot();
 }
 
-void EITCache::WriteToDB(void)
+/** \brief Collects the modified entries of the channels in \p stripe,
+ *         marking them as synced, and prunes the entries that are too old.
+ *
+ *  Must be called with the lock of \p stripe held.
+ */
+void EITCache::WriteStripeToDB(Stripe &stripe, std::vector<Entry> &updates)
 {
-    QMutexLocker locker(&m_eventMapLock);
-
-    QStringList value_clauses;
-    key_map_t::iterator it = m_channelMap.begin();
-    while (it != m_channelMap.end())
+    struct ChannelCounts
+    {
+        uint m_size    {0};
+        uint m_updated {0};
+        uint m_removed {0};
+    };
+    QMap<uint,ChannelCounts> counts;
+    uint lastPruneTime = m_lastPruneTime;
+    size_t removed = 0;
+
+    for (auto &entry : stripe.m_table)
     {
-        if (!WriteChannelToDB(value_clauses, it.key()))
-            it = m_channelMap.erase(it);
+        if (!entry.m_key)
+            continue;
+
+        ChannelCounts &channel = counts[extract_chanid(entry.m_key)];
+        channel.m_size++;
+        if (extract_endtime(entry.m_sig) > lastPruneTime)
+        {
+            if (modified(entry.m_sig))
+            {
+                updates.push_back(entry);
+                channel.m_updated++;
+                entry.m_sig &= ~(uint64_t)0 >> 1; // mark as synced
+            }
+        }
         else
-            ++it;
+        {
+            // Event is too old; remove from eit cache in memory
+            entry.m_key = 0;
+            channel.m_removed++;
+            removed++;
+        }
     }
 
-    if(value_clauses.isEmpty())
+    // Clearing keys breaks the probe sequences, so rebuild the table
+    if (removed)
+        stripe.Rehash(table_capacity(stripe.m_used - removed));
+
+    auto it = stripe.m_channels.begin();
+    while (it != stripe.m_channels.end())
     {
-        return;
+        if (!*it)
+        {
+            // Channel is locked by another backend, retry on next access
+            it = stripe.m_channels.erase(it);
+            continue;
+        }
+
+        uint chanid = it.key();
+        ChannelCounts channel = counts.value(chanid);
+        stripe.m_written[chanid] = unlock_channel(chanid, channel.m_updated);
+
+        if (channel.m_updated)
+        {
+            LOG(VB_EIT, LOG_INFO, LOC + QString("Writing %1 modified entries of %2 "
+                                          "for channel %3 to database.")
+                    .arg(channel.m_updated).arg(channel.m_size).arg(chanid));
+        }
+        if (channel.m_removed)
+        {
+            LOG(VB_EIT, LOG_INFO, LOC + QString("Removed %1 old entries of %2 "
+                                          "for channel %3 from cache.")
+                    .arg(channel.m_removed).arg(channel.m_size).arg(chanid));
+        }
+        m_pruneCnt += channel.m_removed;
+        ++it;
+    }
+}
+
+void EITCache::WriteToDB(void)
+{
+    std::vector<Entry> updates;
+    for (auto &stripe : m_stripes)
+    {
+        QMutexLocker locker(&stripe.m_lock);
+        WriteStripeToDB(stripe, updates);
     }
 
     MSqlQuery query(MSqlQuery::InitCon());
-    query.prepare(QString("REPLACE INTO eit_cache "
-                          "(chanid, eventid, tableid, version, endtime) "
-                          "VALUES %1").arg(value_clauses.join(",")));
-    if (!query.exec())
+    for (size_t i = 0; i < updates.size(); i += kBulkRows)
     {
-        MythDB::DBError("Error updating eitcache", query);
+        size_t rows = std::min(kBulkRows, updates.size() - i);
+        QStringList values;
+        for (size_t j = 0; j < rows; ++j)
+        {
+            values << QString("(:CHANID%1, :EVENTID%1, :TABLEID%1, "
+                              ":VERSION%1, :ENDTIME%1)").arg(j);
+        }
+
+        query.prepare(QString("REPLACE INTO eit_cache "
+                              "(chanid, eventid, tableid, version, endtime) "
+                              "VALUES %1").arg(values.join(",")));
+        for (size_t j = 0; j < rows; ++j)
+        {
+            const Entry &entry = updates[i + j];
+            query.bindValue(QString(":CHANID%1").arg(j),  extract_chanid(entry.m_key));
+            query.bindValue(QString(":EVENTID%1").arg(j), extract_eventid(entry.m_key));
+            query.bindValue(QString(":TABLEID%1").arg(j), extract_table_id(entry.m_sig));
+            query.bindValue(QString(":VERSION%1").arg(j), extract_version(entry.m_sig));
+            query.bindValue(QString(":ENDTIME%1").arg(j), extract_endtime(entry.m_sig));
+        }
+        if (!query.exec())
+            MythDB::DBError("Error updating eitcache", query);
+    }
+
+    uint now = MythDate::current().toSecsSinceEpoch();
+    uint last = m_lastSnapshotTime;
+    if (now >= last + kSnapshotInterval &&
+        m_lastSnapshotTime.compare_exchange_strong(last, now))
+    {
+        WriteSnapshot();
     }
 }
 
 bool EITCache::IsNewEIT(uint chanid,  uint tableid,   uint version,
                         uint eventid, uint endtime)
 {
-    m_accessCnt++;
+    uint access = ++m_accessCnt;
 
-    if ((m_accessCnt <  100000 && (m_accessCnt %  10000 == 0)) ||
-        (m_accessCnt < 1000000 && (m_accessCnt % 100000 == 0)) ||
-        (m_accessCnt % 1000000 == 0))
+    if ((access <  100000 && (access %  10000 == 0)) ||
+        (access < 1000000 && (access % 100000 == 0)) ||
+        (access % 1000000 == 0))
     {
         LOG(VB_EIT, LOG_INFO, GetStatistics());
         WriteToDB();
     }
 
+    uint lastPruneTime = m_lastPruneTime;
+
     // don't re-add pruned entries
-    if (endtime < m_lastPruneTime)
+    if (endtime < lastPruneTime)
     {
         m_prunedHitCnt++;
         return false;
     }
 
     // validity check, reject events with endtime over 7 weeks in the future
-    if (endtime > m_lastPruneTime + 50 * 86400)
+    if (endtime > lastPruneTime + 50 * 86400)
     {
         m_futureHitCnt++;
         return false;
     }
 
-    QMutexLocker locker(&m_eventMapLock);
-    if (!m_channelMap.contains(chanid))
+    Stripe &stripe = GetStripe(chanid);
+    QMutexLocker locker(&stripe.m_lock);
+    auto channel = stripe.m_channels.find(chanid);
+    if (channel == stripe.m_channels.end())
     {
-        m_channelMap[chanid] = LoadChannel(chanid);
+        channel = stripe.m_channels.insert(chanid,
+                                           LoadChannel(stripe, chanid));
     }
 
-    if (!m_channelMap[chanid])
+    if (!*channel)
     {
         m_wrongChannelHitCnt++;
         return false;
     }
 
-    event_map_t * eventMap = m_channelMap[chanid];
-    event_map_t::iterator it = eventMap->find(eventid);
-    if (it != eventMap->end())
+    uint64_t key = construct_key(chanid, eventid);
+    Entry *entry = stripe.Find(key);
+    if (entry && entry->m_key)
     {
-        if (extract_table_id(*it) > tableid)
+        uint64_t sig = entry->m_sig;
+        if (extract_table_id(sig) > tableid)
         {
             // EIT from lower (ie. better) table number
             m_tblChgCnt++;
         }
-        else if ((extract_table_id(*it) == tableid) &&
-                 (extract_version(*it) != version))
+        else if ((extract_table_id(sig) == tableid) &&
+                 (extract_version(sig) != version))
         {
             // EIT updated version on current table
             m_verChgCnt++;
         }
-        else if (extract_endtime(*it) != endtime)
+        else if (extract_endtime(sig) != endtime)
         {
             // Endtime (starttime + duration) changed
             m_endChgCnt++;
@@ -393,7 +839,7 @@ bool EITCache::IsNewEIT(uint chanid,  uint tableid,   uint version,
         }
     }
 
-    eventMap->insert(eventid, construct_sig(tableid, version, endtime, true));
+    stripe.Insert(key, construct_sig(tableid, version, endtime, true));
     m_entryCnt++;
 
     return true;
@@ -6,19 +6,50 @@
 #ifndef EIT_CACHE_H
 #define EIT_CACHE_H
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <vector>
 
 // Qt headers
 #include <QString>
 #include <QMutex>
+#include <QFile>
 #include <QMap>
 
 // MythTV headers
 #include "mythtvexp.h"
 
-using event_map_t = QMap<uint, uint64_t>;
-using key_map_t = QMap<uint, event_map_t*>;
+/// Counters of the EIT cache, as shown on the backend status page.
+struct EITCacheStatistics
+{
+    uint     m_access           {0};
+    uint     m_hit              {0};
+    uint     m_tableChange      {0};
+    uint     m_versionChange    {0};
+    uint     m_endtimeChange    {0};
+    uint     m_new              {0};
+    uint     m_pruned           {0};
+    uint     m_prunedHit        {0};
+    uint     m_futureHit        {0};
+    uint     m_wrongChannelHit  {0};
+    uint     m_channels         {0}; ///< channels currently cached
+    uint     m_entries          {0}; ///< events currently cached
+    uint64_t m_memory           {0}; ///< bytes used by the hash tables
+};
 
+/** \class EITCache
+ *  \brief Remembers the table id, version and end time of every EIT event
+ *         seen, so that repeated events are not parsed again.
+ *
+ *  Events are kept in open addressing hash tables keyed on channel id and
+ *  event id, one per stripe of channels, each with its own lock. The
+ *  eit_cache table holds the events of every backend and a channel is only
+ *  cached by the backend holding its channel lock. A snapshot of the cache
+ *  is also written to the cache directory from time to time, which lets a
+ *  restarted backend map it and skip reloading channels no other backend
+ *  has written to the database since.
+ */
 class EITCache
 {
   public:
@@ -33,28 +64,59 @@ class EITCache
 
     void ResetStatistics(void);
     QString GetStatistics(void) const;
+    EITCacheStatistics GetCounters(void) const;
 
   private:
-    event_map_t * LoadChannel(uint chanid);
-    bool WriteChannelToDB(QStringList &value_clauses, uint chanid);
-
-    // event key cache
-    key_map_t      m_channelMap;
-
-    mutable QMutex m_eventMapLock;
-    uint           m_lastPruneTime;
+    /// Slot of a hash table, m_key 0 marks an empty slot.
+    struct Entry
+    {
+        uint64_t m_key {0}; ///< chanid << 32 | eventid
+        uint64_t m_sig {0}; ///< modified, table id, version and endtime
+    };
+
+    struct Stripe
+    {
+        Entry *Find(uint64_t key);
+        void   Insert(uint64_t key, uint64_t sig);
+        void   Rehash(size_t capacity);
+
+        mutable QMutex      m_lock;
+        std::vector<Entry>  m_table;          // size is a power of two
+        size_t              m_used     {0};
+        QMap<uint,bool>     m_channels;       // false if locked elsewhere
+        QMap<uint,uint>     m_written;        // when we last wrote a channel
+    };
+
+    Stripe &GetStripe(uint chanid) { return m_stripes[chanid % kStripes]; }
+    bool LoadChannel(Stripe &stripe, uint chanid);
+    bool LoadChannelFromSnapshot(Stripe &stripe, uint chanid);
+    void WriteStripeToDB(Stripe &stripe, std::vector<Entry> &updates);
+    void OpenSnapshot(void);
+    void WriteSnapshot(void);
+
+    static constexpr uint kStripes { 16 };
+    std::array<Stripe, kStripes> m_stripes;
+
+    std::atomic<uint> m_lastPruneTime;
+    std::atomic<uint> m_lastSnapshotTime;
+
+    // snapshot of the cache, protected by m_snapshotLock
+    QMutex         m_snapshotLock;
+    QFile          m_snapshot;
+    uchar         *m_snapshotData       {nullptr};
+    bool           m_snapshotOpened     {false};
 
     // statistics
-    uint           m_accessCnt          {0};
-    uint           m_hitCnt             {0};
-    uint           m_tblChgCnt          {0};
-    uint           m_verChgCnt          {0};
-    uint           m_endChgCnt          {0};
-    uint           m_entryCnt           {0};
-    uint           m_pruneCnt           {0};
-    uint           m_prunedHitCnt       {0};
-    uint           m_futureHitCnt       {0};
-    uint           m_wrongChannelHitCnt {0};
+    std::atomic<uint> m_accessCnt          {0};
+    std::atomic<uint> m_hitCnt             {0};
+    std::atomic<uint> m_tblChgCnt          {0};
+    std::atomic<uint> m_verChgCnt          {0};
+    std::atomic<uint> m_endChgCnt          {0};
+    std::atomic<uint> m_entryCnt           {0};
+    std::atomic<uint> m_pruneCnt           {0};
+    std::atomic<uint> m_prunedHitCnt       {0};
+    std::atomic<uint> m_futureHitCnt       {0};
+    std::atomic<uint> m_wrongChannelHitCnt {0};
 
     static const uint kVersionMax;
 
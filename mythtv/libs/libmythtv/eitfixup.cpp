@@ -1,9 +1,18 @@
 // C++ headers
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <memory>
+
+// Qt headers
+#include <QWaitCondition>
+#include <QRunnable>
+#include <QThread>
+#include <QMutex>
 
 // MythTV headers
 #include "eitfixup.h"
+#include "mthreadpool.h"
 #include "programinfo.h" // for CategoryType
 #include "channelutil.h" // for GetDefaultAuthority()
 
@@ -18,6 +27,21 @@
 static const QRegularExpression kStereo { R"(\b\(?[sS]tereo\)?\b)" };
 static const QRegularExpression kUKSpaceColonStart { R"(^[ |:]*)" };
 
+// Most fields never contain what the more expensive regular expressions
+// below look for, so these cheap literal checks are done first to skip
+// the ones that cannot match.
+static bool contains_digit(const QString &str)
+{
+    return std::any_of(str.cbegin(), str.cend(),
+                       [](QChar ch) { return ch.isDigit(); });
+}
+
+static bool contains_part(const QString &str)
+{
+    return str.contains("Part", Qt::CaseInsensitive) ||
+           str.contains("Pt", Qt::CaseInsensitive);
+}
+
 #if QT_VERSION < QT_VERSION_CHECK(5,15,2)
 #define capturedView capturedRef
 #endif
@@ -152,21 +176,25 @@ void EITFixUp::Fix(DBEventEIT &event)
         static const QRegularExpression emptyParens { R"(\(\s*\))" };
         if (!event.m_title.isEmpty())
         {
-            event.m_title.remove(QChar('\0')).remove(emptyParens);
+            event.m_title.remove(QChar('\0'));
+            if (event.m_title.contains('('))
+                event.m_title.remove(emptyParens);
             event.m_title = event.m_title.simplified();
         }
 
         if (!event.m_subtitle.isEmpty())
         {
             event.m_subtitle.remove(QChar('\0'));
-            event.m_subtitle.remove(emptyParens);
+            if (event.m_subtitle.contains('('))
+                event.m_subtitle.remove(emptyParens);
             event.m_subtitle = event.m_subtitle.simplified();
         }
 
         if (!event.m_description.isEmpty())
         {
             event.m_description.remove(QChar('\0'));
-            event.m_description.remove(emptyParens);
+            if (event.m_description.contains('('))
+                event.m_description.remove(emptyParens);
             event.m_description = event.m_description.simplified();
         }
     }
@@ -189,6 +217,79 @@ void EITFixUp::Fix(DBEventEIT &event)
     }
 }
 
+/// Smallest share of a batch worth handing to another thread
+static constexpr size_t kMinEventsPerThread { 16 };
+
+/// Fixes the events of a batch that no other thread has taken yet
+class EITFixUpRunner : public QRunnable
+{
+  public:
+    EITFixUpRunner(const std::vector<DBEventEIT*> &events,
+                   std::atomic<size_t> &next)
+        : m_events(events), m_next(next)
+    {
+        setAutoDelete(false);
+    }
+
+    void run(void) override // QRunnable
+    {
+        for (size_t i = m_next++; i < m_events.size(); i = m_next++)
+            EITFixUp::Fix(*m_events[i]);
+
+        QMutexLocker locker(&m_lock);
+        m_done = true;
+        m_finished.wakeAll();
+    }
+
+    void Wait(void)
+    {
+        QMutexLocker locker(&m_lock);
+        while (!m_done)
+            m_finished.wait(&m_lock);
+    }
+
+  private:
+    const std::vector<DBEventEIT*> &m_events;
+    std::atomic<size_t>            &m_next;
+    QMutex                          m_lock;
+    QWaitCondition                  m_finished; // protected by m_lock
+    bool                            m_done {false};
+};
+
+/** \brief Fixes a batch of events on several threads.
+ *
+ *  The events are shared out one at a time between the calling thread
+ *  and up to \p threads - 1 threads of the global MThreadPool, each
+ *  event being fixed exactly as Fix(DBEventEIT&) would. Pool threads
+ *  that are not free right away are not waited for, so a busy pool
+ *  just means fixing more of the events on the calling thread.
+ *
+ *  \param threads Maximum number of threads to use, 0 for one per core.
+ */
+void EITFixUp::Fix(const std::vector<DBEventEIT*> &events, int threads)
+{
+    if (threads <= 0)
+        threads = QThread::idealThreadCount();
+    size_t helpers = std::min(static_cast<size_t>(std::max(threads, 1) - 1),
+                              events.size() / kMinEventsPerThread);
+
+    std::atomic<size_t> next {0};
+    std::vector<std::unique_ptr<EITFixUpRunner> > runners;
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        auto runner = std::make_unique<EITFixUpRunner>(events, next);
+        if (!MThreadPool::globalInstance()->tryStart(runner.get(), "EITFixUp"))
+            break;
+        runners.push_back(std::move(runner));
+    }
+
+    for (size_t i = next++; i < events.size(); i = next++)
+        Fix(*events[i]);
+
+    for (auto &runner : runners)
+        runner->Wait();
+}
+
 /**
  *  This adds a DVB EIT default authority to series id or program id if
  *  one exists in the DB for that channel, otherwise it returns a blank
@@ -672,37 +773,51 @@ void EITFixUp::FixUK(DBEventEIT &event)
         QRegularExpression::CaseInsensitiveOption };
     static const QRegularExpression ukNewTitle { R"(^(Brand New|New:)\s*)",
         QRegularExpression::CaseInsensitiveOption };
-    event.m_description = event.m_description.remove(ukThen);
-    event.m_description = event.m_description.remove(ukNew);
-    event.m_title = event.m_title.remove(ukNewTitle);
+    if (event.m_description.contains("60 Seconds", Qt::CaseInsensitive))
+        event.m_description = event.m_description.remove(ukThen);
+    if (event.m_description.contains("New", Qt::CaseInsensitive))
+        event.m_description = event.m_description.remove(ukNew);
+    if (event.m_title.startsWith("New:", Qt::CaseInsensitive) ||
+        event.m_title.startsWith("Brand New", Qt::CaseInsensitive))
+        event.m_title = event.m_title.remove(ukNewTitle);
 
     // Removal of Class TV, CBBC and CBeebies etc..
     static const QRegularExpression ukTitleRemove { "^(?:[tT]4:|Schools\\s*?:)" };
     static const QRegularExpression ukDescriptionRemove { R"(^(?:CBBC\s*?\.|CBeebies\s*?\.|Class TV\s*?:|BBC Switch\.))" };
-    event.m_title = event.m_title.remove(ukTitleRemove);
-    event.m_description = event.m_description.remove(ukDescriptionRemove);
+    if (event.m_title.startsWith("T4:", Qt::CaseInsensitive) ||
+        event.m_title.startsWith("Schools"))
+        event.m_title = event.m_title.remove(ukTitleRemove);
+    if (event.m_description.startsWith("C") ||
+        event.m_description.startsWith("BBC Switch."))
+        event.m_description = event.m_description.remove(ukDescriptionRemove);
 
     // Removal of BBC FOUR and BBC THREE
     static const QRegularExpression ukBBC34 { R"(BBC (?:THREE|FOUR) on BBC (?:ONE|TWO)\.)",
         QRegularExpression::CaseInsensitiveOption };
-    event.m_description = event.m_description.remove(ukBBC34);
+    if (event.m_description.contains("BBC", Qt::CaseInsensitive))
+        event.m_description = event.m_description.remove(ukBBC34);
 
     // BBC 7 [Rpt of ...] case.
     static const QRegularExpression ukBBC7rpt { R"(\[Rptd?[^]]+?\d{1,2}\.\d{1,2}[ap]m\]\.)" };
-    event.m_description = event.m_description.remove(ukBBC7rpt);
+    if (event.m_description.contains("[Rpt"))
+        event.m_description = event.m_description.remove(ukBBC7rpt);
 
     // "All New To 4Music!
     static const QRegularExpression ukAllNew { R"(All New To 4Music!\s?)" };
-    event.m_description = event.m_description.remove(ukAllNew);
+    if (event.m_description.contains("All New To 4Music!"))
+        event.m_description = event.m_description.remove(ukAllNew);
 
     // Removal of 'Also in HD' text
     static const QRegularExpression ukAlsoInHD { R"(\s*Also in HD\.)",
         QRegularExpression::CaseInsensitiveOption };
-    event.m_description = event.m_description.remove(ukAlsoInHD);
+    if (event.m_description.contains("Also in HD.", Qt::CaseInsensitive))
+        event.m_description = event.m_description.remove(ukAlsoInHD);
 
     // Remove [AD,S] etc.
     static const QRegularExpression ukCC { R"(\[(?:(AD|SL|S|W|HD),?)+\])" };
-    auto match = ukCC.match(event.m_description);
+    QRegularExpressionMatch match;
+    if (event.m_description.contains('['))
+        match = ukCC.match(event.m_description);
     while (match.hasMatch())
     {
         QStringList tmpCCitems = match.captured(0).remove("[").remove("]").split(",");
@@ -765,11 +880,14 @@ void EITFixUp::FixUK(DBEventEIT &event)
 
     bool series  = false;
     bool fromTitle = true;
-    match = ukSeries.match(event.m_title);
+    match = QRegularExpressionMatch();
+    if (contains_digit(event.m_title))
+        match = ukSeries.match(event.m_title);
     if (!match.hasMatch())
     {
         fromTitle = false;
-        match = ukSeries.match(event.m_description);
+        if (contains_digit(event.m_description))
+            match = ukSeries.match(event.m_description);
     }
     if (match.hasMatch())
     {
@@ -838,8 +956,12 @@ void EITFixUp::FixUK(DBEventEIT &event)
     // Matches Part 1, Pt 1/2, Part 1 of 2 etc.
     static const QRegularExpression ukPart { R"([-(\:,.]\s*(?:Part|Pt)\s*(\d+)\s*(?:(?:of|/)\s*(\d+))?\s*[-):,.])",
         QRegularExpression::CaseInsensitiveOption };
-    match = ukPart.match(event.m_title);
-    auto match2 = ukPart.match(event.m_description);
+    match = QRegularExpressionMatch();
+    if (contains_part(event.m_title))
+        match = ukPart.match(event.m_title);
+    QRegularExpressionMatch match2;
+    if (contains_part(event.m_description))
+        match2 = ukPart.match(event.m_description);
     if (match.hasMatch())
     {
         event.m_partnumber = match.captured(1).toUInt();
@@ -872,7 +994,9 @@ void EITFixUp::FixUK(DBEventEIT &event)
     }
 
     static const QRegularExpression ukStarring { R"((?:Western\s)?[Ss]tarring ([\w\s\-']+?)[Aa]nd\s([\w\s\-']+?)[\.|,]\s*(\d{4})?(?:\.\s)?)" };
-    match = ukStarring.match(event.m_description);
+    match = QRegularExpressionMatch();
+    if (event.m_description.contains("tarring "))
+        match = ukStarring.match(event.m_description);
     if (match.hasMatch())
     {
         // if we match this we've captured 2 actors and an (optional) airdate
@@ -996,7 +1120,9 @@ void EITFixUp::FixUK(DBEventEIT &event)
 
     // Work out the year (if any)
     static const QRegularExpression ukYear { R"([\[\(]([\d]{4})[\)\]])" };
-    match = ukYear.match(event.m_description);
+    match = QRegularExpressionMatch();
+    if (contains_digit(event.m_description))
+        match = ukYear.match(event.m_description);
     if (match.hasMatch())
     {
         event.m_description.remove(match.capturedStart(0),
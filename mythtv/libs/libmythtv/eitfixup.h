@@ -5,6 +5,9 @@
 #ifndef EITFIXUP_H
 #define EITFIXUP_H
 
+// C++ headers
+#include <vector>
+
 #include "programdata.h"
 
 /// EIT Fix Up Functions
@@ -73,6 +76,7 @@ class MTV_PUBLIC EITFixUp
     EITFixUp() = default;
 
     static void Fix(DBEventEIT &event);
+    static void Fix(const std::vector<DBEventEIT*> &events, int threads = 0);
 
     static int parseRoman (QString roman);
 
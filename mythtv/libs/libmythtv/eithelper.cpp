@@ -2,6 +2,7 @@
 
 // Std C++ headers
 #include <algorithm>
+#include <vector>
 
 // MythTV includes
 #include "eithelper.h"
@@ -15,12 +16,13 @@
 #include "premieredescriptors.h"
 #include "channelutil.h"
 #include "mythdate.h"
+#include "mythtimer.h"
 #include "programdata.h"
 #include "programinfo.h"        // for subtitle types and audio and video properties
 #include "scheduledrecording.h" // for ScheduledRecording
 #include "compat.h"             // for gmtime_r on windows.
 
-const uint EITHelper::kChunkSize =   20;
+const uint EITHelper::kChunkSize =  500;
 const uint EITHelper::kMaxSize   = 1000;
 
 EITCache *EITHelper::s_eitCache = new EITCache();
@@ -62,51 +64,107 @@ bool EITHelper::EventQueueFull(void) const
     return full;
 }
 
+uint EITHelper::GetMaxListSize(void) const
+{
+    QMutexLocker locker(&m_eitListLock);
+    return m_maxListSize;
+}
+
+uint64_t EITHelper::GetEventsWritten(void) const
+{
+    QMutexLocker locker(&m_eitListLock);
+    return m_eventsWritten;
+}
+
+double EITHelper::GetEventsPerSecond(void) const
+{
+    QMutexLocker locker(&m_eitListLock);
+    if (m_writeTime == 0ms)
+        return 0.0;
+    return m_eventsWritten / duration_cast<floatsecs>(m_writeTime).count();
+}
+
 /** \fn EITHelper::ProcessEvents(void)
  *  \brief Get events from queue and insert into DB after processing.
  *
  * Process a maximum of kChunkSize events at a time
- * to avoid clogging the machine.
+ * to avoid clogging the machine. The events are fixed up on several
+ * threads, then grouped per channel and each channel is written with
+ * DBEventEIT::UpdateDBBulk(), falling back to one event at a time if
+ * that fails.
  *
  *  \return Returns number of events inserted into DB.
  */
 uint EITHelper::ProcessEvents(void)
 {
     QMutexLocker locker(&m_eitListLock);
-    uint insertCount = 0;
 
     if (m_dbEvents.empty())
         return 0;
 
-    MSqlQuery query(MSqlQuery::InitCon());
-    for (uint i = 0; (i < kChunkSize) && (!m_dbEvents.empty()); i++)
-    {
-        DBEventEIT *event = m_dbEvents.dequeue();
-        m_eitListLock.unlock();
+    m_maxListSize = std::max(m_maxListSize, static_cast<uint>(m_dbEvents.size()));
+
+    std::vector<DBEventEIT*> events;
+    while ((events.size() < kChunkSize) && (!m_dbEvents.empty()))
+        events.push_back(m_dbEvents.dequeue());
+    m_eitListLock.unlock();
 
-        EITFixUp::Fix(*event);
+    MythTimer timer;
+    timer.start();
 
-        insertCount += event->UpdateDB(query, 1000);
+    EITFixUp::Fix(events);
+
+    // Keep the queue order within each channel, it matters when
+    // several versions of the same event are queued.
+    QMap<uint, std::vector<DBEventEIT*> > channels;
+    for (auto *event : events)
+    {
+        channels[event->m_chanid].push_back(event);
         m_maxStarttime = std::max (m_maxStarttime, event->m_starttime);
+    }
 
-        delete event;
-        m_eitListLock.lock();
+    uint insertCount = 0;
+    MSqlQuery query(MSqlQuery::InitCon());
+    for (auto it = channels.cbegin(); it != channels.cend(); ++it)
+    {
+        uint count = 0;
+        if (DBEventEIT::UpdateDBBulk(query, it.key(), *it, 1000, count))
+        {
+            insertCount += count;
+            continue;
+        }
+
+        LOG(VB_EIT, LOG_WARNING, LOC_ID +
+            QString("Bulk update of chanid %1 failed, "
+                    "updating one event at a time").arg(it.key()));
+        for (auto *event : *it)
+            insertCount += event->UpdateDB(query, 1000);
     }
 
+    for (auto *event : events)
+        delete event;
+
+    std::chrono::milliseconds elapsed = timer.elapsed();
+    m_eitListLock.lock();
+    m_eventsWritten += events.size();
+    m_writeTime += elapsed;
+
     if (!insertCount)
         return 0;
 
     if (!m_incompleteEvents.empty())
     {
         LOG(VB_EIT, LOG_INFO, LOC_ID +
-            QString("Added %1 events -- complete: %2 incomplete: %3")
-                .arg(insertCount).arg(m_dbEvents.size())
-                .arg(m_incompleteEvents.size()));
+            QString("Added %1 of %2 events in %3 ms -- complete: %4 incomplete: %5")
+                .arg(insertCount).arg(events.size()).arg(elapsed.count())
+                .arg(m_dbEvents.size()).arg(m_incompleteEvents.size()));
     }
     else
     {
         LOG(VB_EIT, LOG_INFO, LOC_ID +
-            QString("Added %1 events").arg(insertCount));
+            QString("Added %1 of %2 events in %3 ms -- queued: %4")
+                .arg(insertCount).arg(events.size()).arg(elapsed.count())
+                .arg(m_dbEvents.size()));
     }
 
     return insertCount;
@@ -764,6 +822,19 @@ void EITHelper::WriteEITCache(void)
     s_eitCache->WriteToDB();
 }
 
+/// Writes the cache to the database and the snapshot file on shutdown,
+/// once no more EIT is being processed.
+void EITHelper::DeleteEITCache(void)
+{
+    delete s_eitCache;
+    s_eitCache = nullptr;
+}
+
+EITCacheStatistics EITHelper::GetEITCacheStatistics(void)
+{
+    return s_eitCache->GetCounters();
+}
+
 //////////////////////////////////////////////////////////////////////
 // private methods and functions below this line                    //
 //////////////////////////////////////////////////////////////////////
@@ -84,6 +84,7 @@ using FixupMap   = QMap<FixupKey, FixupValue>;
 class DBEventEIT;
 class EITFixUp;
 class EITCache;
+struct EITCacheStatistics;
 
 class EventInformationTable;
 class ExtendedTextTable;
@@ -102,6 +103,11 @@ class EITHelper
     uint ProcessEvents(void);
     bool EventQueueFull(void) const;
 
+    // Statistics of the events written to the database
+    uint     GetMaxListSize(void) const;
+    uint64_t GetEventsWritten(void) const;
+    double   GetEventsPerSecond(void) const;
+
     uint GetGPSOffset(void) const { return (uint) (0 - m_gpsOffset); }
 
     void SetChannelID(uint channelid);
@@ -128,6 +134,8 @@ class EITHelper
     // EIT cache handling
     static void PruneEITCache(uint timestamp);
     static void WriteEITCache(void);
+    static MTV_PUBLIC void DeleteEITCache(void);
+    static MTV_PUBLIC EITCacheStatistics GetEITCacheStatistics(void);
 
   private:
     uint GetChanID(uint atsc_major, uint atsc_minor);           // Only ATSC
@@ -157,9 +165,13 @@ class EITHelper
 
     MythDeque<DBEventEIT*>  m_dbEvents;
 
+    uint                    m_maxListSize   {0};      // Largest queue seen by ProcessEvents
+    uint64_t                m_eventsWritten {0};      // Events handled by ProcessEvents
+    std::chrono::milliseconds m_writeTime   {0ms};    // Time spent writing them
+
     QMap<uint,uint>         m_languagePreferences;
 
-    static const uint kChunkSize;   // Maximum number of DB inserts per ProcessEvents call
+    static const uint kChunkSize;   // Maximum number of events per ProcessEvents call
     static const uint kMaxSize;     // Maximum number of events waiting to be processed
 };
 
@@ -95,7 +95,11 @@ void EITScanner::run(void)
         if (!m_activeScan && eitCount && (t.elapsed() > 60s))
         {
             LOG(VB_EIT, LOG_INFO,
-                LOC_ID + QString("Added %1 EIT events in passive scan").arg(eitCount));
+                LOC_ID + QString("Added %1 EIT events in passive scan "
+                                 "(%2 events/s, max queue %3)")
+                    .arg(eitCount)
+                    .arg(m_eitHelper->GetEventsPerSecond(), 0, 'f', 1)
+                    .arg(m_eitHelper->GetMaxListSize()));
             eitCount = 0;
             RescheduleRecordings();
         }
@@ -107,7 +111,11 @@ void EITScanner::run(void)
             if (eitCount)
             {
                 LOG(VB_EIT, LOG_INFO,
-                    LOC_ID + QString("Added %1 EIT events in active scan").arg(eitCount));
+                    LOC_ID + QString("Added %1 EIT events in active scan "
+                                     "(%2 events/s, max queue %3)")
+                        .arg(eitCount)
+                        .arg(m_eitHelper->GetEventsPerSecond(), 0, 'f', 1)
+                        .arg(m_eitHelper->GetMaxListSize()));
                 eitCount = 0;
                 RescheduleRecordings();
             }
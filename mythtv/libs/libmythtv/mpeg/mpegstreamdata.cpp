@@ -140,6 +140,11 @@ void MPEGStreamData::Reset(int desiredProgram)
     m_pidsWriting.clear();
     m_pidsAudio.clear();
     m_pidsConditionalAccess.clear();
+    {
+        QMutexLocker locker(&m_encryptionLock);
+        for (auto & flags : m_pidFlags)
+            flags &= kPIDEncryptionTest;
+    }
 
     m_pidVideoSingleProgram = m_pidPmtSingleProgram = 0xffffffff;
 
@@ -597,11 +602,11 @@ bool MPEGStreamData::CreatePMTSingleProgram(const ProgramMapTable &pmt)
         }
     }
 
-    m_pidsAudio.clear();
+    ClearPIDMap(m_pidsAudio, kPIDAudio);
     for (uint pid : audioPIDs)
         AddAudioPID(pid);
 
-    m_pidsWriting.clear();
+    ClearPIDMap(m_pidsWriting, kPIDWriting);
     m_pidVideoSingleProgram = !videoPIDs.empty() ? videoPIDs[0] : 0xffffffff;
     for (size_t i = 1; i < videoPIDs.size(); i++)
         AddWritingPID(videoPIDs[i]);
@@ -983,8 +988,35 @@ int MPEGStreamData::ProcessData(const unsigned char *buffer, int len)
         }
 
         const auto *pkt = reinterpret_cast<const TSPacket*>(&buffer[pos]);
-        pos += TSPacket::kSize; // Advance to next TS packet
+
+        // Gather the run of in sync, error free packets on this PID
+        // so the listeners can handle them in one call.
+        uint count = 1;
+        if (!pkt->TransportError())
+        {
+            const uint pid = pkt->PID();
+            int next = pos + TSPacket::kSize;
+            while (next + int(TSPacket::kSize) <= len &&
+                   buffer[next] == SYNC_BYTE)
+            {
+                const auto *npkt =
+                    reinterpret_cast<const TSPacket*>(&buffer[next]);
+                if (npkt->TransportError() || npkt->PID() != pid)
+                    break;
+                next += TSPacket::kSize;
+                count++;
+            }
+        }
+
         resync = false;
+        if (count > 1)
+        {
+            ProcessTSPackets(pkt, count);
+            pos += count * TSPacket::kSize;
+            continue;
+        }
+
+        pos += TSPacket::kSize; // Advance to next TS packet
         if (!ProcessTSPacket(*pkt))
         {
             if (pos + int(TSPacket::kSize) > len)
@@ -1007,7 +1039,11 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
 {
     bool ok = !tspacket.TransportError();
 
-    if (IsEncryptionTestPID(tspacket.PID()))
+    // PID() is 13 bits, so this is always in range of m_pidFlags.
+    const uint pid = tspacket.PID();
+    const uint8_t flags = m_pidFlags[pid];
+
+    if ((flags & kPIDEncryptionTest) && IsEncryptionTestPID(pid))
     {
         ProcessEncryptedPacket(tspacket);
     }
@@ -1035,7 +1071,7 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
         }
     }
 
-    if (IsVideoPID(tspacket.PID()))
+    if (IsVideoPID(pid))
     {
         for (auto & listener : m_tsAvListeners)
             listener->ProcessVideoTSPacket(tspacket);
@@ -1043,7 +1079,7 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
         return true;
     }
 
-    if (IsAudioPID(tspacket.PID()))
+    if (flags & kPIDAudio)
     {
         for (auto & listener : m_tsAvListeners)
             listener->ProcessAudioTSPacket(tspacket);
@@ -1051,15 +1087,15 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
         return true;
     }
 
-    if (IsWritingPID(tspacket.PID()))
+    if (flags & kPIDWriting)
     {
         for (auto & listener : m_tsWritingListeners)
             listener->ProcessTSPacket(tspacket);
     }
 
-    if (tspacket.HasPayload() &&
-        IsListeningPID(tspacket.PID()) &&
-        !IsConditionalAccessPID(tspacket.PID()))
+    if (tspacket.HasPayload() && !m_listeningDisabled &&
+        ((flags & (kPIDListening | kPIDNotListening |
+                   kPIDConditionalAccess)) == kPIDListening))
     {
         HandleTSTables(&tspacket);          // Table handling starts here....
     }
@@ -1067,28 +1103,81 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
     return true;
 }
 
-int MPEGStreamData::ResyncStream(const unsigned char *buffer, int curr_pos,
-                                 int len)
+/** \fn MPEGStreamData::ProcessTSPackets(const TSPacket*,uint)
+ *  \brief Processes a run of error free packets that all share one PID.
+ *
+ *  Runs of audio, video or write-only packets are handed to the
+ *  listeners in a single call, anything needing per packet attention
+ *  (tables, encryption monitoring, PCR debugging) goes through
+ *  ProcessTSPacket() one packet at a time.
+ */
+bool MPEGStreamData::ProcessTSPackets(const TSPacket *tspackets, uint count)
 {
-    // Search for two sync bytes 188 bytes apart,
-    int pos = curr_pos;
-    int nextpos = pos + TSPacket::kSize;
-    if (nextpos >= len)
-        return -1; // not enough bytes; caller should try again
+    const uint pid = tspackets[0].PID();
+    const uint8_t flags = m_pidFlags[pid];
 
-    while (buffer[pos] != SYNC_BYTE || buffer[nextpos] != SYNC_BYTE)
+    bool is_video = IsVideoPID(pid);
+    bool is_audio = !is_video && ((flags & kPIDAudio) != 0);
+    bool is_writing = !is_video && !is_audio &&
+        ((flags & (kPIDWriting | kPIDListening)) == kPIDWriting);
+
+    if ((!is_video && !is_audio && !is_writing) ||
+        (flags & kPIDEncryptionTest) ||
+        VERBOSE_LEVEL_CHECK(VB_RECORD, LOG_DEBUG))
     {
-        pos++;
-        nextpos++;
-        if (nextpos == len)
-            return -2; // not found
+        bool ok = true;
+        for (uint i = 0; i < count; ++i)
+            ok &= ProcessTSPacket(tspackets[i]);
+        return ok;
     }
 
-    return pos;
+    // Scrambled packets are dropped, so split the run around them.
+    uint i = 0;
+    while (i < count)
+    {
+        if (tspackets[i].Scrambled())
+        {
+            i++;
+            continue;
+        }
+
+        uint start = i;
+        while (i < count && !tspackets[i].Scrambled())
+            i++;
+
+        const TSPacket *run = &tspackets[start];
+        uint run_count = i - start;
+        if (is_video)
+        {
+            for (auto & listener : m_tsAvListeners)
+                listener->ProcessVideoTSPackets(run, run_count);
+        }
+        else if (is_audio)
+        {
+            for (auto & listener : m_tsAvListeners)
+                listener->ProcessAudioTSPackets(run, run_count);
+        }
+        else
+        {
+            for (auto & listener : m_tsWritingListeners)
+                listener->ProcessTSPackets(run, run_count);
+        }
+    }
+
+    return true;
+}
+
+int MPEGStreamData::ResyncStream(const unsigned char *buffer, int curr_pos,
+                                 int len)
+{
+    // Search for two sync bytes 188 bytes apart,
+    return TSSyncScanner::FindResync(buffer, curr_pos, len);
 }
 
 bool MPEGStreamData::IsConditionalAccessPID(uint pid) const
 {
+    if (pid < m_pidFlags.size())
+        return (m_pidFlags[pid] & kPIDConditionalAccess) != 0;
     pid_map_t::const_iterator it = m_pidsConditionalAccess.find(pid);
     return it != m_pidsConditionalAccess.end();
 }
@@ -1097,28 +1186,43 @@ bool MPEGStreamData::IsListeningPID(uint pid) const
 {
     if (m_listeningDisabled || IsNotListeningPID(pid))
         return false;
+    if (pid < m_pidFlags.size())
+        return (m_pidFlags[pid] & kPIDListening) != 0;
     pid_map_t::const_iterator it = m_pidsListening.find(pid);
     return it != m_pidsListening.end();
 }
 
 bool MPEGStreamData::IsNotListeningPID(uint pid) const
 {
+    if (pid < m_pidFlags.size())
+        return (m_pidFlags[pid] & kPIDNotListening) != 0;
     pid_map_t::const_iterator it = m_pidsNotListening.find(pid);
     return it != m_pidsNotListening.end();
 }
 
 bool MPEGStreamData::IsWritingPID(uint pid) const
 {
+    if (pid < m_pidFlags.size())
+        return (m_pidFlags[pid] & kPIDWriting) != 0;
     pid_map_t::const_iterator it = m_pidsWriting.find(pid);
     return it != m_pidsWriting.end();
 }
 
 bool MPEGStreamData::IsAudioPID(uint pid) const
 {
+    if (pid < m_pidFlags.size())
+        return (m_pidFlags[pid] & kPIDAudio) != 0;
     pid_map_t::const_iterator it = m_pidsAudio.find(pid);
     return it != m_pidsAudio.end();
 }
 
+void MPEGStreamData::ClearPIDMap(pid_map_t &pids, uint8_t flag)
+{
+    for (auto it = pids.cbegin(); it != pids.cend(); ++it)
+        ClearPIDFlag(it.key(), flag);
+    pids.clear();
+}
+
 uint MPEGStreamData::GetPIDs(pid_map_t &pids) const
 {
     uint sz = pids.size();
@@ -1746,6 +1850,7 @@ void MPEGStreamData::AddEncryptionTestPID(uint pnum, uint pid, bool isvideo)
     AddListeningPID(pid);
 
     m_encryptionPidToInfo[pid] = CryptInfo((isvideo) ? 10000 : 500, 8);
+    SetPIDFlag(pid, kPIDEncryptionTest);
 
     m_encryptionPidToPnums[pid].push_back(pnum);
     m_encryptionPnumToPids[pnum].push_back(pid);
@@ -1787,6 +1892,7 @@ void MPEGStreamData::RemoveEncryptionTestPIDs(uint pnum)
             {
                 m_encryptionPidToPnums.remove(pid);
                 m_encryptionPidToInfo.remove(pid);
+                ClearPIDFlag(pid, kPIDEncryptionTest);
             }
         }
     }
@@ -1836,6 +1942,11 @@ void MPEGStreamData::ResetDecryptionMonitoringState(void)
 {
     QMutexLocker locker(&m_encryptionLock);
 
+    for (auto it = m_encryptionPidToInfo.cbegin();
+         it != m_encryptionPidToInfo.cend(); ++it)
+    {
+        ClearPIDFlag(it.key(), kPIDEncryptionTest);
+    }
     m_encryptionPidToInfo.clear();
     m_encryptionPidToPnums.clear();
     m_encryptionPnumToPids.clear();
@@ -4,6 +4,7 @@
 #define MPEGSTREAMDATA_H_
 
 // C++
+#include <array>
 #include <cstdint>  // uint64_t
 #include <vector>
 
@@ -112,30 +113,40 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     virtual bool HandleTables(uint pid, const PSIPTable &psip);
     virtual void HandleTSTables(const TSPacket* tspacket);
     virtual bool ProcessTSPacket(const TSPacket& tspacket);
+    virtual bool ProcessTSPackets(const TSPacket *tspackets, uint count);
     virtual int  ProcessData(const unsigned char *buffer, int len);
     inline  void HandleAdaptationFieldControl(const TSPacket* tspacket);
 
     // Listening
     virtual void AddListeningPID(
         uint pid, PIDPriority priority = kPIDPriorityNormal)
-        { m_pidsListening[pid] = priority; }
+        { m_pidsListening[pid] = priority; SetPIDFlag(pid, kPIDListening); }
     virtual void AddNotListeningPID(uint pid)
-        { m_pidsNotListening[pid] = kPIDPriorityNormal; }
+    {
+        m_pidsNotListening[pid] = kPIDPriorityNormal;
+        SetPIDFlag(pid, kPIDNotListening);
+    }
     virtual void AddWritingPID(
         uint pid, PIDPriority priority = kPIDPriorityHigh)
-        { m_pidsWriting[pid] = priority; }
+        { m_pidsWriting[pid] = priority; SetPIDFlag(pid, kPIDWriting); }
     virtual void AddAudioPID(
         uint pid, PIDPriority priority = kPIDPriorityHigh)
-        { m_pidsAudio[pid] = priority; }
+        { m_pidsAudio[pid] = priority; SetPIDFlag(pid, kPIDAudio); }
     virtual void AddConditionalAccessPID(
         uint pid, PIDPriority priority = kPIDPriorityNormal)
-        { m_pidsConditionalAccess[pid] = priority; }
+    {
+        m_pidsConditionalAccess[pid] = priority;
+        SetPIDFlag(pid, kPIDConditionalAccess);
+    }
 
-    virtual void RemoveListeningPID(uint pid) { m_pidsListening.remove(pid);  }
+    virtual void RemoveListeningPID(uint pid)
+        { m_pidsListening.remove(pid); ClearPIDFlag(pid, kPIDListening); }
     virtual void RemoveNotListeningPID(uint pid)
-        { m_pidsNotListening.remove(pid); }
-    virtual void RemoveWritingPID(uint pid) { m_pidsWriting.remove(pid);    }
-    virtual void RemoveAudioPID(uint pid)   { m_pidsAudio.remove(pid);      }
+        { m_pidsNotListening.remove(pid); ClearPIDFlag(pid, kPIDNotListening); }
+    virtual void RemoveWritingPID(uint pid)
+        { m_pidsWriting.remove(pid); ClearPIDFlag(pid, kPIDWriting); }
+    virtual void RemoveAudioPID(uint pid)
+        { m_pidsAudio.remove(pid); ClearPIDFlag(pid, kPIDAudio); }
 
     virtual bool IsListeningPID(uint pid) const;
     virtual bool IsNotListeningPID(uint pid) const;
@@ -319,6 +330,30 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     float                     m_eitRate                     {1.0F};
 
     // Listening
+    /// Per-PID classification bits, these mirror the pid_map_t's below
+    /// so ProcessTSPacket() can classify a packet with a single lookup.
+    enum PIDFlag : uint8_t
+    {
+        kPIDListening         = 0x01,
+        kPIDNotListening      = 0x02,
+        kPIDWriting           = 0x04,
+        kPIDAudio             = 0x08,
+        kPIDConditionalAccess = 0x10,
+        kPIDEncryptionTest    = 0x20,
+    };
+    void SetPIDFlag(uint pid, uint8_t flag)
+    {
+        if (pid < m_pidFlags.size())
+            m_pidFlags[pid] |= flag;
+    }
+    void ClearPIDFlag(uint pid, uint8_t flag)
+    {
+        if (pid < m_pidFlags.size())
+            m_pidFlags[pid] &= ~flag;
+    }
+    void ClearPIDMap(pid_map_t &pids, uint8_t flag);
+    std::array<uint8_t,0x2000> m_pidFlags                   {};
+
     pid_map_t                 m_pidsListening;
     pid_map_t                 m_pidsNotListening;
     pid_map_t                 m_pidsWriting;
@@ -63,6 +63,14 @@ class TSPacketListener
 {
   public:
     virtual bool ProcessTSPacket(const TSPacket& tspacket) = 0;
+    /// Processes a run of contiguous packets that all share one PID.
+    virtual bool ProcessTSPackets(const TSPacket *tspackets, uint count)
+    {
+        bool ok = true;
+        for (uint i = 0; i < count; ++i)
+            ok &= ProcessTSPacket(tspackets[i]);
+        return ok;
+    }
 
   protected:
     virtual ~TSPacketListener() = default;
@@ -73,6 +81,22 @@ class TSPacketListenerAV
   public:
     virtual bool ProcessVideoTSPacket(const TSPacket& tspacket) = 0;
     virtual bool ProcessAudioTSPacket(const TSPacket& tspacket) = 0;
+    /// Processes a run of contiguous video packets that all share one PID.
+    virtual bool ProcessVideoTSPackets(const TSPacket *tspackets, uint count)
+    {
+        bool ok = true;
+        for (uint i = 0; i < count; ++i)
+            ok &= ProcessVideoTSPacket(tspackets[i]);
+        return ok;
+    }
+    /// Processes a run of contiguous audio packets that all share one PID.
+    virtual bool ProcessAudioTSPackets(const TSPacket *tspackets, uint count)
+    {
+        bool ok = true;
+        for (uint i = 0; i < count; ++i)
+            ok &= ProcessAudioTSPacket(tspackets[i]);
+        return ok;
+    }
 
   protected:
     virtual ~TSPacketListenerAV() = default;
@@ -1,8 +1,17 @@
 // -*- Mode: c++ -*-
 // Copyright (c) 2003-2004, Daniel Thor Kristjansson
 #include <cstdint> // for intptr_t
+#include "config.h"
 #include "tspacket.h"
 
+extern "C" {
+#include "libavutil/cpu.h"
+}
+
+#if (HAVE_SSE2 && ARCH_X86_64)
+#include <immintrin.h>
+#endif
+
 const TSHeaderArray TSHeader::kPayloadOnlyHeader
 {
     SYNC_BYTE,
@@ -45,3 +54,113 @@ QString TSPacket::toString() const
                .arg(ContinuityCounter()));
     return str;
 }
+
+uint TSSyncScanner::InSyncPackets(const unsigned char *buffer, uint len)
+{
+    // Only one byte in every packet is looked at, so this is bound by
+    // memory latency rather than compares and gains nothing from SIMD.
+    uint count = 0;
+    for (uint pos = 0; pos + TSPacket::kSize <= len; pos += TSPacket::kSize)
+    {
+        if (buffer[pos] != SYNC_BYTE)
+            break;
+        count++;
+    }
+    return count;
+}
+
+int TSSyncScanner::FindResyncScalar(const unsigned char *buffer, int pos,
+                                    int len)
+{
+    int nextpos = pos + TSPacket::kSize;
+    if (nextpos >= len)
+        return -1; // not enough bytes; caller should try again
+
+    while (buffer[pos] != SYNC_BYTE || buffer[nextpos] != SYNC_BYTE)
+    {
+        pos++;
+        nextpos++;
+        if (nextpos == len)
+            return -2; // not found
+    }
+
+    return pos;
+}
+
+#if (HAVE_SSE2 && ARCH_X86_64)
+static int find_resync_sse2(const unsigned char *buffer, int pos, int len)
+{
+    if (pos + int(TSPacket::kSize) >= len)
+        return -1;
+
+    const __m128i sync = _mm_set1_epi8(SYNC_BYTE);
+    for (; pos + int(TSPacket::kSize) + 16 <= len; pos += 16)
+    {
+        __m128i cur  = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(buffer + pos));
+        __m128i next = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(buffer + pos + TSPacket::kSize));
+        int mask = _mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(cur, sync),
+                          _mm_cmpeq_epi8(next, sync)));
+        if (mask)
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+
+    if (pos + int(TSPacket::kSize) >= len)
+        return -2;
+    return TSSyncScanner::FindResyncScalar(buffer, pos, len);
+}
+
+#if HAVE_AVX2 && defined(__GNUC__)
+__attribute__((target("avx2")))
+static int find_resync_avx2(const unsigned char *buffer, int pos, int len)
+{
+    if (pos + int(TSPacket::kSize) >= len)
+        return -1;
+
+    const __m256i sync = _mm256_set1_epi8(SYNC_BYTE);
+    for (; pos + int(TSPacket::kSize) + 32 <= len; pos += 32)
+    {
+        __m256i cur  = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(buffer + pos));
+        __m256i next = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(buffer + pos + TSPacket::kSize));
+        int mask = _mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(cur, sync),
+                             _mm256_cmpeq_epi8(next, sync)));
+        if (mask)
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+
+    if (pos + int(TSPacket::kSize) >= len)
+        return -2;
+    return find_resync_sse2(buffer, pos, len);
+}
+#endif // HAVE_AVX2
+#endif // HAVE_SSE2 && ARCH_X86_64
+
+static TSSyncScanner::FindResyncFn select_find_resync(const char *&name)
+{
+#if (HAVE_SSE2 && ARCH_X86_64)
+    int flags = av_get_cpu_flags();
+#if HAVE_AVX2 && defined(__GNUC__)
+    if (flags & AV_CPU_FLAG_AVX2)
+    {
+        name = "avx2";
+        return find_resync_avx2;
+    }
+#endif
+    if (flags & AV_CPU_FLAG_SSE2)
+    {
+        name = "sse2";
+        return find_resync_sse2;
+    }
+#endif
+    name = "scalar";
+    return TSSyncScanner::FindResyncScalar;
+}
+
+const char *TSSyncScanner::s_kernelName = "scalar";
+TSSyncScanner::FindResyncFn TSSyncScanner::s_findResync =
+    select_find_resync(TSSyncScanner::s_kernelName);
@@ -230,6 +230,39 @@ class MTV_PUBLIC TSPacket : public TSHeader
     std::array<uint8_t,184> m_tsPayload {};
 };
 
+/** \class TSSyncScanner
+ *  \brief Locates and checks TS packet sync bytes in a block of raw data.
+ *
+ *  FindResync() tests a whole vector of candidate positions at a time,
+ *  comparing each byte and the byte one packet further on against the
+ *  sync byte. The SSE2 or AVX2 kernel is picked at startup from the CPU
+ *  flags, with a scalar loop for other CPUs and the block tails.
+ */
+class MTV_PUBLIC TSSyncScanner
+{
+  public:
+    /// Returns the number of whole packets at the start of the buffer
+    /// that begin with a sync byte.
+    static uint InSyncPackets(const unsigned char *buffer, uint len);
+
+    /// Returns the first offset at or after pos where two sync bytes
+    /// are one packet apart, -1 if there are not enough bytes to check
+    /// and -2 if there is no such offset. This matches the semantics of
+    /// MPEGStreamData::ResyncStream().
+    static int FindResync(const unsigned char *buffer, int pos, int len)
+        { return s_findResync(buffer, pos, len); }
+    static int FindResyncScalar(const unsigned char *buffer, int pos, int len);
+
+    /// Name of the FindResync() kernel in use.
+    static const char *KernelName(void) { return s_kernelName; }
+
+    using FindResyncFn = int (*)(const unsigned char *, int, int);
+
+  private:
+    static FindResyncFn  s_findResync;
+    static const char   *s_kernelName;
+};
+
 #if 0 /* not used yet */
 /** \class TSDVBEmissionPacket
  *  \brief Adds DVB forward error correction data to size of packet.
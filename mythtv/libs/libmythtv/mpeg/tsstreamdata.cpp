@@ -36,3 +36,25 @@ bool TSStreamData::ProcessTSPacket(const TSPacket& tspacket)
 
     return true;
 }
+
+/** \fn TSStreamData::ProcessTSPackets(const TSPacket*,uint)
+ *  \brief Write out a run of error free packets without any filtering.
+ */
+bool TSStreamData::ProcessTSPackets(const TSPacket *tspackets, uint count)
+{
+    if (VERBOSE_LEVEL_CHECK(VB_GENERAL, LOG_DEBUG))
+    {
+        for (uint i = 0; i < count; ++i)
+        {
+            if (IsEncryptionTestPID(tspackets[i].PID()))
+                LOG(VB_GENERAL, LOG_DEBUG, LOC + "ProcessTSPacket: Encrypted.");
+            if (tspackets[i].Scrambled())
+                LOG(VB_GENERAL, LOG_DEBUG, LOC + "ProcessTSPacket: Scrambled.");
+        }
+    }
+
+    for (auto & listener : m_tsWritingListeners)
+        listener->ProcessTSPackets(tspackets, count);
+
+    return true;
+}
@@ -15,6 +15,7 @@ class MTV_PUBLIC TSStreamData : public MPEGStreamData
     ~TSStreamData() override { ; }
 
     bool ProcessTSPacket(const TSPacket& tspacket) override; // MPEGStreamData
+    bool ProcessTSPackets(const TSPacket *tspackets, uint count) override; // MPEGStreamData
 
     using MPEGStreamData::Reset;
     void Reset(int /* desiredProgram */) override { ; } // MPEGStreamData
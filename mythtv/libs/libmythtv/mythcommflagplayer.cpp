@@ -222,6 +222,10 @@ bool MythCommFlagPlayer::RebuildSeekTable(bool ShowPercentage, StatusCallback Ca
  *   NOTE: You must call DiscardVideoFrame(VideoFrame*) on
  *         the frame returned, as this marks the frame as
  *         being used and hence unavailable for decoding.
+ *
+ *   Returns nullptr if there is no frame, or it has to be reduced and
+ *   either there is no memory to do so or it has more than 8 bits per
+ *   sample, which only the full size frame can be read as.
  */
 MythVideoFrame* MythCommFlagPlayer::GetRawVideoFrame(long long FrameNumber)
 {
@@ -249,6 +253,101 @@ MythVideoFrame* MythCommFlagPlayer::GetRawVideoFrame(long long FrameNumber)
     }
 
     m_videoOutput->StartDisplayingFrame();
-    return m_videoOutput->GetLastShownFrame();
+    MythVideoFrame* frame = m_videoOutput->GetLastShownFrame();
+
+    int scale = GetRawVideoScale();
+    if (!frame || (scale < 2))
+        return frame;
+
+    // The callers were set up for the reduced size
+    if (MythVideoFrame::ColorDepth(frame->m_type) != 8)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to reduce %1 frames")
+            .arg(MythVideoFrame::FormatDescription(frame->m_type)));
+        MythPlayer::DiscardVideoFrame(frame);
+        return nullptr;
+    }
+
+    // Average each scale x scale block of the luma plane into one pixel of
+    // a frame of our own and hand the decoded frame straight back. The
+    // chroma planes of the reduced frame are left grey.
+    int width  = frame->m_width / scale;
+    int height = frame->m_height / scale;
+    if ((m_scaledFrame.m_width != width) || (m_scaledFrame.m_height != height))
+    {
+        m_scaledFrame.Init(FMT_YV12, width, height);
+        if (m_scaledFrame.m_buffer)
+            m_scaledFrame.ClearBufferToBlank();
+    }
+
+    if (m_scaledFrame.m_buffer)
+    {
+        const uint8_t* src = frame->m_buffer + frame->m_offsets[0];
+        uint8_t* dst = m_scaledFrame.m_buffer + m_scaledFrame.m_offsets[0];
+        int srcpitch = frame->m_pitches[0];
+        int dstpitch = m_scaledFrame.m_pitches[0];
+        int round = (scale * scale) / 2;
+        for (int y = 0; y < height; ++y)
+        {
+            const uint8_t* row = src + (static_cast<ptrdiff_t>(y) * scale * srcpitch);
+            uint8_t* out = dst + (static_cast<ptrdiff_t>(y) * dstpitch);
+            for (int x = 0; x < width; ++x)
+            {
+                int sum = 0;
+                const uint8_t* block = row + (x * scale);
+                for (int j = 0; j < scale; ++j, block += srcpitch)
+                    for (int i = 0; i < scale; ++i)
+                        sum += block[i];
+                out[x] = static_cast<uint8_t>((sum + round) / (scale * scale));
+            }
+        }
+    }
+
+    m_scaledFrame.m_aspect        = frame->m_aspect;
+    m_scaledFrame.m_frameNumber   = frame->m_frameNumber;
+    m_scaledFrame.m_frameCounter  = frame->m_frameCounter;
+    m_scaledFrame.m_timecode      = frame->m_timecode;
+    m_scaledFrame.m_interlaced    = frame->m_interlaced;
+    m_scaledFrame.m_topFieldFirst = frame->m_topFieldFirst;
+    m_scaledFrame.m_repeatPic     = frame->m_repeatPic;
+    m_scaledFrame.m_dummy         = frame->m_dummy;
+    MythPlayer::DiscardVideoFrame(frame);
+    return m_scaledFrame.m_buffer ? &m_scaledFrame : nullptr;
+}
+
+void MythCommFlagPlayer::DiscardVideoFrame(MythVideoFrame* Frame)
+{
+    // The reduced frame is ours, its decoded frame has already been returned
+    if (Frame && (Frame != &m_scaledFrame))
+        MythPlayer::DiscardVideoFrame(Frame);
+}
+
+/*! \brief Returns the factor GetRawVideoFrame() reduces frames by.
+ *
+ *  Frames taller than the height set with SetMaxRawVideoHeight() are
+ *  reduced by the smallest whole factor that brings them within it. This
+ *  is in addition to any lowres decoding, which only some codecs support.
+ */
+int MythCommFlagPlayer::GetRawVideoScale(void) const
+{
+    int height = m_videoDim.height();
+    if ((m_maxRawHeight <= 0) || (height <= m_maxRawHeight))
+        return 1;
+    return (height + m_maxRawHeight - 1) / m_maxRawHeight;
+}
+
+/// The display size of the frames returned by GetRawVideoFrame()
+QSize MythCommFlagPlayer::GetRawVideoSize(void) const
+{
+    int scale = GetRawVideoScale();
+    return { m_videoDispDim.width() / scale, m_videoDispDim.height() / scale };
+}
+
+/// The buffer size of the frames returned by GetRawVideoFrame()
+QSize MythCommFlagPlayer::GetRawVideoBufferSize(void) const
+{
+    int scale = GetRawVideoScale();
+    return { m_videoDim.width() / scale, m_videoDim.height() / scale };
 }
 
@@ -28,6 +28,16 @@ class MTV_PUBLIC MythCommFlagPlayer : public MythPlayer
     explicit MythCommFlagPlayer(PlayerContext* Context, PlayerFlags Flags = kNoFlags);
     bool RebuildSeekTable(bool ShowPercentage = true, StatusCallback Callback = nullptr, void* Opaque = nullptr);
     MythVideoFrame* GetRawVideoFrame(long long FrameNumber = -1);
+    void  DiscardVideoFrame(MythVideoFrame* Frame) override;
+    void  SetMaxRawVideoHeight(int Height) { m_maxRawHeight = Height; }
+    QSize GetRawVideoSize(void) const;
+    QSize GetRawVideoBufferSize(void) const;
+
+  private:
+    int   GetRawVideoScale(void) const;
+
+    int            m_maxRawHeight { 0 };
+    MythVideoFrame m_scaledFrame;
 };
 
 #endif
@@ -182,7 +182,7 @@ class MTV_PUBLIC MythPlayer : public QObject
     void DeLimboFrame(MythVideoFrame *frame);
     virtual void ReleaseNextVideoFrame(MythVideoFrame *buffer, std::chrono::milliseconds timecode,
                                        bool wrap = true);
-    void DiscardVideoFrame(MythVideoFrame *buffer);
+    virtual void DiscardVideoFrame(MythVideoFrame *buffer);
     void DiscardVideoFrames(bool KeyFrame, bool Flushed);
     /// Returns the stream decoder currently in use.
     DecoderBase *GetDecoder(void) { return m_decoder; }
@@ -35,15 +35,17 @@ static QVariant denullify(const QDateTime &dt)
     return dt.isNull() ? QVariant("0000-00-00 00:00:00") : QVariant(dt);
 }
 
-static void add_genres(MSqlQuery &query, const QStringList &genres,
+static bool add_genres(MSqlQuery &query, const QStringList &genres,
                 uint chanid, const QDateTime &starttime)
 {
+    bool ok = true;
     QString relevance = QString("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ");
     for (auto it = genres.constBegin(); (it != genres.constEnd()) &&
              ((it - genres.constBegin()) < relevance.size()); ++it)
     {
+        // A program that is updated keeps the genres it already has
         query.prepare(
-           "INSERT INTO programgenres "
+           "INSERT IGNORE INTO programgenres "
            "       ( chanid,  starttime, genre,  relevance) "
            "VALUES (:CHANID, :START,    :genre, :relevance)");
         query.bindValue(":CHANID",    chanid);
@@ -52,8 +54,180 @@ static void add_genres(MSqlQuery &query, const QStringList &genres,
         query.bindValue(":relevance", relevance.at(it - genres.constBegin()));
 
         if (!query.exec())
+        {
             MythDB::DBError("programgenres insert", query);
+            ok = false;
+        }
     }
+    return ok;
+}
+
+/// Columns written by ProgInfo::InsertDB(), in kProgramPlaceholders order
+static const QString kProgramColumns =
+    "chanid,         title,          subtitle,        description, "
+    "category,       category_type,  "
+    "starttime,      endtime, "
+    "closecaptioned, stereo,         hdtv,            subtitled, "
+    "subtitletypes,  audioprop,      videoprop, "
+    "partnumber,     parttotal, "
+    "syndicatedepisodenumber, "
+    "airdate,        originalairdate,listingsource, "
+    "seriesid,       programid,      previouslyshown, "
+    "stars,          showtype,       title_pronounce, colorcode, "
+    "season,         episode,        totalepisodes, "
+    "inetref";
+
+static constexpr std::array<const char *,32> kProgramPlaceholders
+{
+    ":CHANID",      ":TITLE",       ":SUBTITLE",     ":DESCRIPTION",
+    ":CATEGORY",    ":CATTYPE",
+    ":STARTTIME",   ":ENDTIME",
+    ":CC",          ":STEREO",      ":HDTV",         ":HASSUBTITLES",
+    ":SUBTYPES",    ":AUDIOPROP",   ":VIDEOPROP",
+    ":PARTNUMBER",  ":PARTTOTAL",
+    ":SYNDICATENO",
+    ":AIRDATE",     ":ORIGAIRDATE", ":LSOURCE",
+    ":SERIESID",    ":PROGRAMID",   ":PREVSHOWN",
+    ":STARS",       ":SHOWTYPE",    ":TITLEPRON",    ":COLORCODE",
+    ":SEASON",      ":EPISODE",     ":TOTALEPISODES",
+    ":INETREF",
+};
+
+/// Columns written by DBEvent::InsertDB(), in kEventPlaceholders order
+static const QString kEventColumns =
+    "chanid,         title,          subtitle,        description, "
+    "category,       category_type, "
+    "starttime,      endtime, "
+    "closecaptioned, stereo,         hdtv,            subtitled, "
+    "subtitletypes,  audioprop,      videoprop, "
+    "stars,          partnumber,     parttotal, "
+    "syndicatedepisodenumber, "
+    "airdate,        originalairdate,listingsource, "
+    "seriesid,       programid,      previouslyshown, "
+    "season,         episode,        totalepisodes, "
+    "inetref";
+
+static constexpr std::array<const char *,29> kEventPlaceholders
+{
+    ":CHANID",      ":TITLE",       ":SUBTITLE",     ":DESCRIPTION",
+    ":CATEGORY",    ":CATTYPE",
+    ":STARTTIME",   ":ENDTIME",
+    ":CC",          ":STEREO",      ":HDTV",         ":HASSUBTITLES",
+    ":SUBTYPES",    ":AUDIOPROP",   ":VIDEOPROP",
+    ":STARS",       ":PARTNUMBER",  ":PARTTOTAL",
+    ":SYNDICATENO",
+    ":AIRDATE",     ":ORIGAIRDATE", ":LSOURCE",
+    ":SERIESID",    ":PROGRAMID",   ":PREVSHOWN",
+    ":SEASON",      ":EPISODE",     ":TOTALEPISODES",
+    ":INETREF",
+};
+
+/// Maximum number of rows in one bulk DELETE or REPLACE
+static constexpr int kBulkRows { 256 };
+
+/// Returns the VALUES tuple for one row, with \p suffix appended
+/// to each placeholder so several rows can share a query.
+template <size_t N>
+static QString row_values(const std::array<const char *,N> &placeholders,
+                          const QString &suffix)
+{
+    QStringList values;
+    for (const auto *placeholder : placeholders)
+        values << (placeholder + suffix);
+    return "(" + values.join(",") + ")";
+}
+
+static QString program_values(const QString &suffix)
+{
+    return row_values(kProgramPlaceholders, suffix);
+}
+
+static QString event_values(const QString &suffix)
+{
+    return row_values(kEventPlaceholders, suffix);
+}
+
+static void bind_event_values(MSqlQuery &query, const QString &suffix,
+                              uint chanid, const DBEvent &event)
+{
+    const std::array<QVariant,kEventPlaceholders.size()> values
+    {
+        chanid,
+        denullify(event.m_title),
+        denullify(event.m_subtitle),
+        denullify(event.m_description),
+        denullify(event.m_category),
+        myth_category_type_to_string(event.m_categoryType),
+        event.m_starttime,
+        event.m_endtime,
+        (event.m_subtitleType & SUB_HARDHEAR) != 0,
+        (event.m_audioProps   & AUD_STEREO) != 0,
+        (event.m_videoProps   & VID_HDTV) != 0,
+        (event.m_subtitleType & SUB_NORMAL) != 0,
+        event.m_subtitleType,
+        event.m_audioProps,
+        event.m_videoProps,
+        event.m_stars,
+        event.m_partnumber,
+        event.m_parttotal,
+        denullify(event.m_syndicatedepisodenumber),
+        event.m_airdate ? QString::number(event.m_airdate) : "0000",
+        event.m_originalairdate,
+        event.m_listingsource,
+        denullify(event.m_seriesId),
+        denullify(event.m_programId),
+        event.m_previouslyshown,
+        event.m_season,
+        event.m_episode,
+        event.m_totalepisodes,
+        event.m_inetref,
+    };
+
+    for (size_t i = 0; i < values.size(); ++i)
+        query.bindValue(kEventPlaceholders[i] + suffix, values[i]);
+}
+
+static void bind_program_values(MSqlQuery &query, const QString &suffix,
+                                uint chanid, const ProgInfo &pi)
+{
+    const std::array<QVariant,kProgramPlaceholders.size()> values
+    {
+        chanid,
+        denullify(pi.m_title),
+        denullify(pi.m_subtitle),
+        denullify(pi.m_description),
+        denullify(pi.m_category),
+        myth_category_type_to_string(pi.m_categoryType),
+        pi.m_starttime,
+        denullify(pi.m_endtime),
+        (pi.m_subtitleType & SUB_HARDHEAR) != 0,
+        (pi.m_audioProps   & AUD_STEREO) != 0,
+        (pi.m_videoProps   & VID_HDTV) != 0,
+        (pi.m_subtitleType & SUB_NORMAL) != 0,
+        pi.m_subtitleType,
+        pi.m_audioProps,
+        pi.m_videoProps,
+        pi.m_partnumber,
+        pi.m_parttotal,
+        denullify(pi.m_syndicatedepisodenumber),
+        pi.m_airdate ? QString::number(pi.m_airdate) : "0000",
+        pi.m_originalairdate,
+        pi.m_listingsource,
+        denullify(pi.m_seriesId),
+        denullify(pi.m_programId),
+        pi.m_previouslyshown,
+        pi.m_stars,
+        pi.m_showtype,
+        pi.m_title_pronounce,
+        pi.m_colorcode,
+        pi.m_season,
+        pi.m_episode,
+        pi.m_totalepisodes,
+        pi.m_inetref,
+    };
+
+    for (size_t i = 0; i < values.size(); ++i)
+        query.bindValue(kProgramPlaceholders[i] + suffix, values[i]);
 }
 
 DBPerson::DBPerson(const DBPerson &other)
@@ -701,6 +875,7 @@ uint DBEvent::UpdateDB(
 // when the starttime of a program is changed.
 //
 // Return the number of rows affected:
+// -1   if the update failed
 // 0    if program is not found in table record
 // 1    if program is found and updated
 //
@@ -728,6 +903,7 @@ static int change_record(MSqlQuery &query, uint chanid,
     if (!query.exec() || !query.isActive())
     {
         MythDB::DBError("Updating record", query);
+        return -1;
     }
     else
     {
@@ -745,102 +921,114 @@ static int change_record(MSqlQuery &query, uint chanid,
     return rows;
 }
 
-// Update matched item with current data.
-//
-uint DBEvent::UpdateDB(
-    MSqlQuery &query, uint chanid, const DBEvent &match)  const
+/// \brief Fills \p row with \p match updated with the data of \p event.
+///
+/// Empty fields of \p event keep the value of \p match, which also
+/// keeps its star rating.
+static void merge_event(const DBEvent &event, const DBEvent &match,
+                        DBEvent &row)
 {
-    QString  ltitle           = m_title;
-    QString  lsubtitle        = m_subtitle;
-    QString  ldesc            = m_description;
-    QString  lcategory        = m_category;
-    uint16_t lairdate         = m_airdate;
-    QString  lprogramId       = m_programId;
-    QString  lseriesId        = m_seriesId;
-    QString  linetref         = m_inetref;
-    QDate    loriginalairdate = m_originalairdate;
-
-    // Update starttime also in database table record so that
-    // tables program and record remain consistent.
-    if (m_starttime != match.m_starttime)
-    {
-        QDateTime const &old_starttime = match.m_starttime;
-        QDateTime const &new_starttime = m_starttime;
-        change_record(query, chanid, old_starttime, new_starttime);
-
-        LOG(VB_EIT, LOG_DEBUG,
-            QString("EIT: (U) change starttime from %1 to %2 for chanid:%3 program '%4' ")
-                    .arg(old_starttime.toString(Qt::ISODate),
-                         new_starttime.toString(Qt::ISODate),
-                         QString::number(chanid),
-                         m_title.left(35)));
-    }
+    row.m_title            = event.m_title;
+    row.m_subtitle         = event.m_subtitle;
+    row.m_description      = event.m_description;
+    row.m_category         = event.m_category;
+    row.m_starttime        = event.m_starttime;
+    row.m_endtime          = event.m_endtime;
+    row.m_airdate          = event.m_airdate;
+    row.m_programId        = event.m_programId;
+    row.m_seriesId         = event.m_seriesId;
+    row.m_inetref          = event.m_inetref;
+    row.m_originalairdate  = event.m_originalairdate;
+    row.m_stars            = match.m_stars;
 
-    if (ltitle.isEmpty() && !match.m_title.isEmpty())
-        ltitle = match.m_title;
+    if (row.m_title.isEmpty() && !match.m_title.isEmpty())
+        row.m_title = match.m_title;
 
-    if (lsubtitle.isEmpty() && !match.m_subtitle.isEmpty())
-        lsubtitle = match.m_subtitle;
+    if (row.m_subtitle.isEmpty() && !match.m_subtitle.isEmpty())
+        row.m_subtitle = match.m_subtitle;
 
-    if (ldesc.isEmpty() && !match.m_description.isEmpty())
-        ldesc = match.m_description;
+    if (row.m_description.isEmpty() && !match.m_description.isEmpty())
+        row.m_description = match.m_description;
 
-    if (lcategory.isEmpty() && !match.m_category.isEmpty())
-        lcategory = match.m_category;
+    if (row.m_category.isEmpty() && !match.m_category.isEmpty())
+        row.m_category = match.m_category;
 
-    if (!lairdate && match.m_airdate)
-        lairdate = match.m_airdate;
+    if (!row.m_airdate && match.m_airdate)
+        row.m_airdate = match.m_airdate;
 
-    if (!loriginalairdate.isValid() && match.m_originalairdate.isValid())
-        loriginalairdate = match.m_originalairdate;
+    if (!row.m_originalairdate.isValid() && match.m_originalairdate.isValid())
+        row.m_originalairdate = match.m_originalairdate;
 
-    if (lprogramId.isEmpty() && !match.m_programId.isEmpty())
-        lprogramId = match.m_programId;
+    if (row.m_programId.isEmpty() && !match.m_programId.isEmpty())
+        row.m_programId = match.m_programId;
 
-    if (lseriesId.isEmpty() && !match.m_seriesId.isEmpty())
-        lseriesId = match.m_seriesId;
+    if (row.m_seriesId.isEmpty() && !match.m_seriesId.isEmpty())
+        row.m_seriesId = match.m_seriesId;
 
-    if (linetref.isEmpty() && !match.m_inetref.isEmpty())
-        linetref= match.m_inetref;
+    if (row.m_inetref.isEmpty() && !match.m_inetref.isEmpty())
+        row.m_inetref = match.m_inetref;
 
-    ProgramInfo::CategoryType tmp = m_categoryType;
-    if (!m_categoryType && match.m_categoryType)
-        tmp = match.m_categoryType;
+    row.m_categoryType = event.m_categoryType;
+    if (!event.m_categoryType && match.m_categoryType)
+        row.m_categoryType = match.m_categoryType;
 
-    QString lcattype = myth_category_type_to_string(tmp);
+    row.m_subtitleType = event.m_subtitleType | match.m_subtitleType;
+    row.m_audioProps   = event.m_audioProps   | match.m_audioProps;
+    row.m_videoProps   = event.m_videoProps   | match.m_videoProps;
 
-    unsigned char lsubtype = m_subtitleType | match.m_subtitleType;
-    unsigned char laudio   = m_audioProps   | match.m_audioProps;
-    unsigned char lvideo   = m_videoProps   | match.m_videoProps;
+    row.m_season        = match.m_season;
+    row.m_episode       = match.m_episode;
+    row.m_totalepisodes = match.m_totalepisodes;
 
-    uint lseason = match.m_season;
-    uint lepisode = match.m_episode;
-    uint lepisodeTotal = match.m_totalepisodes;
-
-    if (m_season || m_episode || m_totalepisodes)
+    if (event.m_season || event.m_episode || event.m_totalepisodes)
     {
-        lseason = m_season;
-        lepisode = m_episode;
-        lepisodeTotal = m_totalepisodes;
+        row.m_season        = event.m_season;
+        row.m_episode       = event.m_episode;
+        row.m_totalepisodes = event.m_totalepisodes;
     }
 
-    uint lpartnumber = match.m_partnumber;
-    uint lparttotal = match.m_parttotal;
+    row.m_partnumber = match.m_partnumber;
+    row.m_parttotal  = match.m_parttotal;
 
-    if (m_partnumber || m_parttotal)
+    if (event.m_partnumber || event.m_parttotal)
     {
-        lpartnumber = m_partnumber;
-        lparttotal  = m_parttotal;
+        row.m_partnumber = event.m_partnumber;
+        row.m_parttotal  = event.m_parttotal;
     }
 
-    bool lpreviouslyshown = m_previouslyshown || match.m_previouslyshown;
+    row.m_previouslyshown = event.m_previouslyshown || match.m_previouslyshown;
 
-    uint32_t llistingsource = m_listingsource | match.m_listingsource;
+    row.m_listingsource = event.m_listingsource | match.m_listingsource;
 
-    QString lsyndicatedepisodenumber = m_syndicatedepisodenumber;
-    if (lsyndicatedepisodenumber.isEmpty() &&
+    row.m_syndicatedepisodenumber = event.m_syndicatedepisodenumber;
+    if (row.m_syndicatedepisodenumber.isEmpty() &&
         !match.m_syndicatedepisodenumber.isEmpty())
-        lsyndicatedepisodenumber = match.m_syndicatedepisodenumber;
+        row.m_syndicatedepisodenumber = match.m_syndicatedepisodenumber;
+}
+
+// Update matched item with current data.
+//
+uint DBEvent::UpdateDB(
+    MSqlQuery &query, uint chanid, const DBEvent &match)  const
+{
+    // Update starttime also in database table record so that
+    // tables program and record remain consistent.
+    if (m_starttime != match.m_starttime)
+    {
+        QDateTime const &old_starttime = match.m_starttime;
+        QDateTime const &new_starttime = m_starttime;
+        change_record(query, chanid, old_starttime, new_starttime);
+
+        LOG(VB_EIT, LOG_DEBUG,
+            QString("EIT: (U) change starttime from %1 to %2 for chanid:%3 program '%4' ")
+                    .arg(old_starttime.toString(Qt::ISODate),
+                         new_starttime.toString(Qt::ISODate),
+                         QString::number(chanid),
+                         m_title.left(35)));
+    }
+
+    DBEvent row(m_listingsource);
+    merge_event(*this, match, row);
 
     query.prepare(
         "UPDATE program "
@@ -865,33 +1053,33 @@ uint DBEvent::UpdateDB(
 
     query.bindValue(":CHANID",      chanid);
     query.bindValue(":OLDSTART",    match.m_starttime);
-    query.bindValue(":TITLE",       denullify(ltitle));
-    query.bindValue(":SUBTITLE",    denullify(lsubtitle));
-    query.bindValue(":DESC",        denullify(ldesc));
-    query.bindValue(":CATEGORY",    denullify(lcategory));
-    query.bindValue(":CATTYPE",     lcattype);
-    query.bindValue(":STARTTIME",   m_starttime);
-    query.bindValue(":ENDTIME",     m_endtime);
-    query.bindValue(":CC",          (lsubtype & SUB_HARDHEAR) != 0);
-    query.bindValue(":HASSUBTITLES",(lsubtype & SUB_NORMAL) != 0);
-    query.bindValue(":STEREO",      (laudio   & AUD_STEREO) != 0);
-    query.bindValue(":HDTV",        (lvideo   & VID_HDTV) != 0);
-    query.bindValue(":SUBTYPE",     lsubtype);
-    query.bindValue(":AUDIOPROP",   laudio);
-    query.bindValue(":VIDEOPROP",   lvideo);
-    query.bindValue(":SEASON",      lseason);
-    query.bindValue(":EPISODE",     lepisode);
-    query.bindValue(":TOTALEPS",    lepisodeTotal);
-    query.bindValue(":PARTNO",      lpartnumber);
-    query.bindValue(":PARTTOTAL",   lparttotal);
-    query.bindValue(":SYNDICATENO", denullify(lsyndicatedepisodenumber));
-    query.bindValue(":AIRDATE",     lairdate ? QString::number(lairdate) : "0000");
-    query.bindValue(":ORIGAIRDATE", loriginalairdate);
-    query.bindValue(":LSOURCE",     llistingsource);
-    query.bindValue(":SERIESID",    denullify(lseriesId));
-    query.bindValue(":PROGRAMID",   denullify(lprogramId));
-    query.bindValue(":PREVSHOWN",   lpreviouslyshown);
-    query.bindValue(":INETREF",     linetref);
+    query.bindValue(":TITLE",       denullify(row.m_title));
+    query.bindValue(":SUBTITLE",    denullify(row.m_subtitle));
+    query.bindValue(":DESC",        denullify(row.m_description));
+    query.bindValue(":CATEGORY",    denullify(row.m_category));
+    query.bindValue(":CATTYPE",     myth_category_type_to_string(row.m_categoryType));
+    query.bindValue(":STARTTIME",   row.m_starttime);
+    query.bindValue(":ENDTIME",     row.m_endtime);
+    query.bindValue(":CC",          (row.m_subtitleType & SUB_HARDHEAR) != 0);
+    query.bindValue(":HASSUBTITLES",(row.m_subtitleType & SUB_NORMAL) != 0);
+    query.bindValue(":STEREO",      (row.m_audioProps   & AUD_STEREO) != 0);
+    query.bindValue(":HDTV",        (row.m_videoProps   & VID_HDTV) != 0);
+    query.bindValue(":SUBTYPE",     row.m_subtitleType);
+    query.bindValue(":AUDIOPROP",   row.m_audioProps);
+    query.bindValue(":VIDEOPROP",   row.m_videoProps);
+    query.bindValue(":SEASON",      row.m_season);
+    query.bindValue(":EPISODE",     row.m_episode);
+    query.bindValue(":TOTALEPS",    row.m_totalepisodes);
+    query.bindValue(":PARTNO",      row.m_partnumber);
+    query.bindValue(":PARTTOTAL",   row.m_parttotal);
+    query.bindValue(":SYNDICATENO", denullify(row.m_syndicatedepisodenumber));
+    query.bindValue(":AIRDATE",     row.m_airdate ? QString::number(row.m_airdate) : "0000");
+    query.bindValue(":ORIGAIRDATE", row.m_originalairdate);
+    query.bindValue(":LSOURCE",     row.m_listingsource);
+    query.bindValue(":SERIESID",    denullify(row.m_seriesId));
+    query.bindValue(":PROGRAMID",   denullify(row.m_programId));
+    query.bindValue(":PREVSHOWN",   row.m_previouslyshown);
+    query.bindValue(":INETREF",     row.m_inetref);
 
     if (!query.exec())
     {
@@ -1236,6 +1424,617 @@ uint DBEvent::InsertDB(MSqlQuery &query, uint chanid,
     return 1;
 }
 
+/// A program row of the channel handled by DBEventEIT::UpdateDBBulk()
+struct EITWindowRow
+{
+    DBEvent   m_event {kListingSourceEIT}; ///< current contents, no credits
+    QDateTime m_dbStart;         ///< starttime in the database, null if new
+    bool      m_deleted {false};
+    bool      m_changed {false};
+    /// Events whose ratings, credits and genres belong to this row
+    std::vector<const DBEventEIT*> m_details;
+};
+
+/// A starttime change, or a deletion if m_to is null, that the per event
+/// path would have applied to the program row, the record table and the
+/// program details.
+struct EITStartChange
+{
+    QDateTime m_from;
+    QDateTime m_to;
+    bool      m_record  {false}; ///< update the record table
+    bool      m_details {false}; ///< move or delete credits, ratings, genres
+    bool      m_program {false}; ///< move the row in the program table
+};
+
+/// Copies \p src to \p dst except for the credits, which the program
+/// rows in EITWindowRow never have.
+static void assign_without_credits(DBEvent &dst, const DBEvent &src)
+{
+    dst = src;
+    delete dst.m_credits;
+    dst.m_credits = nullptr;
+}
+
+/// Loads the program rows of \p chanid touching [from, to].
+static bool load_window(MSqlQuery &query, uint chanid,
+                        const QDateTime &from, const QDateTime &to,
+                        std::vector<EITWindowRow> &rows)
+{
+    query.prepare(
+        "SELECT title,          subtitle,      description, "
+        "       category,       category_type, "
+        "       starttime,      endtime, "
+        "       subtitletypes+0,audioprop+0,   videoprop+0, "
+        "       seriesid,       programid, "
+        "       partnumber,     parttotal, "
+        "       syndicatedepisodenumber, "
+        "       airdate,        originalairdate, "
+        "       previouslyshown,listingsource, "
+        "       stars+0, "
+        "       season,         episode,       totalepisodes, "
+        "       inetref "
+        "FROM program "
+        "WHERE chanid    =  :CHANID AND "
+        "      manualid  =  0       AND "
+        "      starttime <= :TO     AND "
+        "      endtime   >= :FROM "
+        "ORDER BY starttime");
+    query.bindValue(":CHANID", chanid);
+    query.bindValue(":FROM",   from);
+    query.bindValue(":TO",     to);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("DBEventEIT::load_window", query);
+        return false;
+    }
+
+    while (query.next())
+    {
+        rows.emplace_back();
+        EITWindowRow &row = rows.back();
+        DBEvent &prog = row.m_event;
+
+        prog.m_title         = query.value(0).toString();
+        prog.m_subtitle      = query.value(1).toString();
+        prog.m_description   = query.value(2).toString();
+        prog.m_category      = query.value(3).toString();
+        prog.m_categoryType  =
+            string_to_myth_category_type(query.value(4).toString());
+        prog.m_starttime     = MythDate::as_utc(query.value(5).toDateTime());
+        prog.m_endtime       = MythDate::as_utc(query.value(6).toDateTime());
+        prog.m_subtitleType  = query.value(7).toUInt();
+        prog.m_audioProps    = query.value(8).toUInt();
+        prog.m_videoProps    = query.value(9).toUInt();
+        prog.m_seriesId      = query.value(10).toString();
+        prog.m_programId     = query.value(11).toString();
+        prog.m_partnumber    = query.value(12).toUInt();
+        prog.m_parttotal     = query.value(13).toUInt();
+        prog.m_syndicatedepisodenumber = query.value(14).toString();
+        prog.m_airdate       = query.value(15).toUInt();
+        prog.m_originalairdate = query.value(16).toDate();
+        prog.m_previouslyshown = query.value(17).toBool();
+        prog.m_listingsource = query.value(18).toUInt();
+        prog.m_stars         = query.value(19).toDouble();
+        prog.m_season        = query.value(20).toUInt();
+        prog.m_episode       = query.value(21).toUInt();
+        prog.m_totalepisodes = query.value(22).toUInt();
+        prog.m_inetref       = query.value(23).toString();
+
+        row.m_dbStart = prog.m_starttime;
+    }
+
+    return true;
+}
+
+/// Applies \p changes in order, deleting consecutive deletions with one
+/// statement per table.  Moved program rows are updated in place, so the
+/// columns that the EIT does not have are kept.
+static bool apply_start_changes(MSqlQuery &query, uint chanid,
+                                const std::vector<EITStartChange> &changes)
+{
+    static const std::array<const char *,3> kTables
+        { "credits", "programrating", "programgenres" };
+
+    size_t i = 0;
+    while (i < changes.size())
+    {
+        const EITStartChange &change = changes[i];
+        if (!change.m_to.isNull())
+        {
+            if (change.m_record &&
+                change_record(query, chanid, change.m_from, change.m_to) < 0)
+                return false;
+            if (change.m_program)
+            {
+                query.prepare("UPDATE program "
+                              "SET starttime = :NEWSTART "
+                              "WHERE chanid    = :CHANID AND "
+                              "      manualid  = 0       AND "
+                              "      starttime = :OLDSTART");
+                query.bindValue(":CHANID",   chanid);
+                query.bindValue(":OLDSTART", change.m_from);
+                query.bindValue(":NEWSTART", change.m_to);
+                if (!query.exec())
+                {
+                    MythDB::DBError("DBEventEIT::UpdateDBBulk move", query);
+                    return false;
+                }
+            }
+            for (size_t t = 0; change.m_details && t < kTables.size(); ++t)
+            {
+                query.prepare(QString("UPDATE %1 "
+                                      "SET starttime = :NEWSTART "
+                                      "WHERE chanid    = :CHANID AND "
+                                      "      starttime = :OLDSTART")
+                              .arg(kTables[t]));
+                query.bindValue(":CHANID",   chanid);
+                query.bindValue(":OLDSTART", change.m_from);
+                query.bindValue(":NEWSTART", change.m_to);
+                if (!query.exec())
+                {
+                    MythDB::DBError("DBEventEIT::UpdateDBBulk move", query);
+                    return false;
+                }
+            }
+            ++i;
+            continue;
+        }
+
+        QList<QDateTime> deletes;
+        while (i < changes.size() && changes[i].m_to.isNull() &&
+               deletes.size() < kBulkRows)
+        {
+            deletes.push_back(changes[i].m_from);
+            ++i;
+        }
+
+        QStringList placeholders;
+        for (int j = 0; j < deletes.size(); ++j)
+            placeholders << QString(":START%1").arg(j);
+
+        query.prepare(QString("DELETE FROM program "
+                              "WHERE chanid = :CHANID AND "
+                              "      manualid = 0 AND "
+                              "      starttime IN (%1)")
+                      .arg(placeholders.join(",")));
+        query.bindValue(":CHANID", chanid);
+        for (int j = 0; j < deletes.size(); ++j)
+            query.bindValue(placeholders[j], deletes[j]);
+        if (!query.exec())
+        {
+            MythDB::DBError("DBEventEIT::UpdateDBBulk delete", query);
+            return false;
+        }
+
+        for (const auto *table : kTables)
+        {
+            query.prepare(QString("DELETE FROM %1 "
+                                  "WHERE chanid = :CHANID AND "
+                                  "      starttime IN (%2)")
+                          .arg(table, placeholders.join(",")));
+            query.bindValue(":CHANID", chanid);
+            for (int j = 0; j < deletes.size(); ++j)
+                query.bindValue(placeholders[j], deletes[j]);
+            if (!query.exec())
+            {
+                MythDB::DBError("DBEventEIT::UpdateDBBulk delete", query);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ *  \brief Bulk version of DBEvent::UpdateDB() for the events of one channel.
+ *
+ *  Rather than querying the database for the programs overlapping each
+ *  event, the channel's programs in the time span of all the events are
+ *  loaded in one query. The events are then matched against these rows
+ *  in memory, in queue order and with the same rules as the per event
+ *  path, after which the program rows that changed are written: deleted
+ *  and moved rows in the order the per event path would have, the others
+ *  with multi-row REPLACE and INSERT statements.
+ *
+ *  The program tables are MyISAM, so a failed write leaves the earlier
+ *  ones in place. Every write can be repeated, so the events are then
+ *  matched once more against the rows as they are now and the remaining
+ *  changes are written.
+ *
+ *  \param count Set to the number of events inserted or updated.
+ *  \return false if the events could not be written in bulk before
+ *          anything was written, in which case the caller should fall
+ *          back to DBEventEIT::UpdateDB(). If the second attempt fails
+ *          too an error is logged and true is returned, so the events
+ *          are not written a third time.
+ */
+bool DBEventEIT::UpdateDBBulk(MSqlQuery                      &query,
+                              uint                            chanid,
+                              const std::vector<DBEventEIT*> &events,
+                              int                             match_threshold,
+                              uint                           &count)
+{
+    bool written = false;
+    if (ReconcileDBBulk(query, chanid, events, match_threshold, count,
+                        written))
+        return true;
+    if (!written)
+        return false;
+
+    LOG(VB_EIT, LOG_WARNING,
+        QString("EIT: Bulk update of chanid %1 failed part way, "
+                "matching the events again").arg(chanid));
+
+    written = false;
+    if (ReconcileDBBulk(query, chanid, events, match_threshold, count,
+                        written))
+        return true;
+    if (!written)
+        return false;
+
+    // Left for the next time the events are sent, rather than writing
+    // them a third time on top of what is there now
+    LOG(VB_GENERAL, LOG_ERR,
+        QString("EIT: Bulk update of chanid %1 failed twice, "
+                "dropping %2 events").arg(chanid).arg(events.size()));
+    return true;
+}
+
+/// Matches \p events against the program rows and writes the changes
+/// for DBEventEIT::UpdateDBBulk(). \p written is set once the first
+/// write is attempted.
+bool DBEventEIT::ReconcileDBBulk(MSqlQuery                      &query,
+                                 uint                            chanid,
+                                 const std::vector<DBEventEIT*> &events,
+                                 int                             match_threshold,
+                                 uint                           &count,
+                                 bool                           &written)
+{
+    count = 0;
+
+    // Do not insert or update programs that are in the past
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    QDateTime from;
+    QDateTime to;
+    for (const auto *event : events)
+    {
+        if (event->m_endtime < now)
+            continue;
+        if (from.isNull() || event->m_starttime < from)
+            from = event->m_starttime;
+        if (to.isNull() || event->m_endtime > to)
+            to = event->m_endtime;
+    }
+    if (from.isNull())
+        return true;
+
+    std::vector<EITWindowRow> rows;
+    if (!load_window(query, chanid, from, to, rows))
+        return false;
+
+    std::vector<EITStartChange> changes;
+
+    auto delete_row = [&changes](EITWindowRow &row)
+    {
+        if (!row.m_dbStart.isNull())
+        {
+            changes.push_back({row.m_event.m_starttime, QDateTime(),
+                               false, true, true});
+        }
+        row.m_deleted = true;
+    };
+
+    auto find_start = [&rows](const QDateTime &start)
+    {
+        return std::find_if(rows.begin(), rows.end(),
+                            [&start](const EITWindowRow &row)
+                            { return !row.m_deleted &&
+                                     row.m_event.m_starttime == start; });
+    };
+
+    for (const auto *event : events)
+    {
+        LOG(VB_EIT, LOG_DEBUG,
+            QString("EIT: new program: %1 %2 '%3' chanid %4")
+                    .arg(event->m_starttime.toString(Qt::ISODate),
+                         event->m_endtime.toString(Qt::ISODate),
+                         event->m_title.left(35),
+                         QString::number(chanid)));
+
+        if (event->m_endtime < now)
+        {
+            LOG(VB_EIT, LOG_DEBUG,
+                QString("EIT: skip '%1' endtime is in the past")
+                        .arg(event->m_title.left(35)));
+            continue;
+        }
+
+        // Same conditions as GetOverlappingPrograms(), in starttime order
+        std::vector<size_t> overlaps;
+        for (size_t j = 0; j < rows.size(); ++j)
+        {
+            const DBEvent &prog = rows[j].m_event;
+            if (rows[j].m_deleted)
+                continue;
+            if ((prog.m_starttime >= event->m_starttime &&
+                 prog.m_starttime <  event->m_endtime) ||
+                (prog.m_endtime   >  event->m_starttime &&
+                 prog.m_endtime   <= event->m_endtime) ||
+                (prog.m_starttime <  event->m_starttime &&
+                 prog.m_endtime   >  event->m_endtime))
+            {
+                overlaps.push_back(j);
+            }
+        }
+        std::sort(overlaps.begin(), overlaps.end(),
+                  [&rows](size_t a, size_t b)
+                  { return rows[a].m_event.m_starttime <
+                           rows[b].m_event.m_starttime; });
+
+        int match = -1;
+        if (!overlaps.empty())
+        {
+            std::vector<DBEvent> programs;
+            programs.reserve(overlaps.size());
+            for (size_t j : overlaps)
+                programs.push_back(rows[j].m_event);
+
+            int i = -1;
+            int score = event->GetMatch(programs, i);
+            if (score >= match_threshold)
+            {
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT: accept match[%1]: %2 '%3' vs. '%4'")
+                        .arg(i).arg(score)
+                        .arg(event->m_title.left(35),
+                             programs[i].m_title.left(35)));
+                match = i;
+            }
+            else if (i >= 0)
+            {
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT: reject match[%1]: %2 '%3' vs. '%4'")
+                        .arg(i).arg(score)
+                        .arg(event->m_title.left(35),
+                             programs[i].m_title.left(35)));
+            }
+        }
+
+        // Same as MoveOutOfTheWayDB() for everything but the match
+        for (size_t k = 0; k < overlaps.size(); ++k)
+        {
+            if (static_cast<int>(k) == match)
+                continue;
+
+            EITWindowRow &row = rows[overlaps[k]];
+            DBEvent &prog = row.m_event;
+            if (prog.m_starttime >= event->m_starttime &&
+                prog.m_endtime <= event->m_endtime)
+            {
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT: delete '%1' %2 - %3")
+                            .arg(prog.m_title.left(35),
+                                 prog.m_starttime.toString(Qt::ISODate),
+                                 prog.m_endtime.toString(Qt::ISODate)));
+                delete_row(row);
+            }
+            else if (prog.m_starttime < event->m_starttime &&
+                     prog.m_endtime > event->m_starttime)
+            {
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT: change '%1' endtime to %2")
+                            .arg(prog.m_title.left(35),
+                                 event->m_starttime.toString(Qt::ISODate)));
+                prog.m_endtime = event->m_starttime;
+                row.m_changed = true;
+            }
+            else if (prog.m_starttime < event->m_endtime &&
+                     prog.m_endtime > event->m_endtime)
+            {
+                if (find_start(event->m_endtime) != rows.end())
+                {
+                    LOG(VB_EIT, LOG_DEBUG,
+                        QString("EIT: delete '%1' %2 - %3")
+                                .arg(prog.m_title.left(35),
+                                     prog.m_starttime.toString(Qt::ISODate),
+                                     prog.m_endtime.toString(Qt::ISODate)));
+                    delete_row(row);
+                    continue;
+                }
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT: (M) change starttime from %1 to %2 for chanid:%3 program '%4' ")
+                            .arg(prog.m_starttime.toString(Qt::ISODate),
+                                 event->m_endtime.toString(Qt::ISODate),
+                                 QString::number(chanid),
+                                 prog.m_title.left(35)));
+                changes.push_back({prog.m_starttime, event->m_endtime,
+                                   true, !row.m_dbStart.isNull(),
+                                   !row.m_dbStart.isNull()});
+                prog.m_starttime = event->m_endtime;
+                row.m_changed = true;
+            }
+        }
+
+        if (match < 0)
+        {
+            // Same as InsertDB(), which replaces a program with our start
+            // and adds to its ratings, credits and genres
+            LOG(VB_EIT, LOG_DEBUG,
+                QString("EIT: insert '%1'").arg(event->m_title.left(35)));
+            auto same = find_start(event->m_starttime);
+            if (same != rows.end())
+                same->m_deleted = true;
+
+            rows.emplace_back();
+            EITWindowRow &row = rows.back();
+            assign_without_credits(row.m_event, *event);
+            row.m_changed = true;
+            row.m_details.push_back(event);
+            count++;
+            continue;
+        }
+
+        EITWindowRow &row = rows[overlaps[match]];
+        if (event->m_starttime != row.m_event.m_starttime)
+        {
+            if (event->m_starttime < now &&
+                event->m_endtime <= row.m_event.m_endtime)
+            {
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT:  skip '%1' starttime is in the past")
+                            .arg(event->m_title.left(35)));
+                continue;
+            }
+            LOG(VB_EIT, LOG_DEBUG,
+                QString("EIT: (U) change starttime from %1 to %2 for chanid:%3 program '%4' ")
+                        .arg(row.m_event.m_starttime.toString(Qt::ISODate),
+                             event->m_starttime.toString(Qt::ISODate),
+                             QString::number(chanid),
+                             event->m_title.left(35)));
+            changes.push_back({row.m_event.m_starttime, event->m_starttime,
+                               true, false, !row.m_dbStart.isNull()});
+        }
+
+        LOG(VB_EIT, LOG_DEBUG,
+             QString("EIT: update '%1' with '%2'")
+                     .arg(row.m_event.m_title.left(35),
+                          event->m_title.left(35)));
+        DBEvent merged(kListingSourceEIT);
+        merge_event(*event, row.m_event, merged);
+        assign_without_credits(row.m_event, merged);
+        row.m_changed = true;
+        row.m_details.push_back(event);
+        count++;
+    }
+
+    // Deleted and moved rows are handled by the changes, so the updates
+    // find their rows at the new starttime.
+    QList<const DBEvent*> inserts;
+    QList<const DBEvent*> updates;
+    for (const auto &row : rows)
+    {
+        if (row.m_deleted || !row.m_changed)
+            continue;
+        if (row.m_dbStart.isNull())
+            inserts.push_back(&row.m_event);
+        else
+            updates.push_back(&row.m_event);
+    }
+
+    if (changes.empty() && inserts.isEmpty() && updates.isEmpty())
+        return true;
+
+    written = true;
+    bool ok = apply_start_changes(query, chanid, changes);
+
+    // New programs are written like InsertDB() and updated ones like
+    // UpdateDB(), which leaves the star rating and the columns the EIT
+    // does not have alone.
+    static const QString kUpdateAssignments = []()
+    {
+        QStringList assignments;
+        for (const auto &column : kEventColumns.split(','))
+        {
+            QString name = column.trimmed();
+            if (name != "chanid" && name != "starttime" && name != "stars")
+                assignments << QString("%1 = VALUES(%1)").arg(name);
+        }
+        return assignments.join(", ");
+    }();
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        const QList<const DBEvent*> &list = pass ? updates : inserts;
+        for (int i = 0; ok && i < list.size(); i += kBulkRows)
+        {
+            int nrows = std::min(kBulkRows, static_cast<int>(list.size()) - i);
+            QStringList values;
+            for (int j = 0; j < nrows; ++j)
+                values << event_values(QString::number(j));
+
+            if (pass)
+            {
+                query.prepare(QString("INSERT INTO program (%1) VALUES %2 "
+                                      "ON DUPLICATE KEY UPDATE %3")
+                              .arg(kEventColumns, values.join(","),
+                                   kUpdateAssignments));
+            }
+            else
+            {
+                query.prepare(QString("REPLACE INTO program (%1) VALUES %2")
+                              .arg(kEventColumns, values.join(",")));
+            }
+            for (int j = 0; j < nrows; ++j)
+            {
+                bind_event_values(query, QString::number(j), chanid,
+                                  *list[i + j]);
+            }
+            if (!query.exec())
+            {
+                MythDB::DBError("DBEventEIT::UpdateDBBulk insert", query);
+                ok = false;
+            }
+        }
+    }
+
+    QList<std::pair<QDateTime,const EventRating*> > ratingValues;
+    for (const auto &row : rows)
+    {
+        if (!ok)
+            break;
+        if (row.m_deleted)
+            continue;
+
+        const QDateTime &start = row.m_event.m_starttime;
+        for (const auto *event : row.m_details)
+        {
+            for (const auto & rating : qAsConst(event->m_ratings))
+                ratingValues.push_back({start, &rating});
+
+            if (event->m_credits)
+            {
+                for (auto & credit : *event->m_credits)
+                    ok = ok && (credit.InsertDB(query, chanid, start) != 0);
+            }
+
+            ok = ok && add_genres(query, event->m_genres, chanid, start);
+        }
+    }
+
+    for (int i = 0; ok && i < ratingValues.size(); i += kBulkRows)
+    {
+        int nrows = std::min(kBulkRows,
+                             static_cast<int>(ratingValues.size()) - i);
+        QStringList values;
+        for (int j = 0; j < nrows; ++j)
+            values << QString("(:CHANID, :START%1, :SYS%1, :RATING%1)").arg(j);
+
+        query.prepare(QString("INSERT IGNORE INTO programrating "
+                              "       ( chanid, starttime, `system`, rating) "
+                              "VALUES %1").arg(values.join(",")));
+        query.bindValue(":CHANID", chanid);
+        for (int j = 0; j < nrows; ++j)
+        {
+            const auto &value = ratingValues[i + j];
+            query.bindValue(QString(":START%1").arg(j),  value.first);
+            query.bindValue(QString(":SYS%1").arg(j),    value.second->m_system);
+            query.bindValue(QString(":RATING%1").arg(j), value.second->m_rating);
+        }
+        if (!query.exec())
+        {
+            MythDB::DBError("programrating insert", query);
+            ok = false;
+        }
+    }
+
+    if (!ok)
+        count = 0;
+    return ok;
+}
+
 ProgInfo::ProgInfo(const ProgInfo &other) :
     DBEvent(other.m_listingsource)
 {
@@ -1308,72 +2107,9 @@ uint ProgInfo::InsertDB(MSqlQuery &query, uint chanid,
              m_endtime.toString(Qt::ISODate),
              m_channel));
 
-    query.prepare(QString(
-        "REPLACE INTO %1 ("
-        "  chanid,         title,          subtitle,        description, "
-        "  category,       category_type,  "
-        "  starttime,      endtime, "
-        "  closecaptioned, stereo,         hdtv,            subtitled, "
-        "  subtitletypes,  audioprop,      videoprop, "
-        "  partnumber,     parttotal, "
-        "  syndicatedepisodenumber, "
-        "  airdate,        originalairdate,listingsource, "
-        "  seriesid,       programid,      previouslyshown, "
-        "  stars,          showtype,       title_pronounce, colorcode, "
-        "  season,         episode,        totalepisodes, "
-        "  inetref ) "
-        "VALUES("
-        " :CHANID,        :TITLE,         :SUBTITLE,       :DESCRIPTION, "
-        " :CATEGORY,      :CATTYPE,       "
-        " :STARTTIME,     :ENDTIME, "
-        " :CC,            :STEREO,        :HDTV,           :HASSUBTITLES, "
-        " :SUBTYPES,      :AUDIOPROP,     :VIDEOPROP, "
-        " :PARTNUMBER,    :PARTTOTAL, "
-        " :SYNDICATENO, "
-        " :AIRDATE,       :ORIGAIRDATE,   :LSOURCE, "
-        " :SERIESID,      :PROGRAMID,     :PREVSHOWN, "
-        " :STARS,         :SHOWTYPE,      :TITLEPRON,      :COLORCODE, "
-        " :SEASON,        :EPISODE,       :TOTALEPISODES, "
-        " :INETREF )").arg(table));
-
-    QString cattype = myth_category_type_to_string(m_categoryType);
-
-    query.bindValue(":CHANID",      chanid);
-    query.bindValue(":TITLE",       denullify(m_title));
-    query.bindValue(":SUBTITLE",    denullify(m_subtitle));
-    query.bindValue(":DESCRIPTION", denullify(m_description));
-    query.bindValue(":CATEGORY",    denullify(m_category));
-    query.bindValue(":CATTYPE",     cattype);
-    query.bindValue(":STARTTIME",   m_starttime);
-    query.bindValue(":ENDTIME",     denullify(m_endtime));
-    query.bindValue(":CC",
-                    (m_subtitleType & SUB_HARDHEAR) != 0);
-    query.bindValue(":STEREO",
-                    (m_audioProps   & AUD_STEREO) != 0);
-    query.bindValue(":HDTV",
-                    (m_videoProps   & VID_HDTV) != 0);
-    query.bindValue(":HASSUBTITLES",
-                    (m_subtitleType & SUB_NORMAL) != 0);
-    query.bindValue(":SUBTYPES",    m_subtitleType);
-    query.bindValue(":AUDIOPROP",   m_audioProps);
-    query.bindValue(":VIDEOPROP",   m_videoProps);
-    query.bindValue(":PARTNUMBER",  m_partnumber);
-    query.bindValue(":PARTTOTAL",   m_parttotal);
-    query.bindValue(":SYNDICATENO", denullify(m_syndicatedepisodenumber));
-    query.bindValue(":AIRDATE",     m_airdate ? QString::number(m_airdate):"0000");
-    query.bindValue(":ORIGAIRDATE", m_originalairdate);
-    query.bindValue(":LSOURCE",     m_listingsource);
-    query.bindValue(":SERIESID",    denullify(m_seriesId));
-    query.bindValue(":PROGRAMID",   denullify(m_programId));
-    query.bindValue(":PREVSHOWN",   m_previouslyshown);
-    query.bindValue(":STARS",       m_stars);
-    query.bindValue(":SHOWTYPE",    m_showtype);
-    query.bindValue(":TITLEPRON",   m_title_pronounce);
-    query.bindValue(":COLORCODE",   m_colorcode);
-    query.bindValue(":SEASON",      m_season);
-    query.bindValue(":EPISODE",     m_episode);
-    query.bindValue(":TOTALEPISODES", m_totalepisodes);
-    query.bindValue(":INETREF",     m_inetref);
+    query.prepare(QString("REPLACE INTO %1 (%2) VALUES %3")
+                  .arg(table, kProgramColumns, program_values("")));
+    bind_program_values(query, "", chanid, *this);
 
     if (!query.exec())
     {
@@ -1381,7 +2117,22 @@ uint ProgInfo::InsertDB(MSqlQuery &query, uint chanid,
         return 0;
     }
 
-    table = recording ? "recordedrating" : "programrating";
+    InsertDetailsDB(query, chanid, recording);
+
+    return 1;
+}
+
+/**
+ *  \brief Insert the ratings, credits and genres of this program.
+ *
+ *  \param query  Any mysql query structure.
+ *  \param chanid The channel number for this program.
+ *  \param recorded defaults to false, i.e. program, programrating
+ */
+void ProgInfo::InsertDetailsDB(MSqlQuery &query, uint chanid,
+                               bool recording) const
+{
+    QString table = recording ? "recordedrating" : "programrating";
     for (const auto & rating : m_ratings)
     {
         query.prepare(QString("INSERT IGNORE INTO %1 "
@@ -1404,8 +2155,6 @@ uint ProgInfo::InsertDB(MSqlQuery &query, uint chanid,
     }
 
     add_genres(query, m_genres, chanid, m_starttime);
-
-    return 1;
 }
 
 bool ProgramData::ClearDataByChannel(
@@ -1551,13 +2300,33 @@ void ProgramData::FixProgramList(QList<ProgInfo*> &fixlist)
  *  \param sourceid The data source identifier
  *  \param proglist A map of all program information keyed by channel
  *                  identifier
+ *  \param bulk     Compare and write each channel's programs in bulk,
+ *                  see HandleProgramsBulk()
  */
 void ProgramData::HandlePrograms(
-    uint sourceid, QMap<QString, QList<ProgInfo> > &proglist)
+    uint sourceid, QMap<QString, QList<ProgInfo> > &proglist, bool bulk)
 {
     uint unchanged = 0;
     uint updated = 0;
 
+    HandlePrograms(sourceid, proglist, bulk, unchanged, updated);
+
+    LOG(VB_GENERAL, LOG_INFO,
+        QString("Updated programs: %1 Unchanged programs: %2")
+                .arg(updated) .arg(unchanged));
+}
+
+/**
+ *  \brief Inserts the programs of one or more channels into the program
+ *  database, adding to the given counters instead of logging them.
+ *
+ *  This may be called concurrently from several threads as long as
+ *  each thread handles different channels.
+ */
+void ProgramData::HandlePrograms(
+    uint sourceid, QMap<QString, QList<ProgInfo> > &proglist, bool bulk,
+    uint &unchanged, uint &updated)
+{
     MSqlQuery query(MSqlQuery::InitCon());
 
     QMap<QString, QList<ProgInfo> >::const_iterator mapiter;
@@ -1602,12 +2371,36 @@ void ProgramData::HandlePrograms(
         FixProgramList(sortlist);
 
         for (uint chanid : chanids)
+        {
+            bool written = false;
+            if (bulk &&
+                HandleProgramsBulk(query, chanid, sortlist, unchanged, updated,
+                                   written))
+                continue;
+
+            // What was written stays, compare against it once more rather
+            // than write every program again on top of it
+            if (written)
+            {
+                LOG(VB_GENERAL, LOG_WARNING,
+                    QString("Bulk update of chanid %1 failed part way, "
+                            "comparing the programs again").arg(chanid));
+                written = false;
+                if (HandleProgramsBulk(query, chanid, sortlist, unchanged,
+                                       updated, written))
+                    continue;
+                if (written)
+                {
+                    LOG(VB_GENERAL, LOG_ERR,
+                        QString("Bulk update of chanid %1 failed twice, "
+                                "skipping the channel").arg(chanid));
+                    continue;
+                }
+            }
+
             HandlePrograms(query, chanid, sortlist, unchanged, updated);
+        }
     }
-
-    LOG(VB_GENERAL, LOG_INFO,
-        QString("Updated programs: %1 Unchanged programs: %2")
-                .arg(updated) .arg(unchanged));
 }
 
 /**
@@ -1642,6 +2435,287 @@ void ProgramData::HandlePrograms(MSqlQuery             &query,
     }
 }
 
+/// The columns of a program row compared by ProgramData::IsUnchanged()
+struct ProgramSnapshot
+{
+    QDateTime m_endtime;
+    QString   m_title;
+    QString   m_subtitle;
+    QString   m_description;
+    QString   m_category;
+    QString   m_categoryType;
+    uint      m_airdate         {0};
+    float     m_stars           {0.0};
+    bool      m_previouslyshown {false};
+    QString   m_titlePronounce;
+    uint      m_audioProps      {0};
+    uint      m_videoProps      {0};
+    uint      m_subtitleType    {0};
+    uint      m_partnumber      {0};
+    uint      m_parttotal       {0};
+    QString   m_seriesId;
+    QString   m_showtype;
+    QString   m_colorcode;
+    QString   m_syndicatedepisodenumber;
+    QString   m_programId;
+    uint      m_season          {0};
+    uint      m_episode         {0};
+    uint      m_totalepisodes   {0};
+    QString   m_inetref;
+};
+using ProgramSnapshotMap = QMap<QDateTime, ProgramSnapshot>;
+
+/// \brief In memory version of ProgramData::IsUnchanged().
+///
+/// This errs on the side of reporting a change: anything the SQL
+/// comparison might consider equal but this does not, e.g. a change
+/// in case only, just gets rewritten.
+static bool snapshot_matches(const ProgramSnapshot &row, const ProgInfo &pi)
+{
+    // A NULL never compares equal in IsUnchanged()
+    if (!pi.m_endtime.isValid() || pi.m_title_pronounce.isNull())
+        return false;
+    if (pi.m_showtype.isNull() || pi.m_colorcode.isNull() ||
+        pi.m_inetref.isNull())
+        return false;
+
+    return row.m_endtime         == pi.m_endtime &&
+           row.m_title           == denullify(pi.m_title) &&
+           row.m_subtitle        == denullify(pi.m_subtitle) &&
+           row.m_description     == denullify(pi.m_description) &&
+           row.m_category        == denullify(pi.m_category) &&
+           row.m_categoryType    ==
+               myth_category_type_to_string(pi.m_categoryType) &&
+           row.m_airdate         == pi.m_airdate &&
+           qAbs(row.m_stars - pi.m_stars) <= 0.001F &&
+           row.m_previouslyshown == pi.m_previouslyshown &&
+           row.m_titlePronounce  == pi.m_title_pronounce &&
+           row.m_audioProps      == pi.m_audioProps &&
+           row.m_videoProps      == pi.m_videoProps &&
+           row.m_subtitleType    == pi.m_subtitleType &&
+           row.m_partnumber      == pi.m_partnumber &&
+           row.m_parttotal       == pi.m_parttotal &&
+           row.m_seriesId        == denullify(pi.m_seriesId) &&
+           row.m_showtype        == pi.m_showtype &&
+           row.m_colorcode       == pi.m_colorcode &&
+           row.m_syndicatedepisodenumber ==
+               denullify(pi.m_syndicatedepisodenumber) &&
+           row.m_programId       == denullify(pi.m_programId) &&
+           row.m_season          == pi.m_season &&
+           row.m_episode         == pi.m_episode &&
+           row.m_totalepisodes   == pi.m_totalepisodes &&
+           row.m_inetref         == pi.m_inetref;
+}
+
+/// Loads the program rows of \p chanid starting in [from, to).
+static bool load_snapshot(MSqlQuery &query, uint chanid,
+                          const QDateTime &from, const QDateTime &to,
+                          ProgramSnapshotMap &snapshot)
+{
+    query.prepare(
+        "SELECT starttime,      endtime,        title,       subtitle, "
+        "       description,    category,       category_type, "
+        "       airdate,        stars,          previouslyshown, "
+        "       title_pronounce, audioprop+0,   videoprop+0, "
+        "       subtitletypes+0, partnumber,    parttotal, "
+        "       seriesid,       showtype,       colorcode, "
+        "       syndicatedepisodenumber,        programid, "
+        "       season,         episode,        totalepisodes, "
+        "       inetref "
+        "FROM program "
+        "WHERE chanid     = :CHANID AND "
+        "      starttime >= :FROM   AND "
+        "      starttime <  :TO");
+    query.bindValue(":CHANID", chanid);
+    query.bindValue(":FROM",   from);
+    query.bindValue(":TO",     to);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("ProgramData::load_snapshot", query);
+        return false;
+    }
+
+    while (query.next())
+    {
+        ProgramSnapshot &row =
+            snapshot[MythDate::as_utc(query.value(0).toDateTime())];
+        row.m_endtime         = MythDate::as_utc(query.value(1).toDateTime());
+        row.m_title           = query.value(2).toString();
+        row.m_subtitle        = query.value(3).toString();
+        row.m_description     = query.value(4).toString();
+        row.m_category        = query.value(5).toString();
+        row.m_categoryType    = query.value(6).toString();
+        row.m_airdate         = query.value(7).toUInt();
+        row.m_stars           = query.value(8).toFloat();
+        row.m_previouslyshown = query.value(9).toBool();
+        row.m_titlePronounce  = query.value(10).toString();
+        row.m_audioProps      = query.value(11).toUInt();
+        row.m_videoProps      = query.value(12).toUInt();
+        row.m_subtitleType    = query.value(13).toUInt();
+        row.m_partnumber      = query.value(14).toUInt();
+        row.m_parttotal       = query.value(15).toUInt();
+        row.m_seriesId        = query.value(16).toString();
+        row.m_showtype        = query.value(17).toString();
+        row.m_colorcode       = query.value(18).toString();
+        row.m_syndicatedepisodenumber = query.value(19).toString();
+        row.m_programId       = query.value(20).toString();
+        row.m_season          = query.value(21).toUInt();
+        row.m_episode         = query.value(22).toUInt();
+        row.m_totalepisodes   = query.value(23).toUInt();
+        row.m_inetref         = query.value(24).toString();
+    }
+
+    return true;
+}
+
+/**
+ *  \brief Bulk version of HandlePrograms() for a single channel.
+ *
+ *  Rather than querying the database for each program, the channel's
+ *  existing programs in the time span of the new listings are loaded
+ *  in one query and compared in memory. The programs that changed
+ *  and the ones they replace are then written with multi-row DELETE
+ *  and REPLACE statements.
+ *
+ *  The program tables are MyISAM, so there is no transaction and a
+ *  failed write leaves the earlier ones in place. The writes are ordered
+ *  so that this can be run again to finish the job: a program row is
+ *  deleted after its ratings, credits and genres, and written after them.
+ *
+ *  \param written Set once the first write is attempted.
+ *  \return false if the channel could not be handled in bulk. If nothing
+ *          was written the caller can fall back to the per program path,
+ *          otherwise it should run this again.
+ */
+bool ProgramData::HandleProgramsBulk(MSqlQuery              &query,
+                                     uint                    chanid,
+                                     const QList<ProgInfo*> &sortlist,
+                                     uint &unchanged,
+                                     uint &updated,
+                                     bool &written)
+{
+    if (sortlist.isEmpty())
+        return true;
+
+    QDateTime from = sortlist.front()->m_starttime;
+    QDateTime to   = sortlist.back()->m_starttime.addSecs(1);
+    for (const auto *pinfo : qAsConst(sortlist))
+    {
+        if (pinfo->m_endtime.isValid() && pinfo->m_endtime > to)
+            to = pinfo->m_endtime;
+    }
+
+    ProgramSnapshotMap snapshot;
+    if (!load_snapshot(query, chanid, from, to, snapshot))
+        return false;
+
+    // Work out what the per program path would have done.
+    QList<QDateTime> deletes;
+    QList<const ProgInfo*> inserts;
+    uint same = 0;
+    for (const auto *pinfo : qAsConst(sortlist))
+    {
+        auto row = snapshot.constFind(pinfo->m_starttime);
+        if (row != snapshot.constEnd() && snapshot_matches(*row, *pinfo))
+        {
+            same++;
+            continue;
+        }
+
+        // Deleting the overlaps of this program must not remove one
+        // we are about to insert. FixProgramList() should have made
+        // that impossible, but play it safe.
+        if (!inserts.isEmpty() &&
+            inserts.back()->m_starttime >= pinfo->m_starttime)
+            return false;
+
+        if (pinfo->m_endtime.isValid())
+        {
+            auto it = snapshot.lowerBound(pinfo->m_starttime);
+            while (it != snapshot.end() && it.key() < pinfo->m_endtime)
+            {
+                LOG(VB_XMLTV, LOG_DEBUG,
+                    QString("Removing existing program: %1 - %2 %3 %4")
+                    .arg(it.key().toString(Qt::ISODate),
+                         it->m_endtime.toString(Qt::ISODate),
+                         pinfo->m_channel, it->m_title));
+                deletes.push_back(it.key());
+                it = snapshot.erase(it);
+            }
+        }
+        inserts.push_back(pinfo);
+    }
+
+    if (inserts.isEmpty())
+    {
+        unchanged += same;
+        return true;
+    }
+
+    written = true;
+
+    bool ok = true;
+    static const std::array<const char *,4> kTables
+        { "programrating", "credits", "programgenres", "program" };
+    for (int i = 0; ok && i < deletes.size(); i += kBulkRows)
+    {
+        int rows = std::min(kBulkRows, static_cast<int>(deletes.size()) - i);
+        QStringList placeholders;
+        for (int j = 0; j < rows; ++j)
+            placeholders << QString(":START%1").arg(j);
+
+        for (const auto *table : kTables)
+        {
+            query.prepare(QString("DELETE FROM %1 "
+                                  "WHERE chanid = :CHANID AND "
+                                  "      starttime IN (%2)")
+                          .arg(table, placeholders.join(",")));
+            query.bindValue(":CHANID", chanid);
+            for (int j = 0; j < rows; ++j)
+                query.bindValue(placeholders[j], deletes[i + j]);
+            if (!query.exec())
+            {
+                MythDB::DBError("ProgramData::HandleProgramsBulk delete",
+                                query);
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; ok && i < inserts.size(); i += kBulkRows)
+    {
+        int rows = std::min(kBulkRows, static_cast<int>(inserts.size()) - i);
+        QStringList values;
+        for (int j = 0; j < rows; ++j)
+        {
+            inserts[i + j]->InsertDetailsDB(query, chanid);
+            values << program_values(QString::number(j));
+        }
+
+        query.prepare(QString("REPLACE INTO program (%1) VALUES %2")
+                      .arg(kProgramColumns, values.join(",")));
+        for (int j = 0; j < rows; ++j)
+        {
+            bind_program_values(query, QString::number(j), chanid,
+                                *inserts[i + j]);
+        }
+        if (!query.exec())
+        {
+            MythDB::DBError("ProgramData::HandleProgramsBulk insert", query);
+            ok = false;
+        }
+    }
+
+    if (!ok)
+        return false;
+
+    unchanged += same;
+    updated += inserts.size();
+    return true;
+}
+
 int ProgramData::fix_end_times(void)
 {
     int count = 0;
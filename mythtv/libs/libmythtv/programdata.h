@@ -217,6 +217,16 @@ class MTV_PUBLIC DBEventEIT : public DBEvent
         return DBEvent::UpdateDB(query, m_chanid, match_threshold);
     }
 
+    static bool UpdateDBBulk(MSqlQuery &query, uint chanid,
+                             const std::vector<DBEventEIT*> &events,
+                             int match_threshold, uint &count);
+
+  private:
+    static bool ReconcileDBBulk(MSqlQuery &query, uint chanid,
+                                const std::vector<DBEventEIT*> &events,
+                                int match_threshold, uint &count,
+                                bool &written);
+
   public:
     uint32_t              m_chanid;
     FixupValue            m_fixup;
@@ -233,6 +243,8 @@ class MTV_PUBLIC ProgInfo : public DBEvent
 
     uint InsertDB(MSqlQuery &query, uint chanid,
                   bool recording = false) const override; // DBEvent
+    void InsertDetailsDB(MSqlQuery &query, uint chanid,
+                         bool recording = false) const;
 
     void Squeeze(void) override; // DBEvent
 
@@ -254,7 +266,11 @@ class MTV_PUBLIC ProgramData
 {
   public:
     static void HandlePrograms(uint sourceid,
-                               QMap<QString, QList<ProgInfo> > &proglist);
+                               QMap<QString, QList<ProgInfo> > &proglist,
+                               bool bulk = false);
+    static void HandlePrograms(uint sourceid,
+                               QMap<QString, QList<ProgInfo> > &proglist,
+                               bool bulk, uint &unchanged, uint &updated);
 
     static int  fix_end_times(void);
     static bool ClearDataByChannel(
@@ -274,6 +290,10 @@ class MTV_PUBLIC ProgramData
         MSqlQuery &query, uint chanid,
         const QList<ProgInfo*> &sortlist,
         uint &unchanged, uint &updated);
+    static bool HandleProgramsBulk(
+        MSqlQuery &query, uint chanid,
+        const QList<ProgInfo*> &sortlist,
+        uint &unchanged, uint &updated, bool &written);
     static bool IsUnchanged(
         MSqlQuery &query, uint chanid, const ProgInfo &pi);
     static bool DeleteOverlaps(
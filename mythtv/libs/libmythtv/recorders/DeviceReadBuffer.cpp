@@ -292,7 +292,7 @@ void DeviceReadBuffer::IncrReadPointer(uint len)
     QMutexLocker locker(&m_lock);
     m_used    -= len;
     m_readPtr += len;
-    m_readPtr  = (m_readPtr == m_endPtr) ? m_buffer : m_readPtr;
+    m_readPtr  = (m_readPtr >= m_endPtr) ? m_buffer + (m_readPtr - m_endPtr) : m_readPtr;
 #if REPORT_RING_STATS
     ++m_avgBufReadCnt;
 #endif
@@ -649,6 +649,52 @@ uint DeviceReadBuffer::Read(unsigned char *buf, const uint count)
     return cnt;
 }
 
+/** \fn DeviceReadBuffer::Peek(uint&)
+ *  \brief Returns buffered data in place, without copying it out.
+ *
+ *  When the buffered data wraps around the end of the ring, up to one
+ *  device read worth of it is mirrored into the spare space after the
+ *  end of the ring so the caller still sees a single contiguous span.
+ *  The writer never touches the returned span, it stays valid until
+ *  Commit() is called.
+ *
+ *  \param len    Set to the number of bytes available at the pointer
+ *  \return pointer to the data, or nullptr if there is none
+ */
+const unsigned char *DeviceReadBuffer::Peek(uint &len)
+{
+    len = 0;
+    size_t avail = WaitForUsed(m_readThreshold, 20ms);
+    if (!avail)
+        return nullptr;
+
+    QMutexLocker locker(&m_lock);
+    size_t contiguous = m_endPtr - m_readPtr;
+    if (avail > contiguous)
+    {
+        // The writer is somewhere before m_readPtr now, and the
+        // wrapped bytes at the start of the ring are already written.
+        size_t wrapped = std::min(avail - contiguous, m_devReadSize);
+        memcpy(m_endPtr, m_buffer, wrapped);
+        avail = contiguous + wrapped;
+    }
+
+    len = avail;
+    return m_readPtr;
+}
+
+/** \fn DeviceReadBuffer::Commit(uint)
+ *  \brief Releases len bytes of the span returned by Peek().
+ */
+void DeviceReadBuffer::Commit(uint len)
+{
+    IncrReadPointer(len);
+
+#if REPORT_RING_STATS
+    ReportStats();
+#endif
+}
+
 /** \fn DeviceReadBuffer::WaitForUnused(uint) const
  *  \param needed Number of bytes we want to write
  *  \return bytes available for writing
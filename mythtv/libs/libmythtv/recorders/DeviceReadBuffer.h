@@ -59,6 +59,8 @@ class DeviceReadBuffer : protected MThread
     bool IsRunning(void) const;
 
     uint Read(unsigned char *buf, uint count);
+    const unsigned char *Peek(uint &len);
+    void Commit(uint len);
     uint GetUsed(void) const;
 
   private:
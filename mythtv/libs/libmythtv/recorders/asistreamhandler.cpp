@@ -156,20 +156,6 @@ void ASIStreamHandler::run(void)
         return;
     }
 
-    uint buffer_size = m_packetSize * 15000;
-    auto *buffer = new unsigned char[buffer_size];
-    if (!buffer)
-    {
-        LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to allocate buffer");
-        delete drb;
-        drb = nullptr;
-        Close();
-        m_bError = true;
-        RunEpilog();
-        return;
-    }
-    memset(buffer, 0, buffer_size);
-
     SetRunning(true, true, false);
 
     drb->Start();
@@ -179,15 +165,14 @@ void ASIStreamHandler::run(void)
         m_drb = drb;
     }
 
-    int remainder = 0;
     while (m_runningDesired && !m_bError)
     {
         UpdateFiltersFromStreamData();
 
-        ssize_t len = 0;
-
-        len = drb->Read(
-            &(buffer[remainder]), buffer_size - remainder);
+        // Parse the data in place in the device read buffer,
+        // anything left over stays there for the next pass.
+        uint len = 0;
+        const unsigned char *data = drb->Peek(len);
 
         if (!m_runningDesired)
             break;
@@ -205,36 +190,22 @@ void ASIStreamHandler::run(void)
             m_bError = true;
         }
 
-        len += remainder;
-
         if (len < 10) // 10 bytes = 4 bytes TS header + 6 bytes PES header
-        {
-            remainder = len;
             continue;
-        }
 
         if (!m_listenerLock.tryLock())
-        {
-            remainder = len;
             continue;
-        }
 
-        if (m_streamDataList.empty())
+        int remainder = 0;
+        if (!m_streamDataList.empty())
         {
-            m_listenerLock.unlock();
-            continue;
+            remainder = ProcessStreamData(data, len);
+            WriteMPTS(data, len - remainder);
         }
 
-        for (auto sit = m_streamDataList.cbegin();
-             sit != m_streamDataList.cend(); ++sit)
-            remainder = sit.key()->ProcessData(buffer, len);
-
-        WriteMPTS(buffer, len - remainder);
-
         m_listenerLock.unlock();
 
-        if (remainder > 0 && (len > remainder)) // leftover bytes
-            memmove(buffer, &(buffer[len - remainder]), remainder);
+        drb->Commit(len - remainder);
     }
     LOG(VB_RECORD, LOG_INFO, LOC + "run(): " + "shutdown");
 
@@ -249,7 +220,6 @@ void ASIStreamHandler::run(void)
         drb->Stop();
 
     delete drb;
-    delete[] buffer;
     Close();
 
     LOG(VB_RECORD, LOG_INFO, LOC + "run(): " + "end");
@@ -254,7 +254,8 @@ void DTVRecorder::InitStreamData(void)
     }
 }
 
-void DTVRecorder::BufferedWrite(const TSPacket &tspacket, bool insert)
+void DTVRecorder::BufferedWrite(const TSPacket *tspackets, uint count,
+                                bool insert)
 {
     if (!insert) // PAT/PMT may need inserted in front of any buffered data
     {
@@ -271,7 +272,7 @@ void DTVRecorder::BufferedWrite(const TSPacket &tspacket, bool insert)
             m_timeOfLatestDataTimer.start();
         }
 
-        int val = m_timeOfLatestDataCount.fetchAndAddRelaxed(1);
+        int val = m_timeOfLatestDataCount.fetchAndAddRelaxed(count);
         int thresh = m_timeOfLatestDataPacketInterval.fetchAndAddRelaxed(0);
         if (val > thresh)
         {
@@ -301,8 +302,9 @@ void DTVRecorder::BufferedWrite(const TSPacket &tspacket, bool insert)
         if (m_bufferPackets)
         {
             int idx = m_payloadBuffer.size();
-            m_payloadBuffer.resize(idx + TSPacket::kSize);
-            memcpy(&m_payloadBuffer[idx], tspacket.data(), TSPacket::kSize);
+            m_payloadBuffer.resize(idx + (count * TSPacket::kSize));
+            memcpy(&m_payloadBuffer[idx], tspackets[0].data(),
+                   count * TSPacket::kSize);
             return;
         }
 
@@ -316,7 +318,8 @@ void DTVRecorder::BufferedWrite(const TSPacket &tspacket, bool insert)
         }
     }
 
-    if (m_ringBuffer && m_ringBuffer->Write(tspacket.data(), TSPacket::kSize) < 0 &&
+    if (m_ringBuffer &&
+        m_ringBuffer->Write(tspackets[0].data(), count * TSPacket::kSize) < 0 &&
         m_curRecording && m_curRecording->GetRecordingStatus() != RecStatus::Failing)
     {
         LOG(VB_GENERAL, LOG_INFO, LOC +
@@ -1543,6 +1546,47 @@ bool DTVRecorder::ProcessTSPacket(const TSPacket &tspacket)
     return true;
 }
 
+/** \fn DTVRecorder::ProcessTSPackets(const TSPacket*,uint)
+ *  \brief Writes a run of same-PID packets with a single BufferedWrite().
+ *
+ *  Falls back to ProcessTSPacket() whenever each packet has to be
+ *  looked at, i.e. when synthesizing keyframes, pacing MPTS writes,
+ *  stripping the PID or waiting for the first keyframe.
+ */
+bool DTVRecorder::ProcessTSPackets(const TSPacket *tspackets, uint count)
+{
+    const uint pid = tspackets[0].PID();
+
+    if ((m_inputPmt && m_hasNoAV) || m_recordMptsOnly ||
+        (pid == 0x1fff) || (m_streamId[pid] == 0) ||
+        (m_waitForKeyframeOption && m_firstKeyframe < 0))
+    {
+        return TSPacketListener::ProcessTSPackets(tspackets, count);
+    }
+
+    m_packetCount.fetchAndAddAcquire(count);
+
+    // Check continuity counters
+    for (uint i = 0; i < count; ++i)
+    {
+        uint old_cnt = m_continuityCounter[pid];
+        if (!CheckCC(pid, tspackets[i].ContinuityCounter()))
+        {
+            int v = m_continuityErrorCount.fetchAndAddRelaxed(1) + 1;
+            double erate = v * 100.0 / m_packetCount.fetchAndAddRelaxed(0);
+            LOG(VB_RECORD, LOG_WARNING, LOC +
+                QString("PID 0x%1 discontinuity detected ((%2+1)%16!=%3) %4%")
+                    .arg(pid,0,16).arg(old_cnt,2)
+                    .arg(tspackets[i].ContinuityCounter(),2)
+                    .arg(erate));
+        }
+    }
+
+    BufferedWrite(tspackets, count);
+
+    return true;
+}
+
 bool DTVRecorder::ProcessVideoTSPacket(const TSPacket &tspacket)
 {
     if (!m_ringBuffer)
@@ -82,6 +82,7 @@ class DTVRecorder :
 
     // TSPacketListener
     bool ProcessTSPacket(const TSPacket &tspacket) override; // TSPacketListener
+    bool ProcessTSPackets(const TSPacket *tspackets, uint count) override; // TSPacketListener
 
     // TSPacketListenerAV
     bool ProcessVideoTSPacket(const TSPacket& tspacket) override; // TSPacketListenerAV
@@ -100,7 +101,10 @@ class DTVRecorder :
     void HandleTimestamps(int stream_id, int64_t pts, int64_t dts);
     void UpdateFramesWritten(void);
 
-    void BufferedWrite(const TSPacket &tspacket, bool insert = false);
+    void BufferedWrite(const TSPacket &tspacket, bool insert = false)
+        { BufferedWrite(&tspacket, 1, insert); }
+    void BufferedWrite(const TSPacket *tspackets, uint count,
+                       bool insert = false);
 
     // MPEG TS "audio only" support
     bool FindAudioKeyframes(const TSPacket *tspacket);
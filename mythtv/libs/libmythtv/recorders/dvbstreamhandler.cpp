@@ -157,17 +157,11 @@ void DVBStreamHandler::RunTS(void)
         std::this_thread::sleep_for(50ms);
     }
 
+    // Only reads straight from the device need a buffer of their own,
+    // the device read buffer is parsed in place
     int remainder = 0;
     int buffer_size = TSPacket::kSize * 15000;
-    auto *buffer = new unsigned char[buffer_size];
-    if (!buffer)
-    {
-        LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to allocate memory");
-        close(dvr_fd);
-        m_bError = true;
-        return;
-    }
-    memset(buffer, 0, buffer_size);
+    unsigned char *buffer = nullptr;
 
     DeviceReadBuffer *drb = nullptr;
     if (m_needsBuffering)
@@ -177,7 +171,6 @@ void DVBStreamHandler::RunTS(void)
         {
             LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to allocate DRB buffer");
             delete drb;
-            delete[] buffer;
             close(dvr_fd);
             m_bError = true;
             return;
@@ -185,6 +178,11 @@ void DVBStreamHandler::RunTS(void)
 
         drb->Start();
     }
+    else
+    {
+        buffer = new unsigned char[buffer_size];
+        memset(buffer, 0, buffer_size);
+    }
 
     {
         // SetRunning() + set m_drb
@@ -209,7 +207,10 @@ void DVBStreamHandler::RunTS(void)
 
         if (drb)
         {
-            len = drb->Read(&(buffer[remainder]), buffer_size - remainder);
+            // Parse the data in place in the device read buffer,
+            // anything left over stays there for the next pass.
+            uint avail = 0;
+            const unsigned char *data = drb->Peek(avail);
 
             // Check for DRB errors
             if (drb->IsErrored())
@@ -223,27 +224,40 @@ void DVBStreamHandler::RunTS(void)
                 LOG(VB_GENERAL, LOG_ERR, LOC + "Device EOF detected");
                 m_bError = true;
             }
+
+            if (avail < 10) // 10 bytes = 4 bytes TS header + 6 bytes PES header
+                continue;
+
+            QMutexLocker locker(&m_listenerLock);
+
+            int left = 0;
+            if (!m_streamDataList.empty())
+            {
+                left = ProcessStreamData(data, avail);
+                WriteMPTS(data, avail - left);
+            }
+
+            drb->Commit(avail - left);
+            continue;
+        }
+
+        // timeout gets reset by select, so we need to create new one
+        struct timeval timeout = { 0, 50 /* ms */ * 1000 /* -> usec */ };
+        int ret = select(dvr_fd+1, &fd_select_set, nullptr, nullptr, &timeout);
+        if (ret == -1 && errno != EINTR)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "select() failed" + ENO);
         }
         else
         {
-            // timeout gets reset by select, so we need to create new one
-            struct timeval timeout = { 0, 50 /* ms */ * 1000 /* -> usec */ };
-            int ret = select(dvr_fd+1, &fd_select_set, nullptr, nullptr, &timeout);
-            if (ret == -1 && errno != EINTR)
-            {
-                LOG(VB_GENERAL, LOG_ERR, LOC + "select() failed" + ENO);
-            }
-            else
-            {
-                len = read(dvr_fd, &(buffer[remainder]),
-                           buffer_size - remainder);
-            }
+            len = read(dvr_fd, &(buffer[remainder]),
+                       buffer_size - remainder);
+        }
 
-            if ((0 == len) || (-1 == len))
-            {
-                std::this_thread::sleep_for(100us);
-                continue;
-            }
+        if ((0 == len) || (-1 == len))
+        {
+            std::this_thread::sleep_for(100us);
+            continue;
         }
 
         len += remainder;
@@ -262,8 +276,7 @@ void DVBStreamHandler::RunTS(void)
             continue;
         }
 
-        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
-            remainder = sit.key()->ProcessData(buffer, len);
+        remainder = ProcessStreamData(buffer, len);
 
         WriteMPTS(buffer, len - remainder);
 
@@ -1212,6 +1212,15 @@ bool MpegRecorder::ProcessTSPacket(const TSPacket &tspacket_real)
     return ret;
 }
 
+bool MpegRecorder::ProcessTSPackets(const TSPacket *tspackets, uint count)
+{
+    // The HD-PVR PCR PID needs the per packet continuity counter fixup.
+    if ((m_driver == "hdpvr") && (tspackets[0].PID() == 0x1001))
+        return TSPacketListener::ProcessTSPackets(tspackets, count);
+
+    return DTVRecorder::ProcessTSPackets(tspackets, count);
+}
+
 void MpegRecorder::Reset(void)
 {
     LOG(VB_RECORD, LOG_INFO, LOC + "Reset(void)");
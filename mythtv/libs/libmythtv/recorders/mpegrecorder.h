@@ -45,6 +45,7 @@ class MpegRecorder : public V4LRecorder,
 
     // TSPacketListener
     bool ProcessTSPacket(const TSPacket &tspacket) override; // DTVRecorder
+    bool ProcessTSPackets(const TSPacket *tspackets, uint count) override; // DTVRecorder
 
     // DeviceReaderCB
     void ReaderPaused(int /*fd*/) override // DeviceReaderCB
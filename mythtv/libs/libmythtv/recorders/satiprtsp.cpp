@@ -595,16 +595,12 @@ void SatIPRTSPWriteHelper::timerEvent(QTimerEvent* /*event*/)
                 int remainder = 0;
                 {
                     QMutexLocker locker(&m_streamHandler->m_listenerLock);
-                    auto streamDataList = m_streamHandler->m_streamDataList;
-                    if (!streamDataList.isEmpty())
+                    if (!m_streamHandler->m_streamDataList.isEmpty())
                     {
                         const unsigned char *data_buffer = ts_packet.GetTSData();
                         size_t data_length = ts_packet.GetTSDataSize();
 
-                        for (auto sit = streamDataList.cbegin(); sit != streamDataList.cend(); ++sit)
-                        {
-                            remainder = sit.key()->ProcessData(data_buffer, data_length);
-                        }
+                        remainder = m_streamHandler->ProcessStreamData(data_buffer, data_length);
 
                         m_streamHandler->WriteMPTS(data_buffer, data_length - remainder);
                     }
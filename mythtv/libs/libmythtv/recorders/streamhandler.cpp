@@ -4,6 +4,7 @@
 #include "streamhandler.h"
 
 #include "threadedfilewriter.h"
+#include "mythcorecontext.h"
 #include <utility>
 
 #ifndef O_LARGEFILE
@@ -12,6 +13,79 @@
 
 #define LOC      QString("SH[%1]: ").arg(m_inputId)
 
+/// Fan-out starts with blocks of at least this size, smaller ones are not
+/// worth the thread handoff, e.g. the handful of packets in an RTP datagram.
+static constexpr int kFanOutMinBlock { TSPacket::kSize * 64 };
+
+/// Blocks a worker may fall behind by before the reader waits for it.
+static constexpr int kFanOutMaxQueued { 64 };
+
+StreamDataWorker::StreamDataWorker(MPEGStreamData *data)
+    : MThread("StreamDataWorker"), m_data(data)
+{
+    start();
+}
+
+StreamDataWorker::~StreamDataWorker()
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_stop = true;
+        m_wait.wakeAll();
+    }
+    wait();
+}
+
+/// Queues a block, waiting while the worker is too far behind.
+void StreamDataWorker::Process(const QByteArray &block)
+{
+    QMutexLocker locker(&m_lock);
+    while (m_blocks.size() >= kFanOutMaxQueued && !m_stop)
+        m_wait.wait(&m_lock);
+    m_blocks.enqueue(block);
+    m_wait.wakeAll();
+}
+
+void StreamDataWorker::run(void)
+{
+    RunProlog();
+
+    m_lock.lock();
+    while (true)
+    {
+        while (m_blocks.isEmpty() && !m_stop)
+            m_wait.wait(&m_lock);
+        // The queued blocks are the end of the recording, parse them first
+        if (m_stop && m_blocks.isEmpty())
+            break;
+
+        QByteArray block = m_blocks.dequeue();
+        m_wait.wakeAll();
+        m_lock.unlock();
+
+        if (!m_remainder.isEmpty())
+        {
+            block.prepend(m_remainder);
+            m_remainder.clear();
+        }
+
+        int remainder = 0;
+        {
+            QMutexLocker locker(&m_dataLock);
+            remainder = m_data->ProcessData(
+                reinterpret_cast<const unsigned char*>(block.constData()),
+                block.size());
+        }
+        if (remainder > 0)
+            m_remainder = block.right(remainder);
+
+        m_lock.lock();
+    }
+    m_lock.unlock();
+
+    RunEpilog();
+}
+
 StreamHandler::~StreamHandler()
 {
     QMutexLocker locker(&m_addRmLock);
@@ -23,6 +97,8 @@ StreamHandler::~StreamHandler()
             LOG(VB_GENERAL, LOG_ERR, LOC +
                 "dtor & _stream_data_list not empty");
         }
+        qDeleteAll(m_fanOutWorkers);
+        m_fanOutWorkers.clear();
     }
 
     // This should never be triggered.. just to be safe..
@@ -57,6 +133,7 @@ void StreamHandler::AddListener(MPEGStreamData *data,
         QMutexLocker locker2(&m_startStopLock);
         m_allowSectionReader = allow_section_reader;
         m_needsBuffering     = needs_buffering;
+        m_fanOut = gCoreContext->GetBoolSetting("StreamHandlerFanOut", false);
     }
     else
     {
@@ -103,6 +180,10 @@ void StreamHandler::RemoveListener(MPEGStreamData *data)
         m_streamDataList.erase(it);
     }
 
+    // Waits for the queued blocks to be parsed, so the listener
+    // is no longer used once this returns.
+    delete m_fanOutWorkers.take(data);
+
     m_listenerLock.unlock();
 
     if (m_streamDataList.empty())
@@ -290,7 +371,10 @@ bool StreamHandler::UpdateFiltersFromStreamData(void)
     {
         QMutexLocker read_locker(&m_listenerLock);
         for (auto it = m_streamDataList.cbegin(); it != m_streamDataList.cend(); ++it)
+        {
+            QMutexLocker data_locker(GetFanOutLock(it.key()));
             it.key()->GetPIDs(pids);
+        }
     }
 
     QMap<uint, PIDInfo*> add_pids;
@@ -341,11 +425,52 @@ PIDPriority StreamHandler::GetPIDPriority(uint pid) const
     PIDPriority tmp = kPIDPriorityNone;
 
     for (auto it = m_streamDataList.cbegin(); it != m_streamDataList.cend(); ++it)
+    {
+        QMutexLocker data_locker(GetFanOutLock(it.key()));
         tmp = std::max(tmp, it.key()->GetPIDPriority(pid));
+    }
 
     return tmp;
 }
 
+int StreamHandler::ProcessStreamData(const unsigned char *buffer, int len)
+{
+    // Once there are workers every listener gets its data through one,
+    // so that its blocks are parsed in order.
+    if (m_fanOutWorkers.isEmpty() &&
+        (!m_fanOut || m_streamDataList.size() < 2 || len < kFanOutMinBlock))
+    {
+        int remainder = 0;
+        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
+            remainder = sit.key()->ProcessData(buffer, len);
+        return remainder;
+    }
+
+    // The workers share one copy of the block and each keeps what its
+    // listener leaves over, so the reader has nothing to keep.
+    QByteArray block(reinterpret_cast<const char*>(buffer), len);
+
+    for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
+    {
+        StreamDataWorker *&worker = m_fanOutWorkers[sit.key()];
+        if (!worker)
+        {
+            LOG(VB_RECORD, LOG_INFO, LOC + QString("Starting fan-out worker for 0x%1")
+                .arg((uint64_t)sit.key(),0,16));
+            worker = new StreamDataWorker(sit.key());
+        }
+        worker->Process(block);
+    }
+
+    return 0;
+}
+
+QMutex *StreamHandler::GetFanOutLock(MPEGStreamData *data) const
+{
+    StreamDataWorker *worker = m_fanOutWorkers.value(data);
+    return worker ? worker->GetDataLock() : nullptr;
+}
+
 void StreamHandler::WriteMPTS(const unsigned char * buffer, uint len)
 {
     if (m_mptsTfw == nullptr)
@@ -8,6 +8,8 @@
 
 // Qt headers
 #include <QWaitCondition>
+#include <QByteArray>
+#include <QQueue>
 #include <QString>
 #include <QMutex>
 #include <QMap>
@@ -49,6 +51,42 @@ class PIDInfo
 // iterator returning these in order of ascending pid number.
 using PIDInfoMap = QMap<uint,PIDInfo*>;
 
+/** \class StreamDataWorker
+ *  \brief Runs MPEGStreamData::ProcessData() for one listener on its own
+ *         thread.
+ *
+ *  Used by StreamHandler in fan-out mode so that several recordings
+ *  sharing one multiplex are parsed on separate cores. The blocks passed
+ *  to Process() are implicitly shared between the workers, so the reader
+ *  copies each block once and can read the next one while they are parsed.
+ *  Like the reader, each worker keeps the bytes ProcessData() leaves over
+ *  and parses them with the next block.
+ *
+ *  GetDataLock() is held while the listener parses, other threads take it
+ *  before they look at the listener's PIDs.
+ */
+class StreamDataWorker : public MThread
+{
+  public:
+    explicit StreamDataWorker(MPEGStreamData *data);
+    ~StreamDataWorker() override;
+
+    void Process(const QByteArray &block);
+    QMutex *GetDataLock(void) { return &m_dataLock; }
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    MPEGStreamData      *m_data      {nullptr};
+    QMutex               m_dataLock;
+    QByteArray           m_remainder;
+    QMutex               m_lock;
+    QWaitCondition       m_wait;
+    QQueue<QByteArray>   m_blocks;
+    bool                 m_stop      {false};
+};
+
 // locking order
 // _pid_lock -> _listener_lock
 // _add_rm_lock -> _listener_lock
@@ -101,6 +139,14 @@ class StreamHandler : protected MThread, public DeviceReaderCB
         { return new PIDInfo(pid, stream_type, pes_type); }
 
   protected:
+    /// Hands a block of TS data to every listener and returns the number
+    /// of trailing bytes that were not consumed.
+    /// \note: The m_listenerLock must be held when this is called.
+    int ProcessStreamData(const unsigned char *buffer, int len);
+    /// Returns the lock a fan-out worker holds while \p data parses,
+    /// or nullptr when it has none.
+    /// \note: The m_listenerLock must be held when this is called.
+    QMutex *GetFanOutLock(MPEGStreamData *data) const;
     /// Write out a copy of the raw MPTS
     void WriteMPTS(const unsigned char * buffer, uint len);
     /// At minimum this sets _running_desired, this may also send
@@ -151,6 +197,11 @@ class StreamHandler : protected MThread, public DeviceReaderCB
     mutable QRecursiveMutex m_listenerLock;
 #endif
     StreamDataList      m_streamDataList;
+
+    /// When set, listeners on a shared multiplex each parse the
+    /// read block on their own StreamDataWorker thread.
+    bool                m_fanOut                {false};
+    QHash<MPEGStreamData*,StreamDataWorker*> m_fanOutWorkers;
 };
 
 #endif // STREAM_HANDLER_H
@@ -18,11 +18,13 @@
  *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+#include <array>
 #include <cstdio>
 #include <iostream>
 #include "test_eitfixups.h"
 #include "eitfixup.h"
 #include "channelutil.h"
+#include "mthreadpool.h"
 #include "programdata.h"
 #include "programinfo.h"
 #include "dishdescriptors.h"
@@ -46,6 +48,7 @@ void TestEITFixups::initTestCase()
 
 void TestEITFixups::cleanupTestCase()
 {
+    MThreadPool::ShutdownAllPools();
 }
 
 QString TestEITFixups::getSubtitleType(unsigned char type)
@@ -3681,5 +3684,116 @@ void TestEITFixups::testGreekCategories()
     QCOMPARE(event.m_category, e_category);
 }
 
+/// A mix of events taken from the tests above, \p copies times over.
+std::vector<DBEventEIT*> TestEITFixups::BatchOfEvents(int copies)
+{
+    struct Sample
+    {
+        FixupValue   m_fixup;
+        const char  *m_title;
+        const char  *m_subtitle;
+        const char  *m_description;
+    };
+    static const std::array<const Sample,12> kSamples
+    {{
+        { EITFixUp::kFixUK, "Law & Order: Special Victims Unit", "",
+          "Sugar: New. Police drama series about an elite sex crime  ..." },
+        { EITFixUp::kFixUK, "New: Marvel's Agents of...",
+          "...S.H.I.E.L.D. Brand new series - Bouncing Back: <description> (S3 Ep11/22)  [AD,S]",
+          "" },
+        { EITFixUp::kFixUK, "The title Series 2, Episode 3 of 12.", "",
+          "This is a description." },
+        { EITFixUp::kFixUK, "The title", "",
+          "Western starring Joe Bloggs and Jane Doe. (1984)" },
+        { EITFixUp::kFixP7S1, "Titel", "Folgentitel, Mystery, USA 2011",
+          "Beschreibung" },
+        { EITFixUp::kFixRTL, "Titel",
+          "Folge 9: 'Leckerlis auf Eis / Rettung aus höchster Not'",
+          "Description" },
+        { EITFixUp::kFixRTL, "Title", "",
+          "Description. Wiederholung vom 25.12.2018" },
+        { EITFixUp::kFixPremiere, "Titel", "Subtitle",
+          "4. Staffel, Folge 16: Viele Mitglieder einer christlichen Gemeinde "
+          "erkranken nach einem Giftanschlag tödlich. 50 Min. USA 2008. "
+          "Von Leslie Libman, mit Rob Morrow, David Krumholtz, Judd Hirsch. "
+          "Ab 12 Jahren" },
+        { EITFixUp::kFixMCA, "Title...", "Subtitle",
+          "Title is really long. This is the description." },
+        { EITFixUp::kFixAUFreeview, "Title", "Subtitle1",
+          "Description blah blah (Subtitle2) (1984) (Bud Abbott/Lou Costello)" },
+        { EITFixUp::kFixNL, "Title (R)", "Subtitle", "Description." },
+        { EITFixUp::kFixComHem, "Title", "Subtitle",
+          "Description. Del 12/345." },
+    }};
+
+    std::vector<DBEventEIT*> events;
+    for (int i = 0; i < copies; ++i)
+    {
+        for (const auto &sample : kSamples)
+        {
+            events.push_back(SimpleDBEventEIT(sample.m_fixup, sample.m_title,
+                                              sample.m_subtitle,
+                                              sample.m_description));
+        }
+    }
+    return events;
+}
+
+void TestEITFixups::testFixBatch()
+{
+    std::vector<DBEventEIT*> serial = BatchOfEvents(16);
+    std::vector<DBEventEIT*> pooled = BatchOfEvents(16);
+
+    for (auto *event : serial)
+        EITFixUp::Fix(*event);
+    EITFixUp::Fix(pooled, 4);
+
+    QCOMPARE(pooled.size(), serial.size());
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        QCOMPARE(pooled[i]->m_title,        serial[i]->m_title);
+        QCOMPARE(pooled[i]->m_subtitle,     serial[i]->m_subtitle);
+        QCOMPARE(pooled[i]->m_description,  serial[i]->m_description);
+        QCOMPARE(pooled[i]->m_season,       serial[i]->m_season);
+        QCOMPARE(pooled[i]->m_episode,      serial[i]->m_episode);
+        QCOMPARE(pooled[i]->m_airdate,      serial[i]->m_airdate);
+        QCOMPARE(pooled[i]->m_categoryType, serial[i]->m_categoryType);
+        QCOMPARE(pooled[i]->HasCredits(),   serial[i]->HasCredits());
+    }
+
+    qDeleteAll(serial);
+    qDeleteAll(pooled);
+}
+
+void TestEITFixups::benchmarkFix_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("pool")   << 0;
+}
+
+void TestEITFixups::benchmarkFix()
+{
+    QFETCH(int, threads);
+
+    qint64 nsecs  = 0;
+    size_t events = 0;
+    QBENCHMARK
+    {
+        std::vector<DBEventEIT*> batch = BatchOfEvents(100);
+
+        QElapsedTimer timer;
+        timer.start();
+        EITFixUp::Fix(batch, threads);
+        nsecs  += timer.nsecsElapsed();
+        events += batch.size();
+
+        qDeleteAll(batch);
+    }
+
+    qDebug() << QString("%1 events/s")
+        .arg(events * 1000000000.0 / std::max(nsecs, qint64(1)), 0, 'f', 0);
+}
 
 QTEST_APPLESS_MAIN(TestEITFixups)
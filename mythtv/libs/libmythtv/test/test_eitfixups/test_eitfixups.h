@@ -18,6 +18,8 @@
  *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
  */
 
+#include <vector>
+
 #include <QtTest/QtTest>
 
 #include <eithelper.h> /* for FixupValue */
@@ -129,8 +131,12 @@ class TestEITFixups : public QObject
     static void testGreek3();
     static void testGreekCategories_data();
     static void testGreekCategories();
+    static void testFixBatch();
+    static void benchmarkFix_data();
+    static void benchmarkFix();
     static void cleanupTestCase();
 
   private:
     static DBEventEIT *SimpleDBEventEIT (FixupValue fix, const QString& title, const QString& subtitle, const QString& description);
+    static std::vector<DBEventEIT*> BatchOfEvents (int copies);
 };
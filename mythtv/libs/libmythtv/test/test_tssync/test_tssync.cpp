@@ -0,0 +1,168 @@
+/*
+ *  Class TestTSSync
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <random>
+#include <vector>
+
+#include "test_tssync.h"
+#include "tspacket.h"
+
+using capture_t = std::vector<unsigned char>;
+
+// A capture of in sync packets with random payloads. Every
+// 'corrupt_every' packets some junk is inserted so the stream
+// has to be resynchronized.
+static capture_t make_capture(uint packets, uint corrupt_every)
+{
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> junk(1, TSPacket::kSize - 1);
+
+    capture_t data;
+    data.reserve(packets * (TSPacket::kSize + 8));
+    for (uint i = 0; i < packets; ++i)
+    {
+        if (corrupt_every && i && (i % corrupt_every == 0))
+        {
+            int n = junk(gen);
+            for (int j = 0; j < n; ++j)
+                data.push_back(byte(gen));
+        }
+        data.push_back(SYNC_BYTE);
+        for (uint j = 1; j < TSPacket::kSize; ++j)
+            data.push_back(byte(gen));
+    }
+    return data;
+}
+
+// The packet walk done by MPEGStreamData::ProcessData(), minus the
+// packet handling, returning the number of packets found.
+static uint scan(const capture_t &data, TSSyncScanner::FindResyncFn resync)
+{
+    const unsigned char *buffer = data.data();
+    int len = data.size();
+    int pos = 0;
+    uint packets = 0;
+    while (pos + int(TSPacket::kSize) <= len)
+    {
+        if (buffer[pos] != SYNC_BYTE)
+        {
+            pos = resync(buffer, pos + 1, len);
+            if (pos < 0)
+                break;
+        }
+        pos += TSPacket::kSize;
+        packets++;
+    }
+    return packets;
+}
+
+void TestTSSync::initTestCase(void)
+{
+    qDebug() << "FindResync kernel:" << TSSyncScanner::KernelName();
+}
+
+void TestTSSync::InSyncPackets(void)
+{
+    capture_t data = make_capture(10, 0);
+    QCOMPARE(TSSyncScanner::InSyncPackets(data.data(), data.size()), 10U);
+    QCOMPARE(TSSyncScanner::InSyncPackets(data.data(), data.size() - 1), 9U);
+
+    data[5 * TSPacket::kSize] = 0x00;
+    QCOMPARE(TSSyncScanner::InSyncPackets(data.data(), data.size()), 5U);
+}
+
+void TestTSSync::FindResyncEdges(void)
+{
+    capture_t data(TSPacket::kSize * 3, 0x00);
+
+    // Not enough data to look for a following sync byte.
+    QCOMPARE(TSSyncScanner::FindResync(data.data(), 0, TSPacket::kSize), -1);
+
+    // Nothing to find.
+    QCOMPARE(TSSyncScanner::FindResync(data.data(), 0, data.size()), -2);
+
+    // A pair right at the end of the buffer.
+    int last = data.size() - 1;
+    data[last - TSPacket::kSize] = SYNC_BYTE;
+    data[last] = SYNC_BYTE;
+    QCOMPARE(TSSyncScanner::FindResync(data.data(), 0, data.size()),
+             last - int(TSPacket::kSize));
+
+    // A lone sync byte is not a match.
+    data[3] = SYNC_BYTE;
+    QCOMPARE(TSSyncScanner::FindResync(data.data(), 0, data.size()),
+             last - int(TSPacket::kSize));
+}
+
+void TestTSSync::FindResyncMatchesScalar_data(void)
+{
+    QTest::addColumn<uint>("corrupt_every");
+
+    QTest::newRow("clean")           << 0U;
+    QTest::newRow("corrupt 1/50")    << 50U;
+    QTest::newRow("corrupt 1/3")     << 3U;
+}
+
+void TestTSSync::FindResyncMatchesScalar(void)
+{
+    QFETCH(uint, corrupt_every);
+
+    capture_t data = make_capture(500, corrupt_every);
+    const unsigned char *buffer = data.data();
+    int len = data.size();
+
+    for (int pos = 0; pos < len; pos += 7)
+    {
+        QCOMPARE(TSSyncScanner::FindResync(buffer, pos, len),
+                 TSSyncScanner::FindResyncScalar(buffer, pos, len));
+    }
+    QCOMPARE(scan(data, TSSyncScanner::FindResync),
+             scan(data, TSSyncScanner::FindResyncScalar));
+}
+
+void TestTSSync::BenchmarkScan_data(void)
+{
+    QTest::addColumn<uint>("corrupt_every");
+    QTest::addColumn<bool>("scalar");
+
+    QTest::newRow("clean, scalar")         << 0U   << true;
+    QTest::newRow("clean, dispatched")     << 0U   << false;
+    QTest::newRow("corrupt 1/200, scalar")     << 200U << true;
+    QTest::newRow("corrupt 1/200, dispatched") << 200U << false;
+    QTest::newRow("corrupt 1/5, scalar")       << 5U   << true;
+    QTest::newRow("corrupt 1/5, dispatched")   << 5U   << false;
+}
+
+void TestTSSync::BenchmarkScan(void)
+{
+    QFETCH(uint, corrupt_every);
+    QFETCH(bool, scalar);
+
+    // The same size as the DVB stream handler's read buffer.
+    capture_t data = make_capture(15000, corrupt_every);
+    TSSyncScanner::FindResyncFn resync = scalar
+        ? TSSyncScanner::FindResyncScalar : TSSyncScanner::FindResync;
+
+    uint packets = 0;
+    QBENCHMARK {
+        packets = scan(data, resync);
+    }
+    QVERIFY(packets > 0);
+}
+
+QTEST_APPLESS_MAIN(TestTSSync)
@@ -0,0 +1,235 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: httpreactor.cpp
+//
+// Purpose     : Waits on idle HTTP connections for HttpServer
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "httpreactor.h"
+
+// C++ headers
+#include <array>
+#include <cerrno>
+#include <vector>
+
+// POSIX headers
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// MythTV headers
+#include "mythchrono.h"
+#include "mythlogging.h"
+#include "httpserver.h"
+
+#define LOC QString("HttpReactor: ")
+
+// How often idle connections are checked for their timeout
+static constexpr std::chrono::milliseconds kExpireInterval { 1s };
+static constexpr int kMaxEvents { 64 };
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpReactor::HttpReactor( HttpServer &httpServer )
+  : MThread( "HttpReactor" ),
+    m_httpServer( httpServer )
+{
+    m_epollFd = epoll_create1( EPOLL_CLOEXEC );
+    m_wakeFd  = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+
+    if ((m_epollFd >= 0) && (m_wakeFd >= 0))
+    {
+        struct epoll_event event {};
+        event.events  = EPOLLIN;
+        event.data.fd = m_wakeFd;
+
+        if (epoll_ctl( m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event ) == 0)
+            return;
+    }
+
+    LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to create epoll instance " + ENO);
+
+    if (m_epollFd >= 0)
+        close( m_epollFd );
+    if (m_wakeFd >= 0)
+        close( m_wakeFd );
+    m_epollFd = -1;
+    m_wakeFd  = -1;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+HttpReactor::~HttpReactor()
+{
+    Stop();
+
+    for (auto it = m_sockets.cbegin(); it != m_sockets.cend(); ++it)
+        close( it.key() );
+    m_sockets.clear();
+
+    if (m_epollFd >= 0)
+        close( m_epollFd );
+    if (m_wakeFd >= 0)
+        close( m_wakeFd );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Takes over a connection that is waiting for its next request.  It is
+// closed if no request arrives within timeout.
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpReactor::Park( int nSocket, std::chrono::milliseconds timeout )
+{
+    QMutexLocker locker( &m_lock );
+
+    if (m_stop || !IsValid())
+    {
+        close( nSocket );
+        return;
+    }
+
+    m_sockets.insert( nSocket, std::chrono::steady_clock::now() + timeout );
+
+    // One shot, so the connection is only handed back once
+    struct epoll_event event {};
+    event.events  = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.fd = nSocket;
+
+    if (epoll_ctl( m_epollFd, EPOLL_CTL_ADD, nSocket, &event ) < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to watch connection %1 ").arg(nSocket) + ENO);
+        m_sockets.remove( nSocket );
+        close( nSocket );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpReactor::Stop()
+{
+    {
+        QMutexLocker locker( &m_lock );
+        m_stop = true;
+    }
+
+    if (m_wakeFd >= 0)
+    {
+        uint64_t nWake = 1;
+        if (write( m_wakeFd, &nWake, sizeof(nWake) ) < 0)
+            LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to wake reactor " + ENO);
+    }
+
+    wait();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpReactor::run()
+{
+    RunProlog();
+
+    LOG(VB_HTTP, LOG_INFO, LOC + "Started");
+
+    std::array<struct epoll_event, kMaxEvents> events {};
+    std::vector<int> ready;
+
+    while (true)
+    {
+        int nEvents = epoll_wait( m_epollFd, events.data(), kMaxEvents,
+                                  kExpireInterval.count() );
+
+        if ((nEvents < 0) && (errno != EINTR))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "epoll_wait failed " + ENO);
+            break;
+        }
+
+        {
+            QMutexLocker locker( &m_lock );
+
+            if (m_stop)
+                break;
+
+            for (int nIdx = 0; nIdx < nEvents; ++nIdx)
+            {
+                int      nSocket = events[nIdx].data.fd;
+                uint32_t nFlags  = events[nIdx].events;
+
+                if (nSocket == m_wakeFd)
+                    continue;
+
+                epoll_ctl( m_epollFd, EPOLL_CTL_DEL, nSocket, nullptr );
+
+                if (m_sockets.remove( nSocket ) == 0)
+                    continue;
+
+                // A client may send its last request and then shut down
+                // its side, so only a hang up without data is dropped
+                if (((nFlags & (EPOLLERR | EPOLLHUP)) != 0) ||
+                    ((nFlags & EPOLLIN) == 0))
+                {
+                    Close( nSocket );
+                    continue;
+                }
+
+                ready.push_back( nSocket );
+            }
+
+            Expire();
+        }
+
+        // Started outside of the lock, a worker may want to park another
+        // connection meanwhile
+        for (int nSocket : ready)
+            m_httpServer.ResumeConnection( nSocket );
+        ready.clear();
+    }
+
+    LOG(VB_HTTP, LOG_INFO, LOC + "Stopped");
+
+    RunEpilog();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Closes the connections that have been idle for too long, needs m_lock.
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpReactor::Expire()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto it = m_sockets.begin(); it != m_sockets.end(); )
+    {
+        if (*it > now)
+        {
+            ++it;
+            continue;
+        }
+
+        epoll_ctl( m_epollFd, EPOLL_CTL_DEL, it.key(), nullptr );
+        Close( it.key() );
+        it = m_sockets.erase( it );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpReactor::Close( int nSocket )
+{
+    LOG(VB_HTTP, LOG_INFO, LOC + QString("Connection %1 closed").arg(nSocket));
+
+    close( nSocket );
+}
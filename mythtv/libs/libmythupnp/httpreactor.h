@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: httpreactor.h
+//
+// Purpose     : Waits on idle HTTP connections for HttpServer
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef HTTPREACTOR_H
+#define HTTPREACTOR_H
+
+#include <chrono>
+
+#include <QHash>
+#include <QMutex>
+
+#include "mthread.h"
+
+class HttpServer;
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Watches connections that are waiting for their next request with epoll,
+// so that an idle keep-alive connection does not hold on to a thread of
+// HttpServer's pool.
+//
+// HttpServer parks every new plain TCP connection here, and an HttpWorker
+// parks its connection again once it has answered all the requests the
+// client has sent so far.  When a request arrives the connection is
+// handed back to HttpServer, which starts a worker for it on the pool.
+// Connections that stay idle for longer than their timeout are closed.
+//
+// Parked connections are plain socket descriptors, so SSL connections,
+// whose state lives in their QSslSocket, are never parked.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+class HttpReactor : public MThread
+{
+    public:
+
+        explicit HttpReactor( HttpServer &httpServer );
+        ~HttpReactor() override;
+
+        bool    IsValid () const { return m_epollFd >= 0; }
+
+        void    Park    ( int nSocket, std::chrono::milliseconds timeout );
+        void    Stop    ();
+
+    protected:
+
+        void    run     () override; // MThread
+
+    private:
+
+        using Deadline = std::chrono::steady_clock::time_point;
+
+        void    Expire  ();
+        void    Close   ( int nSocket );
+
+        HttpServer            &m_httpServer;
+        int                    m_epollFd  {-1};
+        int                    m_wakeFd   {-1};    // eventfd, for Stop()
+
+        QMutex                 m_lock;
+        QHash<int, Deadline>   m_sockets;          // parked, by descriptor
+        bool                   m_stop     {false};
+};
+
+#endif // HTTPREACTOR_H
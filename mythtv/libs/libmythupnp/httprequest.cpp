@@ -49,9 +49,11 @@
 
 #include "serializers/xmlSerializer.h"
 #include "serializers/soapSerializer.h"
-#include "serializers/jsonSerializer.h"
+#include "serializers/bufferedJsonSerializer.h"
 #include "serializers/xmlplistSerializer.h"
 
+#include "httpresponsestream.h"
+
 #include <unistd.h> // for gethostname
 
 #ifndef O_LARGEFILE
@@ -161,6 +163,15 @@ const char *HTTPRequest::s_szServerHeaders = "Accept-Ranges: bytes\r\n";
 //
 /////////////////////////////////////////////////////////////////////////////
 
+HTTPRequest::~HTTPRequest()
+{
+    delete m_pResponseStream;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 QString HTTPRequest::GetLastHeader( const QString &sType ) const
 {
     QStringList values = m_mapHeaders.values( sType );
@@ -243,7 +254,9 @@ QString HTTPRequest::BuildResponseHeader( long long nSize )
             SetResponseHeader("Content-Disposition", QString("inline; filename=\"%2\"").arg(QString(filename.toLatin1())));
         }
 
-        SetResponseHeader("Content-Length", QString::number(nSize));
+        // A negative size is a chunked response, see HTTPResponseStream
+        if (nSize >= 0)
+            SetResponseHeader("Content-Length", QString::number(nSize));
 
         // See DLNA  7.4.1.3.11.4.3 Tolerance to unavailable contentFeatures.dlna.org header
         //
@@ -312,6 +325,18 @@ qint64 HTTPRequest::SendResponse( void )
 {
     qint64      nBytes    = 0;
 
+    // ----------------------------------------------------------------------
+    // A streamed response has been sent already, bar its last chunk
+    // ----------------------------------------------------------------------
+
+    if ((m_pResponseStream != nullptr) && m_pResponseStream->IsStreaming())
+    {
+        LOG(VB_HTTP, LOG_INFO,
+            QString("HTTPRequest::SendResponse( Streamed ) :%1 -> %2:")
+                .arg(GetResponseStatus(), GetPeerAddress()));
+        return( m_pResponseStream->Finish() );
+    }
+
     switch( m_eResponseType )
     {
         // The following are all eligable for gzip compression
@@ -415,12 +440,7 @@ qint64 HTTPRequest::SendResponse( void )
 
     QBuffer compBuffer;
 
-    auto values = m_mapHeaders.values("accept-encoding");
-    bool gzip_found = std::any_of(values.cbegin(), values.cend(),
-                                  [](const auto & value)
-                                      {return value.contains( "gzip" ); });
-
-    if (( nContentLen > 0 ) && gzip_found)
+    if (( nContentLen > 0 ) && AcceptsGzip())
     {
         QByteArray compressed = gzipCompress( m_response.buffer() );
         compBuffer.setData( compressed );
@@ -1210,6 +1230,18 @@ QString HTTPRequest::GetResponseHeaders( void )
 //
 /////////////////////////////////////////////////////////////////////////////
 
+bool HTTPRequest::AcceptsGzip() const
+{
+    auto values = m_mapHeaders.values("accept-encoding");
+    return std::any_of(values.cbegin(), values.cend(),
+                       [](const auto & value)
+                           {return value.contains( "gzip" ); });
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 bool HTTPRequest::ParseKeepAlive()
 {
     // TODO: Think about whether we should use a longer timeout if the client
@@ -1771,10 +1803,11 @@ bool HTTPRequest::ProcessSOAPPayload( const QString &sSOAPAction )
 Serializer *HTTPRequest::GetSerializer()
 {
     Serializer *pSerializer = nullptr;
+    QIODevice  *pDevice     = GetResponseDevice();
 
     if (m_bSOAPRequest)
     {
-        pSerializer = (Serializer *)new SoapSerializer(&m_response,
+        pSerializer = (Serializer *)new SoapSerializer(pDevice,
                                                        m_sNameSpace, m_sMethod);
     }
     else
@@ -1784,23 +1817,62 @@ Serializer *HTTPRequest::GetSerializer()
         if (sAccept.contains( "application/json", Qt::CaseInsensitive ) ||
             sAccept.contains( "text/javascript", Qt::CaseInsensitive ))
         {
-            pSerializer = (Serializer *)new JSONSerializer(&m_response,
-                                                           m_sMethod);
+            pSerializer = (Serializer *)new BufferedJSONSerializer(pDevice,
+                                                                   m_sMethod);
         }
         else if (sAccept.contains( "text/x-apple-plist+xml", Qt::CaseInsensitive ))
         {
-            pSerializer = (Serializer *)new XmlPListSerializer(&m_response);
+            pSerializer = (Serializer *)new XmlPListSerializer(pDevice);
         }
     }
 
     // Default to XML
 
     if (pSerializer == nullptr)
-        pSerializer = (Serializer *)new XmlSerializer(&m_response, m_sMethod);
+        pSerializer = (Serializer *)new XmlSerializer(pDevice, m_sMethod);
+
+    // The response may start going out before FormatActionResponse() is
+    // called, so it has to be described up front.
+
+    if (pDevice != &m_response)
+    {
+        m_eResponseType     = ResponseTypeOther;
+        m_sResponseTypeText = pSerializer->GetContentType();
+        m_nResponseStatus   = 200;
+
+        pSerializer->AddHeaders( m_mapRespHeaders );
+    }
 
     return pSerializer;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Returns the device to write the response body to.  When the client can
+// take a chunked response, a large body is sent as it is written instead
+// of being held in m_response, see HTTPResponseStream.
+/////////////////////////////////////////////////////////////////////////////
+
+QIODevice *HTTPRequest::GetResponseDevice()
+{
+    if (m_pResponseStream != nullptr)
+        return m_pResponseStream;
+
+    // Chunked encoding needs HTTP/1.1, and a client revalidating its copy
+    // needs the ETag a streamed response can't have.
+
+    if ((m_eType == RequestTypeHead) ||
+        (m_nMajor < 1) || ((m_nMajor == 1) && (m_nMinor < 1)) ||
+        !GetRequestHeader( "If-None-Match", "" ).isEmpty())
+    {
+        return &m_response;
+    }
+
+    m_pResponseStream = new HTTPResponseStream( this );
+    m_pResponseStream->open( QIODevice::WriteOnly | QIODevice::Unbuffered );
+
+    return m_pResponseStream;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
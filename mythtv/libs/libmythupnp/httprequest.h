@@ -30,6 +30,8 @@
 #include "upnputil.h"
 #include "serializers/serializer.h"
 
+class HTTPResponseStream;
+
 #define SOAP_ENVELOPE_BEGIN  "<s:Envelope xmlns:s=\"htstp://schemas.xmlsoap.org/soap/envelope/\" " \
                              "s:encodingStyle=\"http://schemas.xmlsoap.org/soap/encoding/\">"     \
                              "<s:Body>"
@@ -107,6 +109,8 @@ class IPostProcess
 
 class UPNP_PUBLIC HTTPRequest
 {
+    friend class HTTPResponseStream;
+
     protected:
 
         static const char  *s_szServerHeaders;
@@ -165,6 +169,8 @@ class UPNP_PUBLIC HTTPRequest
         bool                m_bKeepAlive        {true};
         std::chrono::seconds m_nKeepAliveTimeout {0s};
 
+        HTTPResponseStream *m_pResponseStream   {nullptr};
+
     protected:
 
         HttpRequestType SetRequestType      ( const QString &sType  );
@@ -185,6 +191,7 @@ class UPNP_PUBLIC HTTPRequest
                                               long long *pllEnd   );
 
         bool            ParseKeepAlive      ( void );
+        bool            AcceptsGzip         ( void ) const;
 
         void            ParseCookies        ( void );
 
@@ -207,7 +214,7 @@ class UPNP_PUBLIC HTTPRequest
     public:
 
                         HTTPRequest     () { m_response.open( QIODevice::ReadWrite ); }
-        virtual        ~HTTPRequest     () = default;
+        virtual        ~HTTPRequest     ();
 
         bool            ParseRequest    ();
 
@@ -236,6 +243,7 @@ class UPNP_PUBLIC HTTPRequest
         bool            GetKeepAlive () const { return m_bKeepAlive; }
 
         Serializer *    GetSerializer   ();
+        QIODevice *     GetResponseDevice   ();
 
         QByteArray      GetResponsePage     ( void ); // Static response e.g. 400, 404, 501
 
@@ -0,0 +1,230 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: httpresponsestream.cpp
+//
+// Purpose     : Streams a response body with chunked transfer encoding
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "httpresponsestream.h"
+
+#include <zlib.h>
+#undef Z_NULL
+#define Z_NULL nullptr
+
+#include "mythlogging.h"
+#include "httprequest.h"
+
+#define LOC QString("HTTPResponseStream: ")
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+HTTPResponseStream::HTTPResponseStream( HTTPRequest *pRequest )
+  : m_pRequest( pRequest )
+{
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+HTTPResponseStream::~HTTPResponseStream()
+{
+    if (m_pZStream != nullptr)
+    {
+        deflateEnd( m_pZStream );
+        delete m_pZStream;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+qint64 HTTPResponseStream::readData( char */*pData*/, qint64 /*nMaxLen*/ )
+{
+    return -1;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+qint64 HTTPResponseStream::writeData( const char *pData, qint64 nLen )
+{
+    if (m_bError || m_bFinished)
+        return -1;
+
+    if (!m_bStreaming)
+    {
+        if (m_pRequest->m_response.write( pData, nLen ) != nLen)
+            return -1;
+
+        if (m_pRequest->m_response.size() < kStreamThreshold)
+            return nLen;
+
+        return Begin() ? nLen : -1;
+    }
+
+    m_pending.append( pData, static_cast<int>(nLen) );
+
+    if ((m_pending.size() >= kChunkSize) && !SendPending( false ))
+        return -1;
+
+    return nLen;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Sends the headers and what has been written so far
+//////////////////////////////////////////////////////////////////////////////
+
+bool HTTPResponseStream::Begin()
+{
+    m_bStreaming = true;
+
+    // Take over what was kept in the response buffer, without copying it
+    m_pending = m_pRequest->m_response.buffer();
+    m_pRequest->m_response.buffer().clear();
+    m_pRequest->m_response.seek( 0 );
+
+    m_pRequest->m_mapRespHeaders.remove( "ETag" );
+    m_pRequest->SetResponseHeader( "Transfer-Encoding", "chunked", true );
+
+    if (m_pRequest->AcceptsGzip())
+    {
+        m_pZStream = new z_stream {};
+
+        int ret = deflateInit2( m_pZStream,
+                                Z_DEFAULT_COMPRESSION,
+                                Z_DEFLATED,
+                                15 + 16,
+                                8,
+                                Z_DEFAULT_STRATEGY ); // gzip encoding
+        if (ret == Z_OK)
+        {
+            m_pRequest->SetResponseHeader( "Content-Encoding", "gzip", true );
+        }
+        else
+        {
+            delete m_pZStream;
+            m_pZStream = nullptr;
+        }
+    }
+
+    QByteArray sHeader = m_pRequest->BuildResponseHeader( -1 ).toUtf8();
+
+    if (m_pRequest->WriteBlock( sHeader.constData(), sHeader.length() )
+        < sHeader.length())
+    {
+        LOG(VB_HTTP, LOG_ERR, LOC + "Error writing response header");
+        m_bError = true;
+        return false;
+    }
+
+    m_nBytesSent = sHeader.length();
+
+    LOG(VB_HTTP, LOG_DEBUG, LOC + QString("Streaming response%1")
+        .arg((m_pZStream != nullptr) ? " (gzip)" : ""));
+
+    return SendPending( false );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Sends m_pending, through the deflate stream when there is one.  Deflate
+// keeps back what it can't compress yet, until bFinish ends the stream.
+//////////////////////////////////////////////////////////////////////////////
+
+bool HTTPResponseStream::SendPending( bool bFinish )
+{
+    if (m_pZStream == nullptr)
+    {
+        bool bOk = m_pending.isEmpty() ||
+                   WriteChunk( m_pending.constData(), m_pending.size() );
+        m_pending.clear();
+        return bOk;
+    }
+
+    m_pZStream->next_in  = reinterpret_cast<Bytef*>(m_pending.data());
+    m_pZStream->avail_in = m_pending.size();
+
+    m_compressed.resize( kChunkSize );
+
+    do
+    {
+        m_pZStream->next_out  = reinterpret_cast<Bytef*>(m_compressed.data());
+        m_pZStream->avail_out = kChunkSize;
+
+        if (deflate( m_pZStream, bFinish ? Z_FINISH : Z_NO_FLUSH ) == Z_STREAM_ERROR)
+        {
+            LOG(VB_HTTP, LOG_ERR, LOC + "Error compressing response");
+            m_bError = true;
+            return false;
+        }
+
+        qint64 nHave = kChunkSize - m_pZStream->avail_out;
+
+        if ((nHave > 0) && !WriteChunk( m_compressed.constData(), nHave ))
+            return false;
+    }
+    while (m_pZStream->avail_out == 0);
+
+    m_pending.clear();
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+bool HTTPResponseStream::WriteChunk( const char *pData, qint64 nLen )
+{
+    QByteArray sSize = QByteArray::number( nLen, 16 ) + "\r\n";
+
+    if ((m_pRequest->WriteBlock( sSize.constData(), sSize.length() ) < sSize.length()) ||
+        (m_pRequest->WriteBlock( pData, nLen ) < nLen) ||
+        (m_pRequest->WriteBlock( "\r\n", 2 ) < 2))
+    {
+        LOG(VB_HTTP, LOG_ERR, LOC + "Error writing chunk");
+        m_bError = true;
+        return false;
+    }
+
+    m_nBytesSent += sSize.length() + nLen + 2;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Sends the rest of a streamed response and the last chunk.
+//
+// Returns the bytes sent in all, 0 if the response was not streamed and
+// -1 if it could not be completed, so the connection has to be closed.
+//////////////////////////////////////////////////////////////////////////////
+
+qint64 HTTPResponseStream::Finish()
+{
+    if (!m_bStreaming)
+        return 0;
+
+    if (!m_bFinished)
+    {
+        m_bFinished = true;
+
+        if (m_bError || !SendPending( true ) ||
+            (m_pRequest->WriteBlock( "0\r\n\r\n", 5 ) < 5))
+        {
+            LOG(VB_HTTP, LOG_ERR, LOC + "Error ending streamed response");
+            m_bError = true;
+        }
+        else
+        {
+            m_nBytesSent += 5;
+        }
+    }
+
+    return m_bError ? -1 : m_nBytesSent;
+}
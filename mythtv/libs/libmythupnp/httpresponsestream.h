@@ -0,0 +1,76 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: httpresponsestream.h
+//
+// Purpose     : Streams a response body with chunked transfer encoding
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef HTTPRESPONSESTREAM_H_
+#define HTTPRESPONSESTREAM_H_
+
+#include <QByteArray>
+#include <QIODevice>
+
+#include "upnpexp.h"
+
+class HTTPRequest;
+struct z_stream_s;
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Device a response body can be written to while it is still being
+// generated.
+//
+// Writes are kept in HTTPRequest::m_response until kStreamThreshold bytes
+// have been written.  A response that stays smaller is sent by
+// HTTPRequest::SendResponse() as before, with a Content-Length and ETag.
+// Once the threshold is crossed the headers are sent with
+// "Transfer-Encoding: chunked" and the body follows in chunks as it is
+// written, gzip'd with one incremental deflate stream if the client
+// accepts it.  HTTPRequest::SendResponse() then only ends the stream.
+//
+// Streamed responses have no ETag, since it is only known once the whole
+// body has been generated.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+class UPNP_PUBLIC HTTPResponseStream : public QIODevice
+{
+    public:
+
+        static constexpr qint64 kStreamThreshold { 64LL * 1024 };
+        static constexpr int    kChunkSize       { 32 * 1024 };
+
+        explicit HTTPResponseStream( HTTPRequest *pRequest );
+        ~HTTPResponseStream() override;
+
+        bool    isSequential() const override { return true; } // QIODevice
+
+        bool    IsStreaming () const { return m_bStreaming; }
+        qint64  Finish      ();
+
+    protected:
+
+        qint64  readData    ( char *pData, qint64 nMaxLen ) override; // QIODevice
+        qint64  writeData   ( const char *pData, qint64 nLen ) override; // QIODevice
+
+    private:
+
+        bool    Begin       ();
+        bool    SendPending ( bool bFinish );
+        bool    WriteChunk  ( const char *pData, qint64 nLen );
+
+        HTTPRequest        *m_pRequest   {nullptr};
+        bool                m_bStreaming {false};
+        bool                m_bFinished  {false};
+        bool                m_bError     {false};
+        qint64              m_nBytesSent {0};
+
+        struct z_stream_s  *m_pZStream   {nullptr};   // nullptr unless gzip'd
+        QByteArray          m_pending;                // written, not sent yet
+        QByteArray          m_compressed;
+};
+
+#endif // HTTPRESPONSESTREAM_H_
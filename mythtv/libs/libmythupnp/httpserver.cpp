@@ -20,7 +20,9 @@
 
 // POSIX headers
 #ifndef _WIN32
+#include <fcntl.h>
 #include <sys/utsname.h> 
+#include <unistd.h>
 #endif
 
 // Qt headers
@@ -43,6 +45,10 @@
 
 #include "serviceHosts/rttiServiceHost.h"
 
+#ifdef __linux__
+#include "httpreactor.h"
+#endif
+
 /**
  * \brief Handle an OPTIONS request
  */
@@ -158,6 +164,29 @@ HttpServer::HttpServer() :
     RegisterExtension( new RttiServiceHost( m_sSharePath ));
 
     LoadSSLConfig();
+
+#ifdef __linux__
+    // ----------------------------------------------------------------------
+    // Wait for requests on idle connections with epoll, so the pool only
+    // needs a thread per request being handled, not per connection.
+    // ----------------------------------------------------------------------
+
+    if (gCoreContext->GetBoolSetting("HTTP/EventDriven", true))
+    {
+        m_pReactor = new HttpReactor(*this);
+
+        if (m_pReactor->IsValid())
+        {
+            m_pReactor->start();
+            LOG(VB_HTTP, LOG_NOTICE, "HttpServer(): Event driven connections");
+        }
+        else
+        {
+            delete m_pReactor;
+            m_pReactor = nullptr;
+        }
+    }
+#endif
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -170,8 +199,20 @@ HttpServer::~HttpServer()
     m_running = false;
     m_rwlock.unlock();
 
+    // Stop handing connections to the pool before stopping it, and let the
+    // workers finish before the reactor they park connections in goes
+    if (m_pReactor)
+        m_pReactor->Stop();
+
     m_threadPool.Stop();
 
+    if (m_pReactor)
+    {
+        m_threadPool.waitForDone();
+        delete m_pReactor;
+        m_pReactor = nullptr;
+    }
+
     while (!m_extensions.empty())
     {
         delete m_extensions.takeFirst();
@@ -302,6 +343,13 @@ void HttpServer::newTcpConnection(qt_socket_fd_t socket)
     if (server)
         type = server->GetServerType();
 
+    // Nothing needs to wait for a plain connection to send its request
+    if (m_pReactor && type == kTCPServer)
+    {
+        m_pReactor->Park(static_cast<int>(socket), 5s);
+        return;
+    }
+
     m_threadPool.startReserved(
         new HttpWorker(*this, socket, type
 #ifndef QT_NO_OPENSSL
@@ -311,6 +359,23 @@ void HttpServer::newTcpConnection(qt_socket_fd_t socket)
         QString("HttpServer%1").arg(socket));
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Called by the reactor when a request arrives on a parked connection.
+// Like a new connection it gets a thread of its own, so that requests are
+// not queued behind long running file and stream responses.
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpServer::ResumeConnection(qt_socket_fd_t socket)
+{
+    m_threadPool.startReserved(
+        new HttpWorker(*this, socket, kTCPServer
+#ifndef QT_NO_OPENSSL
+                       , m_sslConfig
+#endif
+                       , m_pReactor),
+        QString("HttpServer%1").arg(socket));
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -447,9 +512,11 @@ HttpWorker::HttpWorker(HttpServer &httpServer, qt_socket_fd_t sock,
 #ifndef QT_NO_OPENSSL
                        , const QSslConfiguration& sslConfig
 #endif
+                       , HttpReactor *pReactor
 )
            : m_httpServer(httpServer), m_socket(sock),
-             m_socketTimeout(5s), m_connectionType(type)
+             m_socketTimeout(5s), m_connectionType(type),
+             m_pReactor(pReactor)
 #ifndef QT_NO_OPENSSL
              , m_sslConfig(sslConfig)
 #endif
@@ -527,12 +594,27 @@ void HttpWorker::run(void)
 
     pSocket->setSocketOption(QAbstractSocket::KeepAliveOption, QVariant(1));
     int nRequestsHandled = 0; // Allow debugging of keep-alive and connection re-use
+    int nParkedSocket    = -1;
 
     try
     {
         while (m_httpServer.IsRunning() && bKeepAlive && pSocket->isValid() &&
                pSocket->state() == QAbstractSocket::ConnectedState)
         {
+#ifdef __linux__
+            // Once the requests received so far have been answered, leave
+            // waiting for the next one to the reactor.  Closing pSocket
+            // only closes its own descriptor, not the connection.
+            if (m_pReactor && nRequestsHandled > 0 &&
+                pSocket->bytesAvailable() == 0)
+            {
+                nParkedSocket = fcntl(pSocket->socketDescriptor(),
+                                      F_DUPFD_CLOEXEC, 0);
+                if (nParkedSocket >= 0)
+                    break;
+            }
+#endif
+
             // We set a timeout on keep-alive connections to avoid blocking
             // new clients from connecting - Default at time of writing was
             // 5 seconds for initial connection, then up to 10 seconds of idle
@@ -679,15 +761,29 @@ void HttpWorker::run(void)
                                             .arg(pSocket->errorString()));
     }
 
-    LOG(VB_HTTP, LOG_INFO, QString("HttpWorker(%1): Connection %2 closed. %3 requests were handled")
+#ifdef __linux__
+    if (nParkedSocket >= 0 && pSocket->bytesToWrite() > 0)
+    {
+        close(nParkedSocket);
+        nParkedSocket = -1;
+    }
+#endif
+
+    LOG(VB_HTTP, LOG_INFO, QString("HttpWorker(%1): Connection %2 %3. %4 requests were handled")
                                         .arg(m_socket)
                                         .arg(pSocket->socketDescriptor())
+                                        .arg(nParkedSocket >= 0 ? "parked" : "closed")
                                         .arg(nRequestsHandled));
 
     pSocket->close();
     delete pSocket;
     pSocket = nullptr;
 
+#ifdef __linux__
+    if (nParkedSocket >= 0)
+        m_pReactor->Park(nParkedSocket, m_socketTimeout);
+#endif
+
 #if 0
     LOG(VB_HTTP, LOG_DEBUG, "HttpWorkerThread::run() -- end");
 #endif
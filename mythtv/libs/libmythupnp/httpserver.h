@@ -43,6 +43,7 @@
 #include "compat.h"
 
 class HttpWorkerThread;
+class HttpReactor;
 class QScriptEngine;
 class HttpServer;
 #ifndef QT_NO_OPENSSL
@@ -111,6 +112,8 @@ class UPNP_PUBLIC HttpServer : public ServerPool
 {
     Q_OBJECT
 
+    friend class HttpReactor;
+
   public:
     HttpServer();
     ~HttpServer() override;
@@ -146,6 +149,7 @@ class UPNP_PUBLIC HttpServer : public ServerPool
     QMultiMap< QString, HttpServerExtension* >  m_basePaths;
     QString                 m_sSharePath;
     MThreadPool             m_threadPool;
+    HttpReactor            *m_pReactor   { nullptr }; // Linux only
     bool                    m_running    { true }; // protected by m_rwlock
 
     static QMutex           s_platformLock;
@@ -162,6 +166,7 @@ class UPNP_PUBLIC HttpServer : public ServerPool
 
   private:
     void LoadSSLConfig();
+    void ResumeConnection(qt_socket_fd_t socket);
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -181,11 +186,14 @@ class HttpWorker : public QRunnable
      * \param sock       The socket
      * \param type       The type of connection - Plain TCP, SSL or other?
      * \param sslConfig  The SSL configuration (for SSL sockets)
+     * \param pReactor   Where to park the connection between requests,
+     *                   nullptr to wait for them on this worker's thread
      */
     HttpWorker(HttpServer &httpServer, qt_socket_fd_t sock, PoolServerType type
 #ifndef QT_NO_OPENSSL
                , const QSslConfiguration& sslConfig
 #endif
+               , HttpReactor *pReactor = nullptr
     );
 
     void run(void) override; // QRunnable
@@ -195,6 +203,7 @@ class HttpWorker : public QRunnable
     qt_socket_fd_t m_socket;
     std::chrono::milliseconds m_socketTimeout;
     PoolServerType m_connectionType;
+    HttpReactor   *m_pReactor;
 
 #ifndef QT_NO_OPENSSL
     QSslConfiguration       m_sslConfig;
@@ -27,7 +27,7 @@ HEADERS += configuration.h
 HEADERS += soapclient.h mythxmlclient.h mmembuf.h upnpexp.h
 HEADERS += upnpserviceimpl.h
 HEADERS += servicehost.h wsdl.h htmlserver.h xsd.h
-HEADERS += upnphelpers.h websocket.h
+HEADERS += upnphelpers.h websocket.h httpresponsestream.h
 
 HEADERS += services/rtti.h
 HEADERS += serviceHosts/rttiServiceHost.h
@@ -35,6 +35,7 @@ HEADERS += serviceHosts/rttiServiceHost.h
 HEADERS += serializers/serializer.h     serializers/xmlSerializer.h 
 HEADERS += serializers/jsonSerializer.h serializers/soapSerializer.h
 HEADERS += serializers/xmlplistSerializer.h
+HEADERS += serializers/bufferedJsonSerializer.h
 
 HEADERS += websocket_extensions/*.h
 
@@ -42,6 +43,8 @@ SOURCES += mmulticastsocketdevice.cpp
 SOURCES += msocketdevice.cpp
 unix:SOURCES += msocketdevice_unix.cpp
 mingw | win32-msvc*:SOURCES += msocketdevice_win.cpp
+linux:HEADERS += httpreactor.h
+linux:SOURCES += httpreactor.cpp
 SOURCES += httprequest.cpp upnp.cpp ssdp.cpp taskqueue.cpp upnputil.cpp
 SOURCES += upnpdevice.cpp upnptasknotify.cpp upnptasksearch.cpp
 SOURCES += httpserver.cpp upnpcds.cpp upnpcdsobjects.cpp bufferedsocketdevice.cpp
@@ -50,13 +53,14 @@ SOURCES += configuration.cpp soapclient.cpp mythxmlclient.cpp mmembuf.cpp
 SOURCES += upnpserviceimpl.cpp
 SOURCES += htmlserver.cpp
 SOURCES += servicehost.cpp wsdl.cpp upnpsubscription.cpp xsd.cpp
-SOURCES += upnphelpers.cpp websocket.cpp
+SOURCES += upnphelpers.cpp websocket.cpp httpresponsestream.cpp
 
 SOURCES += services/rtti.cpp
 
 SOURCES += serializers/serializer.cpp     serializers/xmlSerializer.cpp
 SOURCES += serializers/jsonSerializer.cpp 
 SOURCES += serializers/xmlplistSerializer.cpp
+SOURCES += serializers/bufferedJsonSerializer.cpp
 
 SOURCES += websocket_extensions/*.cpp
 
@@ -98,6 +102,7 @@ inc.files += xsd.h upnphelpers.h
 
 inc.files += serializers/serializer.h     serializers/xmlSerializer.h 
 inc.files += serializers/jsonSerializer.h serializers/soapSerializer.h
+inc.files += serializers/bufferedJsonSerializer.h
 
 INSTALLS += inc
 
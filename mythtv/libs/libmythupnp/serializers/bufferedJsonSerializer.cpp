@@ -0,0 +1,393 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: bufferedJsonSerializer.cpp
+//
+// Purpose     : Serialization Implementation for JSON, writing UTF-8
+//               straight into a buffer
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "bufferedJsonSerializer.h"
+#include "mythdate.h"
+
+#include <QVariant>
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+BufferedJSONSerializer::BufferedJSONSerializer( QIODevice     *pDevice,
+                                                const QString &sRequestName )
+  : m_pDevice( pDevice )
+{
+    Q_UNUSED(sRequestName)
+
+    m_buffer.reserve( kInitialBufferSize );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+QString BufferedJSONSerializer::GetContentType()
+{
+    return "application/json";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::Serialize( const QObject *pObject, const QString &_sName )
+{
+    QString sName = _sName;
+
+    if (sName.isEmpty())
+        sName = pObject->objectName();
+
+    if (sName.isEmpty())
+    {
+        sName = pObject->metaObject()->className();
+
+        sName = sName.section( ":", -1 );
+
+        if ((sName.length() > 0) && (sName.at(0) == 'Q'))
+            sName = sName.mid( 1 );
+    }
+
+    // ---------------------------------------------------------------
+
+    m_hash.reset();
+
+    QByteArray sUtf8Name = sName.toUtf8();
+    m_hash.addData( sUtf8Name );
+
+    m_bHash = true;
+
+    m_buffer += "{\"";
+    m_buffer += sUtf8Name;
+    m_buffer += "\": {";
+
+    RenderObject( pObject );
+
+    m_buffer += "}}";
+
+    Flush();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::Serialize( const QVariant &vValue, const QString &_sName )
+{
+    QString sName( _sName );
+
+    if ((sName.length() > 0) && sName.at(0) == 'Q')
+        sName = sName.mid( 1 );
+
+    if ( !vValue.isNull() )
+        m_hash.addData( vValue.toString().toUtf8() );
+
+    // The whole value is already in the hash
+    m_bHash = false;
+
+    m_buffer += "{\"";
+    m_buffer += sName.toUtf8();
+    m_buffer += "\": ";
+
+    RenderValue( vValue );
+
+    m_buffer += "}";
+
+    Flush();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Serialize() above does not go through these, they only exist to write
+// the same as JSONSerializer if a subclass does.
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::BeginObject( const QString &sName, const QObject  */*pObject*/ )
+{
+    m_buffer += "\"";
+    m_buffer += sName.toUtf8();
+    m_buffer += "\": {";
+
+    m_bCommaNeeded = false;
+}
+
+void BufferedJSONSerializer::EndObject( const QString &/*sName*/, const QObject  */*pObject*/ )
+{
+    m_buffer += "}";
+
+    m_bCommaNeeded = true;
+}
+
+void BufferedJSONSerializer::AddProperty( const QString       &sName,
+                                          const QVariant      &vValue,
+                                          const QMetaObject   */*pMetaParent*/,
+                                          const QMetaProperty */*pMetaProp*/ )
+{
+    if (m_bCommaNeeded)
+        m_buffer += ", ";
+
+    m_buffer += "\"";
+    m_buffer += sName.toUtf8();
+    m_buffer += "\": ";
+
+    RenderValue( vValue );
+
+    m_bCommaNeeded = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::RenderObject( const QObject *pObject )
+{
+    if (pObject == nullptr)
+        return;
+
+    bool bHash        = m_bHash;
+    bool bCommaNeeded = false;
+
+    for (const auto &prop : GetPlan( pObject->metaObject() ))
+    {
+        if (bCommaNeeded)
+            m_buffer += ", ";
+
+        m_buffer += "\"";
+        m_buffer += prop.m_utf8Name;
+        m_buffer += "\": ";
+
+        m_bHash = bHash && !prop.m_transient;
+
+        if (m_bHash)
+            m_hash.addData( prop.m_utf8Name );
+
+        RenderValue( prop.m_meta.read( pObject ) );
+
+        bCommaNeeded = true;
+    }
+
+    m_bHash = bHash;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::RenderValue( const QVariant &vValue )
+{
+    // -----------------------------------------------------------------------
+    // See if this value is actually a child object
+    // -----------------------------------------------------------------------
+
+    if ( vValue.canConvert< QObject* >())
+    {
+        m_buffer += "{";
+        RenderObject( vValue.value< QObject* >() );
+        m_buffer += "}";
+        return;
+    }
+
+    // -----------------------------------------------------------------------
+    // Lists hash their items as they render them, other values are hashed
+    // as rendered.
+    // -----------------------------------------------------------------------
+
+    if (vValue.type() == QVariant::List)
+    {
+        RenderList( vValue.toList() );
+        return;
+    }
+
+    int nStart = m_buffer.size();
+
+    switch( vValue.type() )
+    {
+        case QVariant::StringList:  RenderStringList( vValue.toStringList() );  break;
+        case QVariant::Map:         RenderMap       ( vValue.toMap()        );  break;
+        case QVariant::DateTime:
+        {
+            RenderString(
+                MythDate::toString( vValue.toDateTime(), MythDate::ISODate ) );
+            break;
+        }
+        case QVariant::Int:
+        case QVariant::LongLong:
+        {
+            m_buffer += "\"";
+            m_buffer += QByteArray::number( vValue.toLongLong() );
+            m_buffer += "\"";
+            break;
+        }
+        case QVariant::UInt:
+        case QVariant::ULongLong:
+        {
+            m_buffer += "\"";
+            m_buffer += QByteArray::number( vValue.toULongLong() );
+            m_buffer += "\"";
+            break;
+        }
+        case QVariant::Bool:
+        {
+            m_buffer += vValue.toBool() ? "\"true\"" : "\"false\"";
+            break;
+        }
+        default:
+        {
+            RenderString( vValue.toString() );
+            break;
+        }
+    }
+
+    if (m_bHash)
+    {
+        m_hash.addData( QByteArray::fromRawData( m_buffer.constData() + nStart,
+                                                 m_buffer.size() - nStart ) );
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::RenderList( const QVariantList &list )
+{
+    bool bFirst = true;
+
+    m_buffer += "[";
+
+    for (const auto &vValue : list)
+    {
+        if (bFirst)
+            bFirst = false;
+        else
+            m_buffer += ",";
+
+        RenderValue( vValue );
+
+        // Hand long lists to the device as they go, it may be streaming
+        // them to the client (see HTTPResponseStream)
+        if (m_buffer.size() >= kFlushSize)
+            Flush();
+    }
+
+    m_buffer += "]";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::RenderStringList( const QStringList &list )
+{
+    bool bFirst = true;
+
+    m_buffer += "[";
+
+    for (const auto &sValue : list)
+    {
+        if (bFirst)
+            bFirst = false;
+        else
+            m_buffer += ",";
+
+        RenderString( sValue );
+    }
+
+    m_buffer += "]";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::RenderMap( const QVariantMap &map )
+{
+    bool bFirst = true;
+
+    m_buffer += "{";
+
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+    {
+        if (bFirst)
+            bFirst = false;
+        else
+            m_buffer += ",";
+
+        m_buffer += "\"";
+        m_buffer += it.key().toUtf8();
+        m_buffer += "\":";
+        RenderString( it.value().toString() );
+    }
+
+    m_buffer += "}";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Writes a quoted string, escaped the same way as JSONSerializer::Encode().
+// Only ASCII needs escaping, so the UTF-8 is copied in runs between the
+// characters that do.
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::RenderString( const QString &sValue )
+{
+    static constexpr char kHex[] = "0123456789ABCDEF";
+
+    QByteArray  sUtf8 = sValue.toUtf8();
+    const char *pRun  = sUtf8.constData();
+    const char *pEnd  = pRun + sUtf8.size();
+
+    m_buffer += "\"";
+
+    for (const char *p = pRun; p < pEnd; ++p)
+    {
+        auto c = static_cast<unsigned char>(*p);
+
+        if ((c >= 0x20) && (c != '"') && (c != '\\') && (c != '/'))
+            continue;
+
+        m_buffer.append( pRun, static_cast<int>(p - pRun) );
+        pRun = p + 1;
+
+        switch (c)
+        {
+            case '"':  m_buffer += "\\\""; break;
+            case '\\': m_buffer += "\\\\"; break;
+            case '/':  m_buffer += "\\/";  break;
+            case '\b': m_buffer += "\\b";  break;
+            case '\f': m_buffer += "\\f";  break;
+            case '\n': m_buffer += "\\n";  break;
+            case '\r': m_buffer += "\\r";  break;
+            case '\t': m_buffer += "\\t";  break;
+            default:
+            {
+                const char sEscape[6] =
+                    { '\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF] };
+                m_buffer.append( sEscape, 6 );
+                break;
+            }
+        }
+    }
+
+    m_buffer.append( pRun, static_cast<int>(pEnd - pRun) );
+    m_buffer += "\"";
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//////////////////////////////////////////////////////////////////////////////
+
+void BufferedJSONSerializer::Flush()
+{
+    if (m_pDevice != nullptr)
+        m_pDevice->write( m_buffer );
+
+    // Keeps the capacity reserved for the next part
+    m_buffer.resize( 0 );
+}
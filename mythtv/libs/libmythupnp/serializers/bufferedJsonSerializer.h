@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: bufferedJsonSerializer.h
+//
+// Purpose     : Serialization Implementation for JSON, writing UTF-8
+//               straight into a buffer
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BUFFEREDJSONSERIALIZER_H
+#define BUFFEREDJSONSERIALIZER_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QStringList>
+#include <QVariantMap>
+
+#include "upnpexp.h"
+#include "serializer.h"
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Produces the same JSON as JSONSerializer, but walks each class through
+// its SerializerPlan and writes UTF-8 into one buffer, which is written to
+// the device whenever a list has filled kFlushSize of it, and at the end.
+// Common value types are formatted directly rather than through
+// QVariant::toString() and QTextStream.
+//
+// The ETag hash covers the names and rendered values of every property not
+// marked transient, so it differs from the one JSONSerializer computes.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+class UPNP_PUBLIC BufferedJSONSerializer : public Serializer
+{
+
+    protected:
+
+        QIODevice    *m_pDevice  {nullptr};
+        QByteArray    m_buffer;
+        bool          m_bHash    {true};
+        bool          m_bCommaNeeded {false};
+
+        void BeginObject( const QString &sName, const QObject  *pObject ) override; // Serializer
+        void EndObject  ( const QString &sName, const QObject  *pObject ) override; // Serializer
+
+        void AddProperty( const QString       &sName,
+                          const QVariant      &vValue,
+                          const QMetaObject   *pMetaParent,
+                          const QMetaProperty *pMetaProp ) override; // Serializer
+
+        void RenderObject    ( const QObject      *pObject );
+        void RenderValue     ( const QVariant     &vValue );
+        void RenderStringList( const QStringList  &list );
+        void RenderList      ( const QVariantList &list );
+        void RenderMap       ( const QVariantMap  &map  );
+        void RenderString    ( const QString      &sValue );
+
+        void Flush();
+
+    public:
+
+        static constexpr int kInitialBufferSize { 128 * 1024 };
+        static constexpr int kFlushSize         {  64 * 1024 };
+
+                 BufferedJSONSerializer( QIODevice *pDevice,
+                                         const QString &sRequestName );
+        virtual ~BufferedJSONSerializer() = default;
+
+        void Serialize( const QObject *pObject, const QString &_sName = QString() ) override; // Serializer
+        void Serialize( const QVariant &vValue, const QString &sName ) override; // Serializer
+
+        QString GetContentType() override; // Serializer
+
+};
+
+#endif // BUFFEREDJSONSERIALIZER_H
@@ -12,8 +12,11 @@
 
 #include "serializer.h"
 
+#include <unordered_map>
+
 #include <QMetaObject>
 #include <QMetaProperty>
+#include <QMutex>
 
 //////////////////////////////////////////////////////////////////////////////
 //
@@ -106,41 +109,83 @@ void Serializer::SerializeObjectProperties( const QObject *pObject )
     {
         const QMetaObject *pMetaObject = pObject->metaObject();
 
-        int nCount = pMetaObject->propertyCount();
-
-        for (int nIdx=0; nIdx < nCount; ++nIdx ) 
+        for (const auto &prop : GetPlan( pMetaObject ))
         {
-            QMetaProperty metaProperty = pMetaObject->property( nIdx );
+            if (!prop.m_transient)
+                m_hash.addData( prop.m_utf8Name );
 
-            if (metaProperty.isDesignable())
+            QVariant value( prop.m_meta.read( pObject ) );
+
+            if (!prop.m_transient && !value.canConvert< QObject* >())
             {
-                const char *pszPropName = metaProperty.name();
-                QString     sPropName( pszPropName );
+                m_hash.addData( value.toString().toUtf8() );
+            }
 
-                if ( sPropName.compare( "objectName" ) == 0)
-                    continue;
-                
-                bool bHash = false;
+            AddProperty( prop.m_name, value, pMetaObject, &prop.m_meta );
+        }
+    }
+}
 
-                if (ReadPropertyMetadata( pObject, 
-                                          sPropName,
-                                          "transient").toLower() != "true" )
-                {
-                    bHash = true;
-                    m_hash.addData( sPropName.toUtf8() );
-                }
+//////////////////////////////////////////////////////////////////////////////
+// Returns the properties of a class that are serialized, in order.  These
+// only depend on the class, so they are worked out once per class instead
+// of looking up the class info of every property of every object.
+//////////////////////////////////////////////////////////////////////////////
+
+const SerializerPlan &Serializer::GetPlan( const QMetaObject *pMetaObject )
+{
+    static QMutex s_lock;
+    static std::unordered_map< const QMetaObject*, SerializerPlan > s_plans;
+
+    QMutexLocker locker( &s_lock );
+
+    auto it = s_plans.find( pMetaObject );
+    if (it != s_plans.end())
+        return it->second;
 
-                QVariant value( pObject->property( pszPropName ) );
+    SerializerPlan plan;
 
-                if (bHash && !value.canConvert< QObject* >()) 
+    int nCount = pMetaObject->propertyCount();
+
+    for (int nIdx=0; nIdx < nCount; ++nIdx )
+    {
+        QMetaProperty metaProperty = pMetaObject->property( nIdx );
+
+        if (!metaProperty.isDesignable())
+            continue;
+
+        QString sPropName( metaProperty.name() );
+
+        if ( sPropName.compare( "objectName" ) == 0)
+            continue;
+
+        SerializerProperty prop;
+        prop.m_meta      = metaProperty;
+        prop.m_name      = sPropName;
+        prop.m_utf8Name  = sPropName.toUtf8();
+
+        int nInfoIdx = pMetaObject->indexOfClassInfo( metaProperty.name() );
+
+        if (nInfoIdx >= 0)
+        {
+            QString sOptions = pMetaObject->classInfo( nInfoIdx ).value();
+
+            for (const auto &sOption : sOptions.split( ';' ))
+            {
+                if (sOption.startsWith( "transient=" ))
                 {
-                    m_hash.addData( value.toString().toUtf8() );
+                    prop.m_transient =
+                        sOption.mid( 10 ).toLower() == "true";
+                    break;
                 }
-
-                AddProperty( sPropName, value, pMetaObject, &metaProperty );
             }
         }
+
+        plan.push_back( prop );
     }
+
+    // Elements of an unordered_map never move, so the reference stays valid
+    return s_plans.emplace( pMetaObject, plan ).first->second;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -16,8 +16,11 @@
 #include "upnpexp.h"
 #include "upnputil.h"
 
+#include <vector>
+
 #include <QList>
 #include <QMetaType>
+#include <QMetaProperty>
 #include <QCryptographicHash>
 
 //////////////////////////////////////////////////////////////////////////////
@@ -28,6 +31,17 @@
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
+/// A property of a class as it is serialized, see Serializer::GetPlan().
+struct SerializerProperty
+{
+    QMetaProperty m_meta;
+    QString       m_name;
+    QByteArray    m_utf8Name;
+    bool          m_transient {false};
+};
+
+using SerializerPlan = std::vector<SerializerProperty>;
+
 class UPNP_PUBLIC Serializer
 {
     protected:
@@ -54,6 +68,8 @@ class UPNP_PUBLIC Serializer
                                                  const QString&  sPropName,
                                                  const QString&  sKey );
 
+        static const SerializerPlan &GetPlan( const QMetaObject *pMetaObject );
+
     public:
 
         virtual void Serialize( const QObject *pObject, const QString &_sName = QString() );
@@ -10,6 +10,7 @@ JobQueue    *jobqueue     = nullptr;
 HouseKeeper *housekeeping = nullptr;
 MediaServer *g_pUPnp      = nullptr;
 BackendContext *gBackendContext = nullptr;
+RecordedIndex *recordedIndex = nullptr;
 QString      pidfile;
 QString      logfile;
 MythSystemEventHandler *sysEventHandler = nullptr;
@@ -14,6 +14,7 @@ class JobQueue;
 class HouseKeeper;
 class MediaServer;
 class BackendContext;
+class RecordedIndex;
 
 extern QMap<int, EncoderLink *> tvList;
 extern AutoExpire  *expirer;
@@ -21,6 +22,7 @@ extern JobQueue    *jobqueue;
 extern HouseKeeper *housekeeping;
 extern MediaServer *g_pUPnp;
 extern BackendContext *gBackendContext;
+extern RecordedIndex *recordedIndex;
 extern QString      pidfile;
 extern QString      logfile;
 extern MythSystemEventHandler *sysEventHandler;
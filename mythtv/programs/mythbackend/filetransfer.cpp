@@ -18,7 +18,7 @@ FileTransfer::FileTransfer(QString &filename, MythSocket *remote,
 {
     m_pginfo = new ProgramInfo(filename);
     m_pginfo->MarkAsInUse(true, kFileTransferInUseID);
-    if (m_rbuffer && m_rbuffer->IsOpen())
+    if (m_rbuffer && m_rbuffer->IsOpen() && !OpenSendFile())
         m_rbuffer->Start();
 }
 
@@ -119,6 +119,55 @@ void FileTransfer::Unpause(void)
         m_pginfo->UpdateInUseMark();
 }
 
+/** \brief Opens the file for SendFileBlock() if it is a plain local file.
+ *  \return true if RequestBlock() is to use SendFileBlock().
+ */
+bool FileTransfer::OpenSendFile(void)
+{
+    if (!MythSocket::CanSendFile() || !m_sock ||
+        (m_rbuffer->GetType() != kMythBufferFile))
+        return false;
+
+    QString filename = m_rbuffer->GetFilename();
+    if (!QFileInfo(filename).isFile())
+        return false;
+
+    m_sendFile.setFileName(filename);
+    if (!m_sendFile.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+        return false;
+
+    LOG(VB_FILE, LOG_INFO, QString("Sending '%1' with sendfile")
+        .arg(filename));
+    return true;
+}
+
+/** \brief Sends the next \p size bytes of the file to the client, without
+ *         copying them, if that much has been written to the file.
+ *
+ *  Otherwise this hands over to m_rbuffer for good, as a request reaching
+ *  the end of a recording in progress has to wait for the recorder.
+ *
+ *  \return bytes sent, -1 on error, or -2 if m_rbuffer is to be used.
+ */
+int FileTransfer::SendFileBlock(int size)
+{
+    if (m_sendFile.size() - m_sendFilePos < size)
+    {
+        LOG(VB_FILE, LOG_INFO, QString("Reached the end of '%1' at %2, "
+                                       "reading it through the ring buffer")
+            .arg(m_sendFile.fileName()).arg(m_sendFilePos));
+        m_sendFile.close();
+        m_rbuffer->Seek(m_sendFilePos, SEEK_SET);
+        m_rbuffer->Start();
+        return -2;
+    }
+
+    int sent = m_sock->SendFile(m_sendFile.handle(), m_sendFilePos, size);
+    if (sent > 0)
+        m_sendFilePos += sent;
+    return (sent == size) ? sent : -1;
+}
+
 int FileTransfer::RequestBlock(int size)
 {
     if (!m_readthreadlive || !m_rbuffer)
@@ -131,6 +180,18 @@ int FileTransfer::RequestBlock(int size)
     while (m_readsLocked)
         m_readsUnlockedCond.wait(&m_lock, 100 /*ms*/);
 
+    if (m_sendFile.isOpen())
+    {
+        ret = SendFileBlock(std::max(size, 0));
+        if (ret != -2)
+        {
+            if (m_pginfo)
+                m_pginfo->UpdateInUseMark();
+            return ret;
+        }
+        ret = 0;
+    }
+
     m_requestBuffer.resize(std::max((size_t)std::max(size,0) + 128, m_requestBuffer.size()));
     char *buf = &m_requestBuffer[0];
     while (tot < size && !m_rbuffer->GetStopReads() && m_readthreadlive)
@@ -232,6 +293,23 @@ long long FileTransfer::Seek(long long curpos, long long pos, int whence)
 
     m_ateof = false;
 
+    {
+        QMutexLocker locker(&m_lock);
+        if (m_sendFile.isOpen())
+        {
+            long long desired = pos;
+            if (whence == SEEK_CUR)
+                desired = curpos + pos;
+            else if (whence == SEEK_END)
+                desired = m_sendFile.size() - pos;
+
+            if (desired < 0)
+                return -1;
+            m_sendFilePos = desired;
+            return desired;
+        }
+    }
+
     Pause();
 
     if (whence == SEEK_CUR)
@@ -6,6 +6,7 @@
 #include <vector>
 
 // Qt headers
+#include <QFile>
 #include <QMutex>
 #include <QWaitCondition>
 
@@ -48,6 +49,9 @@ class FileTransfer : public ReferenceCounter
   private:
    ~FileTransfer() override;
 
+    bool OpenSendFile(void);
+    int SendFileBlock(int size);
+
     volatile bool   m_readthreadlive    {true};
     bool            m_readsLocked       {false};
     QWaitCondition  m_readsUnlockedCond;
@@ -59,6 +63,11 @@ class FileTransfer : public ReferenceCounter
 
     std::vector<char> m_requestBuffer;
 
+    // Plain local files are sent with MythSocket::SendFile() rather than
+    // through m_rbuffer, until a request reaches the end of the file.
+    QFile           m_sendFile;
+    long long       m_sendFilePos       {0};
+
     QMutex          m_lock;
 
     bool            m_writemode         {false};
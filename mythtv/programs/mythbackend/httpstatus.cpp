@@ -44,6 +44,8 @@
 #include "upnp.h"
 #include "mythdate.h"
 #include "tv_rec.h"
+#include "eithelper.h"
+#include "eitcache.h"
 
 /////////////////////////////////////////////////////////////////////////////
 //
@@ -145,13 +147,15 @@ void HttpStatus::GetStatusXML( HTTPRequest *pRequest )
     pRequest->m_eResponseType   = ResponseTypeXML;
     pRequest->m_mapRespHeaders[ "Cache-Control" ] = "no-cache=\"Ext\", max-age = 5000";
 
-    QTextStream stream( &pRequest->m_response );
+    // Written out as it is saved rather than as one string, so a large
+    // status can be streamed to the client
+    QTextStream stream( pRequest->GetResponseDevice() );
 #if QT_VERSION < QT_VERSION_CHECK(6,0,0)
     stream.setCodec("UTF-8");   // Otherwise locale default is used.
 #else
     stream.setEncoding(QStringConverter::Utf8);
 #endif
-    stream << doc.toString();
+    doc.save( stream, 1 );
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -429,11 +433,13 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
     QDomElement storage = pDoc->createElement("Storage"    );
     QDomElement load    = pDoc->createElement("Load"       );
     QDomElement guide   = pDoc->createElement("Guide"      );
+    QDomElement eit     = pDoc->createElement("EITCache"   );
 
     root.appendChild (mInfo  );
     mInfo.appendChild(storage);
     mInfo.appendChild(load   );
     mInfo.appendChild(guide  );
+    mInfo.appendChild(eit    );
 
     // drive space   ---------------------
 
@@ -564,6 +570,24 @@ void HttpStatus::FillStatusXML( QDomDocument *pDoc )
         guide.setAttribute("guideDays", qdtNow.daysTo(GuideDataThrough));
     }
 
+    // EIT cache ---------------------
+
+    EITCacheStatistics eitStats = EITHelper::GetEITCacheStatistics();
+
+    eit.setAttribute("access"      , eitStats.m_access         );
+    eit.setAttribute("hits"        , eitStats.m_hit            );
+    eit.setAttribute("table"       , eitStats.m_tableChange    );
+    eit.setAttribute("version"     , eitStats.m_versionChange  );
+    eit.setAttribute("endtime"     , eitStats.m_endtimeChange  );
+    eit.setAttribute("new"         , eitStats.m_new            );
+    eit.setAttribute("pruned"      , eitStats.m_pruned         );
+    eit.setAttribute("prunedHits"  , eitStats.m_prunedHit      );
+    eit.setAttribute("futureHits"  , eitStats.m_futureHit      );
+    eit.setAttribute("wrongChannel", eitStats.m_wrongChannelHit);
+    eit.setAttribute("channels"    , eitStats.m_channels       );
+    eit.setAttribute("entries"     , eitStats.m_entries        );
+    eit.setAttribute("memory"      , (int)(eitStats.m_memory>>10));
+
     // Add Miscellaneous information
 
     QString info_script = gCoreContext->GetSetting("MiscStatusScript");
@@ -1450,6 +1474,35 @@ int HttpStatus::PrintMachineInfo( QTextStream &os, const QDomElement& info )
                    << "Have you run mythfilldatabase?";
         }
     }
+
+    // EIT Cache ---------------------
+
+    node = info.namedItem( "EITCache" );
+
+    if (!node.isNull())
+    {
+        QDomElement e = node.toElement();
+
+        if (!e.isNull() && e.attribute( "access", "0" ).toUInt() > 0)
+        {
+            uint nAccess   = e.attribute( "access"      , "0" ).toUInt();
+            uint nHits     = e.attribute( "hits"        , "0" ).toUInt() +
+                             e.attribute( "prunedHits"  , "0" ).toUInt() +
+                             e.attribute( "futureHits"  , "0" ).toUInt() +
+                             e.attribute( "wrongChannel", "0" ).toUInt();
+            uint nChannels = e.attribute( "channels"    , "0" ).toUInt();
+            uint nEntries  = e.attribute( "entries"     , "0" ).toUInt();
+            int  nMemory   = e.attribute( "memory"      , "0" ).toInt();
+
+            os << "<br />\r\n    EIT cache: "
+               << QString("%L1").arg(nEntries) << " events of "
+               << nChannels << " channels in "
+               << QString("%L1").arg(nMemory) << " KB, "
+               << QString("%1%").arg(nHits * 100.0 / nAccess, 0, 'f', 1)
+               << " of " << QString("%L1").arg(nAccess)
+               << " events seen before.";
+        }
+    }
     os << "\r\n  </div>\r\n";
 
     return( 1 );
@@ -34,6 +34,7 @@
 #include "encoderlink.h"
 #include "remoteutil.h"
 #include "backendhousekeeper.h"
+#include "recordedindex.h"
 
 #include "mythcontext.h"
 #include "mythversion.h"
@@ -55,6 +56,7 @@
 #include "signalhandling.h"
 #include "hardwareprofile.h"
 #include "eitcache.h"
+#include "eithelper.h"
 
 #include "mediaserver.h"
 #include "httpstatus.h"
@@ -270,6 +272,9 @@ void cleanup(void)
     delete jobqueue;
     jobqueue = nullptr;
 
+    delete recordedIndex;
+    recordedIndex = nullptr;
+
     delete g_pUPnp;
     g_pUPnp = nullptr;
 
@@ -291,6 +296,8 @@ void cleanup(void)
         delete rec;
     }
 
+    EITHelper::DeleteEITCache();
+
 
     delete gContext;
     gContext = nullptr;
@@ -696,6 +703,8 @@ int run_backend(MythBackendCommandLineParser &cmdline)
     if (!cmdline.toBool("nojobqueue"))
         jobqueue = new JobQueue(ismaster);
 
+    recordedIndex = new RecordedIndex();
+
     // ----------------------------------------------------------------------
     //
     // ----------------------------------------------------------------------
@@ -1712,8 +1712,14 @@ void MainServer::HandleVersion(MythSocket *socket, const QStringList &slist)
         return;
     }
 
+    // Extra tokens are optional capabilities, the reply lists those we
+    // accept. The reply itself is still sent with the text framing.
+    bool binary = slist.mid(3).contains(MythSocket::kBinaryFramingCapability);
     retlist << "ACCEPT" << MYTH_PROTO_VERSION;
+    if (binary)
+        retlist << MythSocket::kBinaryFramingCapability;
     socket->WriteStringList(retlist);
+    socket->SetBinaryFraming(binary);
 }
 
 /**
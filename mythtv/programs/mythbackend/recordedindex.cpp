@@ -0,0 +1,397 @@
+// C++ headers
+#include <algorithm>
+
+// Qt headers
+#include <QRegularExpression>
+#include <QStringList>
+
+// MythTV headers
+#include "mythcorecontext.h"
+#include "mythdate.h"
+#include "mythdb.h"
+#include "mythevent.h"
+#include "mythlogging.h"
+#include "programinfo.h"
+
+#include "recordedindex.h"
+
+#define LOC QString("RecordedIndex: ")
+
+namespace
+{
+
+enum SortField
+{
+    kSortStartTime,
+    kSortTitle,
+    kSortSubtitle,
+    kSortSeason,
+    kSortEpisode,
+    kSortCategory,
+    kSortWatched,
+    kSortStars,
+    kSortOriginalAirdate,
+    kSortRecGroup,
+    kSortStorageGroup,
+    kSortChanNum,
+    kSortCallsign,
+    kSortChanName,
+};
+
+struct SortKey
+{
+    SortField m_field;
+    bool      m_ascending;
+};
+
+/// Parses the sort arguments the way LoadFromRecorded() does.
+std::vector<SortKey> parse_sort(int sort, const QString &sortBy)
+{
+    std::vector<SortKey> keys;
+    if (sortBy.isEmpty())
+    {
+        if (sort)
+            keys.push_back({kSortStartTime, sort > 0});
+        return keys;
+    }
+
+    static const QMap<QString, SortField> kFields {
+        { "starttime",       kSortStartTime       },
+        { "title",           kSortTitle           },
+        { "subtitle",        kSortSubtitle        },
+        { "season",          kSortSeason          },
+        { "episode",         kSortEpisode         },
+        { "category",        kSortCategory        },
+        { "watched",         kSortWatched         },
+        { "stars",           kSortStars           },
+        { "originalairdate", kSortOriginalAirdate },
+        { "recgroup",        kSortRecGroup        },
+        { "storagegroup",    kSortStorageGroup    },
+        { "channum",         kSortChanNum         },
+        { "callsign",        kSortCallsign        },
+        { "name",            kSortChanName        },
+        { "channelname",     kSortChanName        },
+    };
+
+    for (const auto &item : sortBy.split(","))
+    {
+        bool ascending = true;
+        QString field = item.simplified().toLower();
+
+        if (field.endsWith("desc"))
+        {
+            ascending = false;
+            field = field.remove("desc");
+        }
+
+        if (field.endsWith("asc"))
+        {
+            ascending = true;
+            field = field.remove("asc");
+        }
+
+        field = field.simplified();
+
+        auto it = kFields.constFind(field);
+        if (it != kFields.constEnd())
+            keys.push_back({*it, ascending});
+    }
+    return keys;
+}
+
+template <typename T>
+int compare_values(const T &a, const T &b)
+{
+    if (a < b)
+        return -1;
+    return (b < a) ? 1 : 0;
+}
+
+// Strings are compared like the database's default collation does
+int compare_strings(const QString &a, const QString &b)
+{
+    return QString::compare(a, b, Qt::CaseInsensitive);
+}
+
+int compare_field(const RecordedIndex::Row &a, const RecordedIndex::Row &b,
+                  SortField field)
+{
+    switch (field)
+    {
+        case kSortStartTime:
+            return compare_values(a.m_startTime, b.m_startTime);
+        case kSortTitle:
+            return compare_strings(a.m_title, b.m_title);
+        case kSortSubtitle:
+            return compare_strings(a.m_subtitle, b.m_subtitle);
+        case kSortSeason:
+            return compare_values(a.m_season, b.m_season);
+        case kSortEpisode:
+            return compare_values(a.m_episode, b.m_episode);
+        case kSortCategory:
+            return compare_strings(a.m_category, b.m_category);
+        case kSortWatched:
+            return compare_values(a.m_watched, b.m_watched);
+        case kSortStars:
+            return compare_values(a.m_stars, b.m_stars);
+        case kSortOriginalAirdate:
+            return compare_values(a.m_originalAirdate, b.m_originalAirdate);
+        case kSortRecGroup:
+            return compare_strings(a.m_recGroup, b.m_recGroup);
+        case kSortStorageGroup:
+            return compare_strings(a.m_storageGroup, b.m_storageGroup);
+        case kSortChanNum:
+            return compare_strings(a.m_chanNum, b.m_chanNum);
+        case kSortCallsign:
+            return compare_strings(a.m_callsign, b.m_callsign);
+        case kSortChanName:
+            return compare_strings(a.m_chanName, b.m_chanName);
+    }
+    return 0;
+}
+
+} // namespace
+
+RecordedIndex::RecordedIndex()
+{
+    if (gCoreContext)
+        gCoreContext->addListener(this);
+}
+
+RecordedIndex::~RecordedIndex()
+{
+    if (gCoreContext)
+        gCoreContext->removeListener(this);
+}
+
+/** \brief Returns the recorded ids of one page of recordings.
+ *
+ *  \param sort      order by start time if \p sortBy is empty, negative
+ *                   for descending, positive for ascending, 0 for none
+ *  \param sortBy    comma separated fields, as for LoadFromRecorded()
+ *  \param filter    recordings to return, those pending deletion never are
+ *  \param startIndex index of the first recording to return
+ *  \param count     recordings to return, all of them if not positive
+ *  \param available set to the number of recordings matching \p filter
+ */
+std::vector<uint> RecordedIndex::GetPage(int sort, const QString &sortBy,
+                                         const Filter &filter,
+                                         int startIndex, int count,
+                                         int &available)
+{
+    QMutexLocker locker(&m_lock);
+    Update();
+
+    const Order &order = GetOrder(sort, sortBy);
+
+    QRegularExpression titleRegEx
+        { filter.m_titleRegEx, QRegularExpression::CaseInsensitiveOption };
+
+    std::vector<uint> page;
+    available = 0;
+    for (const Row *row : order)
+    {
+        if (row->m_deletePending ||
+            (!filter.m_titleRegEx.isEmpty() &&
+             !row->m_title.contains(titleRegEx)) ||
+            (!filter.m_recGroup.isEmpty() &&
+             filter.m_recGroup != row->m_recGroup) ||
+            (!filter.m_storageGroup.isEmpty() &&
+             filter.m_storageGroup != row->m_storageGroup) ||
+            (!filter.m_category.isEmpty() &&
+             filter.m_category != row->m_category))
+            continue;
+
+        if ((available >= startIndex) &&
+            ((count <= 0) || (page.size() < static_cast<size_t>(count))))
+            page.push_back(row->m_recordedId);
+        ++available;
+    }
+
+    return page;
+}
+
+/** \brief Replaces the contents of the index with \p rows,
+ *         for use without a database.
+ */
+void RecordedIndex::SetRows(const std::vector<Row> &rows)
+{
+    QMutexLocker locker(&m_lock);
+    {
+        QMutexLocker pending(&m_pendingLock);
+        m_pending.clear();
+        m_reload = false;
+    }
+
+    m_rows.clear();
+    m_orders.clear();
+    for (const auto &row : rows)
+        m_rows[row.m_recordedId] = row;
+}
+
+void RecordedIndex::customEvent(QEvent *event)
+{
+    if (event->type() != MythEvent::MythEventMessage)
+        return;
+
+    auto *me = dynamic_cast<MythEvent *>(event);
+    if (me == nullptr)
+        return;
+
+    QStringList tokens = me->Message().simplified().split(" ");
+    uint recordedid = 0;
+
+    if (tokens[0] == "MASTER_UPDATE_REC_INFO")
+    {
+        if (tokens.size() < 2)
+            return;
+        recordedid = tokens[1].toUInt();
+    }
+    else if (tokens[0] == "RECORDING_LIST_CHANGE")
+    {
+        if ((tokens.size() >= 3) &&
+            (tokens[1] == "ADD" || tokens[1] == "DELETE"))
+        {
+            recordedid = tokens[2].toUInt();
+        }
+        else if ((tokens.size() == 2) && (tokens[1] == "UPDATE"))
+        {
+            ProgramInfo pginfo(me->ExtraDataList());
+            recordedid = pginfo.GetRecordingID();
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    QMutexLocker locker(&m_pendingLock);
+    if (recordedid)
+        m_pending.insert(recordedid);
+    else
+        m_reload = true;
+}
+
+/// Applies the changes events have told us about, needs m_lock.
+void RecordedIndex::Update(void)
+{
+    QSet<uint> pending;
+    bool reload = false;
+    {
+        QMutexLocker locker(&m_pendingLock);
+        pending.swap(m_pending);
+        reload = m_reload;
+        m_reload = false;
+    }
+
+    if (!reload && pending.isEmpty())
+        return;
+
+    m_orders.clear();
+
+    if (reload)
+    {
+        m_rows.clear();
+        if (!LoadRows(QString()))
+        {
+            QMutexLocker locker(&m_pendingLock);
+            m_reload = true;
+        }
+        LOG(VB_GENERAL, LOG_INFO, LOC +
+            QString("Loaded %1 recordings").arg(m_rows.size()));
+        return;
+    }
+
+    QStringList ids;
+    for (uint recordedid : qAsConst(pending))
+    {
+        m_rows.erase(recordedid);
+        ids << QString::number(recordedid);
+    }
+
+    if (!LoadRows(QString("WHERE r.recordedid IN (%1) ").arg(ids.join(","))))
+    {
+        QMutexLocker locker(&m_pendingLock);
+        m_pending.unite(pending);
+    }
+}
+
+/// Loads the recordings matching \p where into m_rows.
+bool RecordedIndex::LoadRows(const QString &where)
+{
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(
+        "SELECT r.recordedid,      r.title,        r.subtitle, "
+        "       r.season,          r.episode,      r.category, "
+        "       r.watched,         r.stars,        r.originalairdate, "
+        "       r.recgroup,        r.storagegroup, c.channum, "
+        "       c.callsign,        c.name,         r.starttime, "
+        "       r.deletepending "
+        "FROM recorded AS r "
+        "LEFT JOIN channel AS c "
+        "ON (r.chanid = c.chanid) " + where);
+
+    if (!query.exec())
+    {
+        MythDB::DBError("RecordedIndex::LoadRows", query);
+        return false;
+    }
+
+    while (query.next())
+    {
+        Row row;
+        row.m_recordedId      = query.value(0).toUInt();
+        row.m_title           = query.value(1).toString();
+        row.m_subtitle        = query.value(2).toString();
+        row.m_season          = query.value(3).toUInt();
+        row.m_episode         = query.value(4).toUInt();
+        row.m_category        = query.value(5).toString();
+        row.m_watched         = query.value(6).toBool();
+        row.m_stars           = query.value(7).toFloat();
+        row.m_originalAirdate = query.value(8).toDate();
+        row.m_recGroup        = query.value(9).toString();
+        row.m_storageGroup    = query.value(10).toString();
+        row.m_chanNum         = query.value(11).toString();
+        row.m_callsign        = query.value(12).toString();
+        row.m_chanName        = query.value(13).toString();
+        row.m_startTime       = MythDate::as_utc(query.value(14).toDateTime());
+        row.m_deletePending   = query.value(15).toBool();
+        m_rows[row.m_recordedId] = row;
+    }
+    return true;
+}
+
+/// Returns the recordings in the given order, needs m_lock.
+const RecordedIndex::Order &RecordedIndex::GetOrder(int sort,
+                                                    const QString &sortBy)
+{
+    std::vector<SortKey> keys = parse_sort(sort, sortBy);
+
+    QString name;
+    for (const auto &key : keys)
+        name += QString("%1%2,").arg(key.m_field).arg(key.m_ascending ? 'a' : 'd');
+
+    auto it = m_orders.find(name);
+    if (it != m_orders.end())
+        return *it;
+
+    Order order;
+    order.reserve(m_rows.size());
+    for (const auto &row : m_rows)
+        order.push_back(&row.second);
+
+    // Ties are broken by recordedid so pages never overlap
+    std::sort(order.begin(), order.end(),
+              [&keys](const Row *a, const Row *b)
+              {
+                  for (const auto &key : keys)
+                  {
+                      int cmp = compare_field(*a, *b, key.m_field);
+                      if (cmp != 0)
+                          return key.m_ascending ? (cmp < 0) : (cmp > 0);
+                  }
+                  return a->m_recordedId < b->m_recordedId;
+              });
+
+    return *m_orders.insert(name, order);
+}
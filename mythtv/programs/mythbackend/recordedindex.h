@@ -0,0 +1,91 @@
+#ifndef RECORDEDINDEX_H_
+#define RECORDEDINDEX_H_
+
+#include <map>
+#include <vector>
+
+#include <QDateTime>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+/** \class RecordedIndex
+ *  \brief In memory index of the recorded table for paging through it.
+ *
+ *  Dvr::GetRecordedList() used to load every recording as a ProgramInfo to
+ *  return one page of them. This index keeps just the fields the list can
+ *  be sorted and filtered on, so that a page is picked from memory and
+ *  only the recordings on it are loaded from the database.
+ *
+ *  The index follows RECORDING_LIST_CHANGE and MASTER_UPDATE_REC_INFO
+ *  events. Changed recordings are only remembered when the event arrives
+ *  and reloaded by the next GetPage(). Sort orders are cached until the
+ *  next change.
+ */
+class RecordedIndex : public QObject
+{
+    Q_OBJECT
+
+  public:
+    /// The fields of a recording GetPage() sorts and filters on.
+    struct Row
+    {
+        uint      m_recordedId     {0};
+        QString   m_title;
+        QString   m_subtitle;
+        uint      m_season         {0};
+        uint      m_episode        {0};
+        QString   m_category;
+        bool      m_watched        {false};
+        float     m_stars          {0.0F};
+        QDate     m_originalAirdate;
+        QString   m_recGroup;
+        QString   m_storageGroup;
+        QString   m_chanNum;
+        QString   m_callsign;
+        QString   m_chanName;
+        QDateTime m_startTime;
+        bool      m_deletePending  {false};
+    };
+
+    /// Recordings GetPage() returns, empty members match everything.
+    struct Filter
+    {
+        QString m_titleRegEx;
+        QString m_recGroup;
+        QString m_storageGroup;
+        QString m_category;
+    };
+
+    RecordedIndex();
+    ~RecordedIndex() override;
+
+    std::vector<uint> GetPage(int sort, const QString &sortBy,
+                              const Filter &filter,
+                              int startIndex, int count, int &available);
+
+    void SetRows(const std::vector<Row> &rows);
+
+  protected:
+    void customEvent(QEvent *event) override;
+
+  private:
+    using Order = std::vector<const Row*>;
+
+    void Update(void);
+    bool LoadRows(const QString &where);
+    const Order &GetOrder(int sort, const QString &sortBy);
+
+    QMutex                 m_lock;
+    std::map<uint, Row>    m_rows;      // by recordedid
+    QMap<QString, Order>   m_orders;    // by sort key list
+
+    // changes not applied yet, protected by m_pendingLock
+    QMutex                 m_pendingLock;
+    QSet<uint>             m_pending;
+    bool                   m_reload     {true};
+};
+
+#endif // RECORDEDINDEX_H_
@@ -0,0 +1,57 @@
+#include <algorithm>
+
+#include "recordinginfo.h"
+#include "schedconflictindex.h"
+
+void SchedConflictIndex::Build(const RecList &list)
+{
+    m_entries.clear();
+    m_entries.reserve(list.size());
+    m_maxLength = 0;
+
+    uint32_t pos = 0;
+    for (const auto *p : list)
+    {
+        Entry e { p->GetRecordingStartTime().toSecsSinceEpoch(),
+                  p->GetRecordingEndTime().toSecsSinceEpoch(), pos++ };
+        m_maxLength = std::max(m_maxLength, e.m_end - e.m_start);
+        m_entries.push_back(e);
+    }
+
+    std::sort(m_entries.begin(), m_entries.end(),
+              [](const Entry &a, const Entry &b)
+              { return a.m_start < b.m_start; });
+}
+
+void SchedConflictIndex::Clear(void)
+{
+    m_entries.clear();
+    m_maxLength = 0;
+}
+
+void SchedConflictIndex::Candidates(const RecList &list, const RecordingInfo *p,
+                                    RecList &candidates) const
+{
+    int64_t start = p->GetRecordingStartTime().toSecsSinceEpoch();
+    int64_t end   = p->GetRecordingEndTime().toSecsSinceEpoch();
+
+    // Nothing starting before start - m_maxLength can still be
+    // running at start, and nothing starting after end can overlap.
+    auto lo = std::lower_bound(
+        m_entries.cbegin(), m_entries.cend(), start - m_maxLength,
+        [](const Entry &e, int64_t t) { return e.m_start < t; });
+    auto hi = std::upper_bound(
+        lo, m_entries.cend(), end,
+        [](int64_t t, const Entry &e) { return t < e.m_start; });
+
+    std::vector<uint32_t> positions;
+    for (auto it = lo; it != hi; ++it)
+    {
+        if (it->m_end >= start)
+            positions.push_back(it->m_pos);
+    }
+    std::sort(positions.begin(), positions.end());
+
+    for (uint32_t pos : positions)
+        candidates.push_back(list[pos]);
+}
@@ -0,0 +1,46 @@
+#ifndef SCHEDCONFLICTINDEX_H_
+#define SCHEDCONFLICTINDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "mythscheduler.h"
+
+/** \class SchedConflictIndex
+ *  \brief Start time index over one of the scheduler's conflict lists.
+ *
+ *  Scheduler::FindNextConflict() walks a whole conflict list for every
+ *  showing it tries to place, although only the showings overlapping
+ *  it in time can conflict. This index keeps the list's showings sorted
+ *  by start time so the overlapping ones can be found with a binary
+ *  search. Candidates() returns them in their original list order so
+ *  the scheduler makes exactly the same decisions as with a full scan.
+ *
+ *  The index stores positions into the list, so it must be rebuilt
+ *  whenever showings are added to or removed from the list. Status
+ *  changes do not invalidate it.
+ */
+class SchedConflictIndex
+{
+  public:
+    void Build(const RecList &list);
+    void Clear(void);
+    bool IsEmpty(void) const { return m_entries.empty(); }
+
+    /// Appends to \p candidates the showings in \p list that overlap or
+    /// touch the recording time of \p p, in \p list order.
+    void Candidates(const RecList &list, const RecordingInfo *p,
+                    RecList &candidates) const;
+
+  private:
+    struct Entry
+    {
+        int64_t  m_start;
+        int64_t  m_end;
+        uint32_t m_pos;
+    };
+    std::vector<Entry> m_entries;      // sorted by m_start
+    int64_t            m_maxLength {0};
+};
+
+#endif // SCHEDCONFLICTINDEX_H_
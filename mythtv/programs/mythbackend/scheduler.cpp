@@ -534,8 +534,11 @@ void Scheduler::FillRecordListFromDB(uint recordid)
     CreateTempTables();
 
     fillstart = nowAsDuration<std::chrono::microseconds>();
-    LOG(VB_SCHEDULE, LOG_INFO, "UpdateDuplicates...");
-    UpdateDuplicates();
+    if (CreateTempRecordedTable())
+    {
+        LOG(VB_SCHEDULE, LOG_INFO, "UpdateDuplicates...");
+        UpdateDuplicates();
+    }
     fillend = nowAsDuration<std::chrono::microseconds>();
     auto checkTime = fillend - fillstart;
 
@@ -1024,6 +1027,9 @@ void Scheduler::BuildListMaps(void)
         }
     }
 
+    for (auto *conflictlist : m_conflictLists)
+        m_conflictIndexes[conflictlist].Build(*conflictlist);
+
     QMap<uint, uint>::iterator it;
     for (it = badinputs.begin(); it != badinputs.end(); ++it)
     {
@@ -1040,6 +1046,7 @@ void Scheduler::ClearListMaps(void)
     m_titleListMap.clear();
     m_recordIdListMap.clear();
     m_cacheIsSameProgram.clear();
+    m_conflictIndexes.clear();
 }
 
 bool Scheduler::IsSameProgram(
@@ -1066,6 +1073,17 @@ bool Scheduler::FindNextConflict(
     uint              *paffinity,
     bool              ignoreinput) const
 {
+    static const SchedInputInfo kNoInputInfo;
+
+    // Look these up once, rather than copying them out of the map for
+    // every showing compared against.
+    auto pinfo = m_sinputInfoMap.constFind(p->GetInputID());
+    const SchedInputInfo &pinput =
+        (pinfo != m_sinputInfoMap.constEnd()) ? *pinfo : kNoInputInfo;
+    auto ginfo = m_sinputInfoMap.constFind(p->m_sgroupId);
+    bool pschedgroup =
+        (ginfo != m_sinputInfoMap.constEnd()) && ginfo->m_schedGroup;
+
     uint affinity = 0;
     for ( ; iter != cardlist.end(); ++iter)
     {
@@ -1083,10 +1101,7 @@ bool Scheduler::FindNextConflict(
 
         if (p->GetInputID() != q->GetInputID() && !ignoreinput)
         {
-            const vector <uint> &conflicting_inputs =
-                m_sinputInfoMap[p->GetInputID()].m_conflictingInputs;
-            if (find(conflicting_inputs.begin(), conflicting_inputs.end(),
-                     q->GetInputID()) == conflicting_inputs.end())
+            if (!pinput.IsConflictingInput(q->GetInputID()))
             {
                 if (debugConflicts)
                     msg += "  cardid== ";
@@ -1103,8 +1118,7 @@ bool Scheduler::FindNextConflict(
         }
 
         bool mplexid_ok =
-            (p->m_sgroupId != q->m_sgroupId ||
-             m_sinputInfoMap[p->m_sgroupId].m_schedGroup) &&
+            (p->m_sgroupId != q->m_sgroupId || pschedgroup) &&
             (((p->m_mplexId != 0U) && p->m_mplexId == q->m_mplexId) ||
              ((p->m_mplexId == 0U) && p->GetChanID() == q->GetChanID()));
 
@@ -1165,13 +1179,14 @@ const RecordingInfo *Scheduler::FindConflict(
     uint *affinity,
     bool checkAll) const
 {
-    RecList &conflictlist = *m_sinputInfoMap[p->GetInputID()].m_conflictList;
-    auto k = conflictlist.cbegin();
-    if (FindNextConflict(conflictlist, p, k, openend, affinity))
+    RecList scratch;
+    const RecList &candidates = GetConflictCandidates(p, scratch);
+    auto k = candidates.cbegin();
+    if (FindNextConflict(candidates, p, k, openend, affinity))
     {
         RecordingInfo *firstConflict = *k;
         while (checkAll &&
-               FindNextConflict(conflictlist, p, ++k, openend, affinity))
+               FindNextConflict(candidates, p, ++k, openend, affinity))
             ;
         return firstConflict;
     }
@@ -1179,6 +1194,30 @@ const RecordingInfo *Scheduler::FindConflict(
     return nullptr;
 }
 
+/** \brief Gets the showings from p's conflict list that may conflict with p.
+ *
+ *  Uses the start time index built by BuildListMaps() to skip showings
+ *  that do not overlap p, which are put in \p candidates. Without an
+ *  index the conflict list itself is returned rather than a copy. The
+ *  candidates are in conflict list order, so FindNextConflict() over them
+ *  gives the same results as over the whole list.
+ */
+const RecList &Scheduler::GetConflictCandidates(const RecordingInfo *p,
+                                                RecList &candidates) const
+{
+    auto info = m_sinputInfoMap.constFind(p->GetInputID());
+    if (info == m_sinputInfoMap.constEnd() || !info->m_conflictList)
+        return candidates;
+
+    const RecList &conflictlist = *info->m_conflictList;
+    auto index = m_conflictIndexes.constFind(&conflictlist);
+    if (index == m_conflictIndexes.constEnd() || index->IsEmpty())
+        return conflictlist;
+
+    index->Candidates(conflictlist, p, candidates);
+    return candidates;
+}
+
 void Scheduler::MarkOtherShowings(RecordingInfo *p)
 {
     RecList *showinglist = &m_titleListMap[p->GetTitle().toLower()];
@@ -1524,9 +1563,10 @@ void Scheduler::SchedNewRetryPass(const RecIter& start, const RecIter& end,
 
         // Try to move each conflict.  Restore the old status if we
         // can't.
-        RecList &conflictlist = *m_sinputInfoMap[p->GetInputID()].m_conflictList;
-        auto k = conflictlist.cbegin();
-        for ( ; FindNextConflict(conflictlist, p, k); ++k)
+        RecList scratch;
+        const RecList &conflicts = GetConflictCandidates(p, scratch);
+        auto k = conflicts.cbegin();
+        for ( ; FindNextConflict(conflicts, p, k); ++k)
         {
             if (!TryAnotherShowing(*k, samePriority, livetv))
             {
@@ -2276,6 +2316,60 @@ void Scheduler::ResetDuplicates(uint recordid, uint findid,
     }
  }
 
+/** \brief Drops queued MATCH requests covered by the one being handled.
+ *
+ *  Every request still in the queue was made before this MATCH runs,
+ *  so any of them restricted to a subset of its rule, source, multiplex
+ *  and time window would just redo part of the same work. This keeps a
+ *  burst of requests, e.g. one per source from mythfilldatabase followed
+ *  by a full MATCH, from rematching the same rules over and over.
+ */
+void Scheduler::PruneMatchRequests(uint recordid, uint sourceid, uint mplexid,
+                                   const QDateTime &maxstarttime)
+{
+    uint pruned = 0;
+    auto it = m_reschedQueue.begin();
+    while (it != m_reschedQueue.end())
+    {
+        QStringList tokens;
+        if (!it->empty())
+        {
+#if QT_VERSION < QT_VERSION_CHECK(5,14,0)
+            tokens = (*it)[0].split(' ', QString::SkipEmptyParts);
+#else
+            tokens = (*it)[0].split(' ', Qt::SkipEmptyParts);
+#endif
+        }
+        if (tokens.size() < 5 || tokens[0] != "MATCH")
+        {
+            ++it;
+            continue;
+        }
+
+        QDateTime otherstart = MythDate::fromString(tokens[4]);
+        if ((recordid == 0 || recordid == tokens[1].toUInt()) &&
+            (sourceid == 0 || sourceid == tokens[2].toUInt()) &&
+            (mplexid  == 0 || mplexid  == tokens[3].toUInt()) &&
+            (!maxstarttime.isValid() ||
+             (otherstart.isValid() && otherstart <= maxstarttime)))
+        {
+            LOG(VB_SCHEDULE, LOG_INFO, QString("Dropping covered request %1")
+                .arg(it->join(" | ")));
+            it = m_reschedQueue.erase(it);
+            ++pruned;
+            continue;
+        }
+        ++it;
+    }
+
+    if (pruned)
+    {
+        LOG(VB_GENERAL, LOG_INFO,
+            QString("Dropped %1 queued match requests covered by this one")
+            .arg(pruned));
+    }
+}
+
 bool Scheduler::HandleReschedule(void)
 {
     // We might have been inactive for a long time, so make
@@ -2325,6 +2419,7 @@ bool Scheduler::HandleReschedule(void)
             QDateTime maxstarttime = MythDate::fromString(tokens[4]);
             deleteFuture = true;
             runCheck = true;
+            PruneMatchRequests(recordid, sourceid, mplexid, maxstarttime);
             m_schedLock.unlock();
             m_recordMatchLock.lock();
             UpdateMatches(recordid, sourceid, mplexid, maxstarttime);
@@ -2385,7 +2480,7 @@ bool Scheduler::HandleReschedule(void)
     CreateTempTables();
 
     fillstart = nowAsDuration<std::chrono::microseconds>();
-    if (runCheck)
+    if (runCheck && CreateTempRecordedTable())
     {
         LOG(VB_SCHEDULE, LOG_INFO, "UpdateDuplicates...");
         UpdateDuplicates();
@@ -4139,26 +4234,72 @@ void Scheduler::CreateTempTables(void)
             return;
         }
     }
+}
+
+/** \brief Copies the recordings needed for duplicate checking.
+ *
+ *  UpdateDuplicates() only looks at recordmatch rows that have been
+ *  matched or reset since the last check (oldrecduplicate = -1), and
+ *  only compares them against recordings with the same title. So
+ *  rather than copying the whole recorded table, which can hold many
+ *  years of history, only copy recordings whose titles are pending a
+ *  check.
+ *
+ *  \return false if there is nothing to check, in which case
+ *          UpdateDuplicates() need not be called.
+ */
+bool Scheduler::CreateTempRecordedTable(void)
+{
+    MSqlQuery result(m_dbConn);
+
+    result.prepare("SELECT NULL FROM recordmatch "
+                   "WHERE oldrecduplicate = -1 LIMIT 1;");
+    if (!result.exec())
+    {
+        MythDB::DBError("Checking for pending duplicates", result);
+        return false;
+    }
+    if (!result.next())
+    {
+        LOG(VB_SCHEDULE, LOG_INFO, "No duplicate checks pending");
+        return false;
+    }
 
     result.prepare("DROP TABLE IF EXISTS sched_temp_recorded;");
     if (!result.exec())
     {
         MythDB::DBError("Dropping sched_temp_recorded table", result);
-        return;
+        return false;
     }
     result.prepare("CREATE TEMPORARY TABLE sched_temp_recorded "
                        "LIKE recorded;");
     if (!result.exec())
     {
         MythDB::DBError("Creating sched_temp_recorded table", result);
-        return;
+        return false;
     }
-    result.prepare("INSERT sched_temp_recorded SELECT * from recorded;");
+    result.prepare("INSERT sched_temp_recorded "
+                   "SELECT recorded.* FROM recorded "
+                   "INNER JOIN (SELECT DISTINCT p.title FROM recordmatch rm "
+                   "            INNER JOIN program p "
+                   "                  ON rm.chanid = p.chanid "
+                   "                     AND rm.starttime = p.starttime "
+                   "                     AND rm.manualid = p.manualid "
+                   "            WHERE rm.oldrecduplicate = -1 "
+                   "                  AND p.generic = 0) pending "
+                   "      ON recorded.title = pending.title "
+                   "WHERE recorded.duplicate <> 0 "
+                   "      AND recorded.recgroup NOT IN ('LiveTV','Deleted');");
     if (!result.exec())
     {
         MythDB::DBError("Populating sched_temp_recorded table", result);
-        return;
+        return false;
     }
+    LOG(VB_SCHEDULE, LOG_INFO,
+        QString("Copied %1 recordings for duplicate checking")
+        .arg(result.numRowsAffected()));
+
+    return true;
 }
 
 void Scheduler::DeleteTempTables(void)
@@ -5791,7 +5932,7 @@ bool Scheduler::InitInputInfoMap(void)
             siinfo.m_groupInputs = CardUtil::GetChildInputIDs(inputid);
             siinfo.m_groupInputs.insert(siinfo.m_groupInputs.begin(), inputid);
         }
-        siinfo.m_conflictingInputs = CardUtil::GetConflictingInputs(inputid);
+        siinfo.SetConflictingInputs(CardUtil::GetConflictingInputs(inputid));
         LOG(VB_SCHEDULE, LOG_INFO,
             QString("Added SchedInputInfo i=%1, g=%2, sg=%3")
             .arg(inputid).arg(siinfo.m_sgroupId).arg(siinfo.m_schedGroup));
@@ -5815,7 +5956,7 @@ void Scheduler::AddChildInput(uint parentid, uint inputid)
     else
         siinfo.m_sgroupId = inputid;
     siinfo.m_schedGroup = false;
-    siinfo.m_conflictingInputs = CardUtil::GetConflictingInputs(inputid);
+    siinfo.SetConflictingInputs(CardUtil::GetConflictingInputs(inputid));
 
     siinfo.m_conflictList = m_sinputInfoMap[parentid].m_conflictList;
 
@@ -5823,7 +5964,7 @@ void Scheduler::AddChildInput(uint parentid, uint inputid)
     m_sinputInfoMap[parentid].m_groupInputs.push_back(inputid);
     for (uint otherid : siinfo.m_conflictingInputs)
     {
-        m_sinputInfoMap[otherid].m_conflictingInputs.push_back(inputid);
+        m_sinputInfoMap[otherid].AddConflictingInput(inputid);
     }
 }
 
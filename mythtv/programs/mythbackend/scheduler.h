@@ -10,6 +10,7 @@
 #include <QObject>
 #include <QString>
 #include <QMutex>
+#include <QHash>
 #include <QMap>
 #include <QSet>
 
@@ -21,6 +22,7 @@
 #include "mythscheduler.h"
 #include "mthread.h"
 #include "scheduledrecording.h"
+#include "schedconflictindex.h"
 
 class EncoderLink;
 class MainServer;
@@ -40,6 +42,30 @@ class SchedInputInfo
     vector<uint>  m_groupInputs;
     vector<uint>  m_conflictingInputs;
     RecList      *m_conflictList {nullptr};
+
+    void SetConflictingInputs(const vector<uint> &inputs)
+    {
+        m_conflictingInputs.clear();
+        m_conflictingMask.clear();
+        for (uint inputid : inputs)
+            AddConflictingInput(inputid);
+    }
+    void AddConflictingInput(uint inputid)
+    {
+        m_conflictingInputs.push_back(inputid);
+        if (inputid >= m_conflictingMask.size())
+            m_conflictingMask.resize(inputid + 1, false);
+        m_conflictingMask[inputid] = true;
+    }
+    bool IsConflictingInput(uint inputid) const
+    {
+        return inputid < m_conflictingMask.size() &&
+            m_conflictingMask[inputid];
+    }
+
+  private:
+    /// Bitmap of m_conflictingInputs indexed by inputid
+    vector<bool>  m_conflictingMask;
 };
 
 class Scheduler : public MThread, public MythScheduler
@@ -134,6 +160,7 @@ class Scheduler : public MThread, public MythScheduler
 
     bool InitInputInfoMap(void);
     void CreateTempTables(void);
+    bool CreateTempRecordedTable(void);
     void DeleteTempTables(void);
     void UpdateDuplicates(void);
     bool FillRecordList(void);
@@ -164,6 +191,8 @@ class Scheduler : public MThread, public MythScheduler
                                       uint *affinity = nullptr,
                                       bool checkAll = false)
         const;
+    const RecList &GetConflictCandidates(const RecordingInfo *p,
+                                         RecList &candidates) const;
     void MarkOtherShowings(RecordingInfo *p);
     void MarkShowingsList(const RecList &showinglist, RecordingInfo *p);
     void BackupRecStatus(void);
@@ -227,6 +256,8 @@ class Scheduler : public MThread, public MythScheduler
     void EnqueuePlace(const QString &why)
     { m_reschedQueue.enqueue(ScheduledRecording::BuildPlaceRequest(why)); };
 
+    void PruneMatchRequests(uint recordid, uint sourceid, uint mplexid,
+                            const QDateTime &maxstarttime);
     bool HaveQueuedRequests(void)
     { return !m_reschedQueue.empty(); };
     void ClearRequestQueue(void)
@@ -243,6 +274,7 @@ class Scheduler : public MThread, public MythScheduler
     RecList                m_livetvList;
     QMap<uint, SchedInputInfo> m_sinputInfoMap;
     vector<RecList *>      m_conflictLists;
+    QHash<const RecList *, SchedConflictIndex> m_conflictIndexes;
     QMap<uint, RecList>    m_recordIdListMap;
     QMap<QString, RecList> m_titleListMap;
 
@@ -54,6 +54,8 @@
 
 #include "scheduler.h"
 #include "tv_rec.h"
+#include "backendcontext.h"
+#include "recordedindex.h"
 
 extern QMap<int, EncoderLink *> tvList;
 extern AutoExpire  *expirer;
@@ -86,7 +88,24 @@ DTC::ProgramList* Dvr::GetRecordedList( bool           bDescending,
     if (bDescending)
         desc = -1;
 
-    LoadFromRecorded( progList, false, inUseMap, isJobRunning, recMap, desc, sSort );
+    // The index picks the page, so only the recordings on it are loaded
+    int nIndexAvailable = -1;
+    if (recordedIndex)
+    {
+        RecordedIndex::Filter filter;
+        filter.m_titleRegEx   = sTitleRegEx;
+        filter.m_recGroup     = sRecGroup;
+        filter.m_storageGroup = sStorageGroup;
+        filter.m_category     = sCategory;
+
+        std::vector<uint> page = recordedIndex->GetPage(
+            desc, sSort, filter, nStartIndex, nCount, nIndexAvailable);
+        LoadFromRecorded( progList, page, inUseMap, isJobRunning, recMap );
+    }
+    else
+    {
+        LoadFromRecorded( progList, false, inUseMap, isJobRunning, recMap, desc, sSort );
+    }
 
     QMap< QString, ProgramInfo* >::iterator mit = recMap.begin();
 
@@ -110,6 +129,14 @@ DTC::ProgramList* Dvr::GetRecordedList( bool           bDescending,
 
     for (auto *pInfo : progList)
     {
+        if (nIndexAvailable >= 0)
+        {
+            DTC::Program *pProgram = pPrograms->AddNewProgram();
+            FillProgramInfo( pProgram, pInfo, true );
+            ++nCount;
+            continue;
+        }
+
         if (pInfo->IsDeletePending() ||
             (!sTitleRegEx.isEmpty() && !pInfo->GetTitle().contains(rTitleRegEx)) ||
             (!sRecGroup.isEmpty() && sRecGroup != pInfo->GetRecordingGroup()) ||
@@ -132,6 +159,9 @@ DTC::ProgramList* Dvr::GetRecordedList( bool           bDescending,
         FillProgramInfo( pProgram, pInfo, true );
     }
 
+    if (nIndexAvailable >= 0)
+        nAvailable = nIndexAvailable;
+
     // ----------------------------------------------------------------------
 
     pPrograms->setStartIndex    ( nStartIndex     );
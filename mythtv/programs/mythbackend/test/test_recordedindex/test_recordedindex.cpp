@@ -0,0 +1,148 @@
+/*
+ *  Class TestRecordedIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <set>
+
+#include "test_recordedindex.h"
+#include "recordedindex.h"
+
+static const QDateTime kEpoch =
+    QDateTime(QDate(2021, 1, 1), QTime(0, 0), Qt::UTC);
+
+static RecordedIndex::Row make_row(uint recordedid, const QString &title,
+                                   int startmins)
+{
+    RecordedIndex::Row row;
+    row.m_recordedId = recordedid;
+    row.m_title      = title;
+    row.m_recGroup   = "Default";
+    row.m_startTime  = kEpoch.addSecs(startmins * 60LL);
+    return row;
+}
+
+void TestRecordedIndex::PagesCoverList_data(void)
+{
+    QTest::addColumn<int>("sort");
+    QTest::addColumn<QString>("sortBy");
+    QTest::newRow("ascending") << 1 << QString();
+    QTest::newRow("descending") << -1 << QString();
+    QTest::newRow("by title") << 1 << QString("title");
+}
+
+void TestRecordedIndex::PagesCoverList(void)
+{
+    QFETCH(int, sort);
+    QFETCH(QString, sortBy);
+
+    // Many recordings share a start time and title, which must not make
+    // consecutive pages overlap or skip any of them.
+    std::vector<RecordedIndex::Row> rows;
+    for (uint i = 1; i <= 100; ++i)
+        rows.push_back(make_row(i, QString("Show %1").arg(i % 5), i / 10));
+
+    RecordedIndex index;
+    index.SetRows(rows);
+
+    int available = 0;
+    std::vector<uint> all = index.GetPage(sort, sortBy, {}, 0, 0, available);
+    QCOMPARE(available, 100);
+    QCOMPARE(all.size(), size_t(100));
+
+    std::vector<uint> paged;
+    for (int start = 0; start < 100; start += 7)
+    {
+        std::vector<uint> page =
+            index.GetPage(sort, sortBy, {}, start, 7, available);
+        QCOMPARE(available, 100);
+        QVERIFY(page.size() <= 7);
+        paged.insert(paged.end(), page.begin(), page.end());
+    }
+    QVERIFY(paged == all);
+    QCOMPARE(std::set<uint>(all.begin(), all.end()).size(), size_t(100));
+
+    if (sortBy.isEmpty())
+    {
+        for (size_t i = 1; i < all.size(); ++i)
+        {
+            int prev = all[i - 1] / 10;
+            int next = all[i] / 10;
+            QVERIFY((sort > 0) ? (prev <= next) : (prev >= next));
+        }
+    }
+}
+
+void TestRecordedIndex::Filters(void)
+{
+    std::vector<RecordedIndex::Row> rows;
+    rows.push_back(make_row(1, "The News", 0));
+    rows.push_back(make_row(2, "Late News", 10));
+    rows.push_back(make_row(3, "Weather", 20));
+    rows.push_back(make_row(4, "NEWS at Noon", 30));
+    rows[1].m_recGroup = "Deleted";
+    rows[3].m_deletePending = true;
+
+    RecordedIndex index;
+    index.SetRows(rows);
+
+    RecordedIndex::Filter filter;
+    filter.m_titleRegEx = "news";
+
+    int available = 0;
+    std::vector<uint> page = index.GetPage(1, QString(), filter, 0, 0,
+                                           available);
+    QCOMPARE(available, 2);
+    QCOMPARE(page, std::vector<uint>({1, 2}));
+
+    filter.m_recGroup = "Default";
+    page = index.GetPage(1, QString(), filter, 0, 0, available);
+    QCOMPARE(available, 1);
+    QCOMPARE(page, std::vector<uint>({1}));
+
+    // A page past the end is empty but still counts the matches
+    page = index.GetPage(1, QString(), filter, 5, 10, available);
+    QCOMPARE(available, 1);
+    QVERIFY(page.empty());
+}
+
+void TestRecordedIndex::SortBy(void)
+{
+    std::vector<RecordedIndex::Row> rows;
+    rows.push_back(make_row(1, "b", 0));
+    rows.push_back(make_row(2, "A", 10));
+    rows.push_back(make_row(3, "a", 20));
+    rows.push_back(make_row(4, "c", 30));
+    rows[0].m_chanName = "Two";
+    rows[1].m_chanName = "One";
+    rows[2].m_chanName = "One";
+    rows[3].m_chanName = "Three";
+
+    RecordedIndex index;
+    index.SetRows(rows);
+
+    int available = 0;
+    QCOMPARE(index.GetPage(1, "title, starttime desc", {}, 0, 0, available),
+             std::vector<uint>({3, 2, 1, 4}));
+    QCOMPARE(index.GetPage(1, "channelname desc,bogus,starttime", {}, 0, 0,
+                           available),
+             std::vector<uint>({1, 4, 2, 3}));
+
+    // The descending flag only applies without sort fields
+    QCOMPARE(index.GetPage(-1, "title", {}, 0, 0, available),
+             index.GetPage(1, "title", {}, 0, 0, available));
+}
+
+QTEST_APPLESS_MAIN(TestRecordedIndex)
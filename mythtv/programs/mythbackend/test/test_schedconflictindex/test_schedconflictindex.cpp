@@ -0,0 +1,363 @@
+/*
+ *  Class TestSchedConflictIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "test_schedconflictindex.h"
+#include "recordinginfo.h"
+#include "schedconflictindex.h"
+
+static const QDateTime kEpoch =
+    QDateTime(QDate(2021, 1, 1), QTime(0, 0), Qt::UTC);
+
+static RecordingInfo *make_showing(uint chanid, int startmins, int lengthmins)
+{
+    auto *p = new RecordingInfo();
+    p->SetChanID(chanid);
+    p->SetRecordingStartTime(kEpoch.addSecs(startmins * 60LL));
+    p->SetRecordingEndTime(kEpoch.addSecs((startmins + lengthmins) * 60LL));
+    return p;
+}
+
+// A synthetic guide: back to back showings of 30 to 120
+// minutes on each channel, with the list in the scheduler's priority
+// order rather than by time.
+static void make_listings(RecList &list, uint channels, uint days)
+{
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> slots(1, 4);
+
+    for (uint chanid = 1; chanid <= channels; ++chanid)
+    {
+        int mins = 0;
+        while (mins < int(days) * 24 * 60)
+        {
+            int length = slots(gen) * 30;
+            list.push_back(make_showing(chanid, mins, length));
+            mins += length;
+        }
+    }
+    std::shuffle(list.begin(), list.end(), gen);
+}
+
+// The filtering done by Scheduler::FindNextConflict() before the
+// index was added.
+static RecList scan(const RecList &list, const RecordingInfo *p)
+{
+    RecList result;
+    for (auto *q : list)
+    {
+        if (p->GetRecordingEndTime() < q->GetRecordingStartTime() ||
+            p->GetRecordingStartTime() > q->GetRecordingEndTime())
+            continue;
+        result.push_back(q);
+    }
+    return result;
+}
+
+static constexpr uint kCards            { 2 };
+static constexpr uint kInputsPerCard    { 4 };
+static constexpr uint kChannelsPerCard  { 40 };
+static constexpr uint kChannelsPerMplex { 8 };
+
+// The work list as Scheduler::FillRecordList() hands it to
+// SchedNewRecords(): every showing matched by a recording rule, once for
+// each input that can record it, highest priority first.  Each rule
+// records a series on one card, whose four tuners share a conflict list.
+// Episodes air in the evening and are repeated the next day.
+static void make_schedule(RecList &worklist,
+                          std::vector<RecList> &conflictlists,
+                          uint rules, uint days)
+{
+    std::mt19937 gen(5678);
+    std::uniform_int_distribution<int> priority(-1, 2);
+    std::uniform_int_distribution<int> evening(34, 47);
+    std::uniform_int_distribution<int> anytime(0, 47);
+    std::uniform_int_distribution<int> halfhours(1, 2);
+    std::uniform_int_distribution<uint> channel(1, kChannelsPerCard);
+    std::bernoulli_distribution airs(0.6);
+
+    for (uint rule = 1; rule <= rules; ++rule)
+    {
+        uint card = rule % kCards;
+        int recpriority = priority(gen);
+        for (int day = 0; day < static_cast<int>(days); ++day)
+        {
+            if (!airs(gen))
+                continue;
+
+            QString programid = QString("EP%1%2")
+                .arg(rule, 6, 10, QChar('0')).arg(day, 4, 10, QChar('0'));
+            int length = halfhours(gen) * 30;
+            std::array<int,2> starts {
+                ((day * 48) + evening(gen)) * 30,
+                (((day + 1) * 48) + anytime(gen)) * 30 };
+
+            for (int start : starts)
+            {
+                uint chanid = (card * kChannelsPerCard) + channel(gen);
+                for (uint input = 1; input <= kInputsPerCard; ++input)
+                {
+                    RecordingInfo *p = make_showing(chanid, start, length);
+                    p->SetProgramID(programid);
+                    p->SetRecordingRuleID(rule);
+                    p->SetRecordingPriority(recpriority);
+                    p->SetInputID((card * kInputsPerCard) + input);
+                    p->m_mplexId  = ((chanid - 1) / kChannelsPerMplex) + 1;
+                    p->m_sgroupId = card + 1;
+                    worklist.push_back(p);
+                }
+            }
+        }
+    }
+
+    // The showings of a program at one time end up next to each other
+    std::stable_sort(worklist.begin(), worklist.end(),
+        [](const RecordingInfo *a, const RecordingInfo *b)
+        {
+            if (a->GetRecordingPriority() != b->GetRecordingPriority())
+                return a->GetRecordingPriority() > b->GetRecordingPriority();
+            if (a->GetRecordingStartTime() != b->GetRecordingStartTime())
+                return a->GetRecordingStartTime() < b->GetRecordingStartTime();
+            return a->GetProgramID() < b->GetProgramID();
+        });
+
+    conflictlists.resize(kCards);
+    for (auto *p : worklist)
+        conflictlists[(p->GetInputID() - 1) / kInputsPerCard].push_back(p);
+}
+
+// Scheduler::FindNextConflict() for one showing of the conflict list,
+// with every tuner of a card in one schedule group and SchedOpenEnd unset.
+static bool is_conflict(const RecordingInfo *p, const RecordingInfo *q,
+                        uint &affinity)
+{
+    if (p == q || q->GetRecordingStatus() != RecStatus::WillRecord)
+        return false;
+    if (p->GetInputID() != q->GetInputID())
+        return false;
+    if (p->GetRecordingEndTime() < q->GetRecordingStartTime() ||
+        p->GetRecordingStartTime() > q->GetRecordingEndTime())
+        return false;
+
+    // Showings on one multiplex can share the tuner
+    if (p->m_mplexId == q->m_mplexId)
+    {
+        ++affinity;
+        return false;
+    }
+    return (p->GetRecordingEndTime() != q->GetRecordingStartTime() &&
+            p->GetRecordingStartTime() != q->GetRecordingEndTime());
+}
+
+// The first pass of Scheduler::SchedNewRecords() over the work list: of
+// the showings of a program at one time, the one with the highest affinity
+// that has no conflict is recorded, and the program's other showings are
+// marked.  Returns the number of programs placed.
+static uint place(const RecList &worklist,
+                  const std::vector<RecList> &conflictlists, bool indexed)
+{
+    for (auto *p : worklist)
+        p->SetRecordingStatus(RecStatus::Unknown);
+
+    std::vector<SchedConflictIndex> indexes(conflictlists.size());
+    for (size_t i = 0; indexed && i < conflictlists.size(); ++i)
+        indexes[i].Build(conflictlists[i]);
+
+    QHash<QString, RecList> showings;
+    for (auto *p : worklist)
+        showings[p->GetProgramID()].push_back(p);
+
+    uint placed = 0;
+    auto i = worklist.cbegin();
+    while (i != worklist.cend())
+    {
+        if ((*i)->GetRecordingStatus() != RecStatus::Unknown)
+        {
+            ++i;
+            continue;
+        }
+
+        const RecordingInfo *first = *i;
+        RecordingInfo *best = nullptr;
+        uint bestaffinity = 0;
+        for ( ; i != worklist.cend(); ++i)
+        {
+            RecordingInfo *p = *i;
+            if (p->GetRecordingStartTime() != first->GetRecordingStartTime() ||
+                p->GetProgramID() != first->GetProgramID())
+                break;
+            if (p->GetRecordingStatus() != RecStatus::Unknown)
+                continue;
+
+            size_t card = (p->GetInputID() - 1) / kInputsPerCard;
+            RecList candidates;
+            if (indexed)
+                indexes[card].Candidates(conflictlists[card], p, candidates);
+            const RecList &list = indexed ? candidates : conflictlists[card];
+
+            // Every conflict is looked for, as FindConflict() does here
+            uint affinity = 0;
+            bool conflict = false;
+            for (const auto *q : list)
+                conflict = is_conflict(p, q, affinity) || conflict;
+
+            if (!conflict && (!best || affinity > bestaffinity))
+            {
+                best = p;
+                bestaffinity = affinity;
+            }
+        }
+
+        if (!best)
+            continue;
+
+        best->SetRecordingStatus(RecStatus::WillRecord);
+        for (auto *q : showings[best->GetProgramID()])
+        {
+            if (q == best || q->GetRecordingStatus() != RecStatus::Unknown)
+                continue;
+            q->SetRecordingStatus(
+                (q->GetRecordingStartTime() < best->GetRecordingStartTime())
+                ? RecStatus::LaterShowing : RecStatus::EarlierShowing);
+        }
+        placed++;
+    }
+    return placed;
+}
+
+void TestSchedConflictIndex::initTestCase(void)
+{
+    make_listings(m_listings, 30, 7);
+    qDebug() << "Synthetic listings:" << m_listings.size() << "showings";
+
+    make_schedule(m_workList, m_conflictLists, 200, 14);
+    qDebug() << "Synthetic schedule:" << m_workList.size() << "showings";
+}
+
+void TestSchedConflictIndex::cleanupTestCase(void)
+{
+    for (auto *p : m_listings)
+        delete p;
+    m_listings.clear();
+
+    m_conflictLists.clear();
+    for (auto *p : m_workList)
+        delete p;
+    m_workList.clear();
+}
+
+void TestSchedConflictIndex::EmptyIndex(void)
+{
+    RecList list;
+    SchedConflictIndex index;
+    index.Build(list);
+    QVERIFY(index.IsEmpty());
+
+    RecordingInfo *p = make_showing(1, 0, 30);
+    RecList candidates;
+    index.Candidates(list, p, candidates);
+    QVERIFY(candidates.empty());
+    delete p;
+}
+
+void TestSchedConflictIndex::TouchingShowings(void)
+{
+    // Showings ending exactly when another starts must be returned,
+    // FindNextConflict() decides whether those conflict.
+    RecList list;
+    list.push_back(make_showing(1, 0, 30));
+    list.push_back(make_showing(1, 30, 30));
+    list.push_back(make_showing(1, 60, 30));
+    list.push_back(make_showing(2, 0, 600)); // long showing, starts early
+
+    SchedConflictIndex index;
+    index.Build(list);
+
+    RecList candidates;
+    index.Candidates(list, list[2], candidates);
+    QCOMPARE(candidates.size(), size_t(3));
+    QCOMPARE(candidates[0], list[1]);
+    QCOMPARE(candidates[1], list[2]);
+    QCOMPARE(candidates[2], list[3]);
+
+    for (auto *p : list)
+        delete p;
+}
+
+void TestSchedConflictIndex::CandidatesMatchScan_data(void)
+{
+    QTest::addColumn<int>("step");
+    QTest::newRow("every 97th") << 97;
+    QTest::newRow("every 1009th") << 1009;
+}
+
+void TestSchedConflictIndex::CandidatesMatchScan(void)
+{
+    QFETCH(int, step);
+
+    SchedConflictIndex index;
+    index.Build(m_listings);
+
+    for (size_t i = 0; i < m_listings.size(); i += step)
+    {
+        const RecordingInfo *p = m_listings[i];
+        RecList candidates;
+        index.Candidates(m_listings, p, candidates);
+        QCOMPARE(candidates, scan(m_listings, p));
+    }
+}
+
+void TestSchedConflictIndex::PlacementMatchesScan(void)
+{
+    uint placed = place(m_workList, m_conflictLists, false);
+    std::vector<RecStatus::Type> scanned;
+    scanned.reserve(m_workList.size());
+    for (const auto *p : m_workList)
+        scanned.push_back(p->GetRecordingStatus());
+
+    QCOMPARE(place(m_workList, m_conflictLists, true), placed);
+    for (size_t i = 0; i < m_workList.size(); ++i)
+        QCOMPARE(m_workList[i]->GetRecordingStatus(), scanned[i]);
+
+    // Some programs can't be placed, so conflicts are being checked
+    QVERIFY(std::count(scanned.cbegin(), scanned.cend(), RecStatus::Unknown) > 0);
+}
+
+void TestSchedConflictIndex::BenchmarkPlacement_data(void)
+{
+    QTest::addColumn<bool>("indexed");
+    QTest::newRow("scan") << false;
+    QTest::newRow("index") << true;
+}
+
+void TestSchedConflictIndex::BenchmarkPlacement(void)
+{
+    QFETCH(bool, indexed);
+
+    uint placed = 0;
+    QBENCHMARK
+    {
+        placed = place(m_workList, m_conflictLists, indexed);
+    }
+    QVERIFY(placed > 0);
+}
+
+QTEST_APPLESS_MAIN(TestSchedConflictIndex)
@@ -5,7 +5,7 @@
 
 // MythTV headers
 #include "mythcorecontext.h"    /* gContext */
-#include "mythplayer.h"
+#include "mythcommflagplayer.h"
 
 // Commercial Flagging headers
 #include "CommDetector2.h"
@@ -387,14 +387,14 @@ BlankFrameDetector::BlankFrameDetector(std::shared_ptr<HistogramAnalyzer>ha,
 }
 
 enum FrameAnalyzer::analyzeFrameResult
-BlankFrameDetector::MythPlayerInited(MythPlayer *player, long long nframes)
+BlankFrameDetector::MythPlayerInited(MythCommFlagPlayer *player, long long nframes)
 {
     FrameAnalyzer::analyzeFrameResult ares =
         m_histogramAnalyzer->MythPlayerInited(player, nframes);
 
     m_fps = player->GetFrameRate();
 
-    QSize video_disp_dim = player->GetVideoSize();
+    QSize video_disp_dim = player->GetRawVideoSize();
 
     LOG(VB_COMMFLAG, LOG_INFO,
         QString("BlankFrameDetector::MythPlayerInited %1x%2")
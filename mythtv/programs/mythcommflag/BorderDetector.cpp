@@ -27,7 +27,7 @@ BorderDetector::BorderDetector(void)
 }
 
 int
-BorderDetector::MythPlayerInited(const MythPlayer *player)
+BorderDetector::MythPlayerInited(const MythCommFlagPlayer *player)
 {
     (void)player;  /* gcc */
     m_timeReported = false;
@@ -13,7 +13,7 @@
 #define BORDERDETECTOR_H
 
 using AVFrame = struct AVFrame;
-class MythPlayer;
+class MythCommFlagPlayer;
 class TemplateFinder;
 
 class BorderDetector
@@ -22,7 +22,7 @@ public:
     /* Ctor/dtor. */
     BorderDetector(void);
 
-    int MythPlayerInited(const MythPlayer *player);
+    int MythPlayerInited(const MythCommFlagPlayer *player);
     void setLogoState(TemplateFinder *finder);
 
     static const long long kUncached = -1;
@@ -2,7 +2,7 @@
 #include <cmath>
 
 // MythTV headers
-#include "mythplayer.h"
+#include "mythcommflagplayer.h"
 #include "mythframe.h"          // VideoFrame
 #include "mythlogging.h"
 
@@ -12,7 +12,7 @@ extern "C" {
 }
 #include "EdgeDetector.h"
 
-class MythPlayer;
+class MythCommFlagPlayer;
 
 class CannyEdgeDetector : public EdgeDetector
 {
@@ -21,7 +21,7 @@ public:
     ~CannyEdgeDetector(void) override;
     CannyEdgeDetector(const CannyEdgeDetector &) = delete;            // not copyable
     CannyEdgeDetector &operator=(const CannyEdgeDetector &) = delete; // not copyable
-    int MythPlayerInited(const MythPlayer *player, int width, int height);
+    int MythPlayerInited(const MythCommFlagPlayer *player, int width, int height);
     int setExcludeArea(int row, int col, int width, int height) override; // EdgeDetector
     const AVFrame *detectEdges(const AVFrame *pgm, int pgmheight,
             int percentile) override; // EdgeDetector
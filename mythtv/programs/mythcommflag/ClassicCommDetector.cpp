@@ -5,6 +5,7 @@
 #include <algorithm> // for min/max
 #include <iostream> // for cerr
 #include <thread> // for sleep_for
+#include <vector>
 
 // Qt headers
 #include <QCoreApplication>
@@ -20,6 +21,8 @@
 #include "ClassicCommDetector.h"
 #include "ClassicLogoDetector.h"
 #include "ClassicSceneChangeDetector.h"
+#include "CommFlagKernels.h"
+#include "FrameAnalysisPipeline.h"
 
 enum frameAspects {
     COMM_ASPECT_NORMAL = 0,
@@ -159,11 +162,13 @@ ClassicCommDetector::ClassicCommDetector(SkipType commDetectMethod_in,
 
     m_commDetectBlankCanHaveLogo =
         !!gCoreContext->GetBoolSetting("CommDetectBlankCanHaveLogo", true);
+    m_analysisThreads =
+        std::max(gCoreContext->GetNumSetting("CommDetectAnalysisThreads", 1), 1);
 }
 
 void ClassicCommDetector::Init()
 {
-    QSize video_disp_dim = m_player->GetVideoSize();
+    QSize video_disp_dim = m_player->GetRawVideoSize();
     m_width  = video_disp_dim.width();
     m_height = video_disp_dim.height();
     m_fps = m_player->GetFrameRate();
@@ -402,6 +407,10 @@ bool ClassicCommDetector::go()
     int prevpercent = -1;
 
     SetVideoParams(aspect);
+    BuildSampleMasks();
+
+    if (m_analysisThreads > 1)
+        StartPipeline(aspect);
 
     emit breathe();
 
@@ -414,6 +423,12 @@ bool ClassicCommDetector::go()
             startTime = nowAsDuration<std::chrono::microseconds>();
 
         MythVideoFrame* currentFrame = m_player->GetRawVideoFrame();
+        if (!currentFrame)
+        {
+            LOG(VB_GENERAL, LOG_ERR, "NVP: Unable to get a video frame.");
+            StopPipeline();
+            return false;
+        }
         long long currentFrameNumber = currentFrame->m_frameNumber;
 
         //Lucas: maybe we should make the nuppelvideoplayer send out a signal
@@ -423,7 +438,9 @@ bool ClassicCommDetector::go()
         float newAspect = currentFrame->m_aspect;
         if (newAspect != aspect)
         {
-            SetVideoParams(aspect);
+            // the pipeline does this when it merges the frame
+            if (!m_pipeline)
+                SetVideoParams(aspect);
             aspect = newAspect;
         }
 
@@ -435,6 +452,7 @@ bool ClassicCommDetector::go()
             if (m_bStop)
             {
                 m_player->DiscardVideoFrame(currentFrame);
+                StopPipeline();
                 return false;
             }
         }
@@ -544,7 +562,25 @@ bool ClassicCommDetector::go()
             }
         }
 
-        ProcessFrame(currentFrame, currentFrameNumber);
+        if (m_pipeline)
+        {
+            if (FrameIsUsable(currentFrame, currentFrameNumber))
+            {
+                ClassicFrameFeatures features;
+                while (m_pipeline->IsFull() &&
+                       m_pipeline->TakeResult(features, true))
+                    MergePipelineResult(features);
+                m_pipeline->Submit(currentFrame);
+            }
+
+            ClassicFrameFeatures features;
+            while (m_pipeline->TakeResult(features, false))
+                MergePipelineResult(features);
+        }
+        else
+        {
+            ProcessFrame(currentFrame, currentFrameNumber);
+        }
 
         if (m_stillRecording)
         {
@@ -575,6 +611,14 @@ bool ClassicCommDetector::go()
         m_player->DiscardVideoFrame(currentFrame);
     }
 
+    if (m_pipeline)
+    {
+        ClassicFrameFeatures features;
+        while (m_pipeline->TakeResult(features, true))
+            MergePipelineResult(features);
+        StopPipeline();
+    }
+
     if (m_showProgress)
     {
 #if 0
@@ -602,16 +646,16 @@ void ClassicCommDetector::sceneChangeDetectorHasNewInformation(
 {
     if (isSceneChange)
     {
-        m_frameInfo[framenum].flagMask |= COMM_FRAME_SCENE_CHANGE;
+        m_frameInfo.addFlags(framenum, COMM_FRAME_SCENE_CHANGE);
         m_sceneMap[framenum] = MARK_SCENE_CHANGE;
     }
     else
     {
-        m_frameInfo[framenum].flagMask &= ~COMM_FRAME_SCENE_CHANGE;
+        m_frameInfo.removeFlags(framenum, COMM_FRAME_SCENE_CHANGE);
         m_sceneMap.remove(framenum);
     }
 
-    m_frameInfo[framenum].sceneChangePercent = (int) (debugValue*100);
+    m_frameInfo.setSceneChangePercent(framenum, (int) (debugValue*100));
 }
 
 void ClassicCommDetector::GetCommercialBreakList(frm_dir_map_t &marks)
@@ -722,8 +766,8 @@ void ClassicCommDetector::SetVideoParams(float aspect)
         {
             // pretend that this frame is blank so that we can create test
             // blocks on real aspect ratio change boundaries.
-            m_frameInfo[m_curFrameNumber].flagMask |= COMM_FRAME_BLANK;
-            m_frameInfo[m_curFrameNumber].flagMask |= COMM_FRAME_ASPECT_CHANGE;
+            m_frameInfo.addFlags(m_curFrameNumber,
+                                 COMM_FRAME_BLANK | COMM_FRAME_ASPECT_CHANGE);
             m_decoderFoundAspectChanges = true;
         }
         else if (m_curFrameNumber != -1)
@@ -737,126 +781,172 @@ void ClassicCommDetector::SetVideoParams(float aspect)
     }
 }
 
-void ClassicCommDetector::ProcessFrame(MythVideoFrame *frame,
-                                       long long frame_number)
+/** \brief Starts analyzing frames on m_analysisThreads worker threads.
+ *
+ *  go() keeps decoding on its own thread and merges the analyzed frames
+ *  back in order with MergePipelineResult().
+ */
+void ClassicCommDetector::StartPipeline(float aspect)
 {
-    int max = 0;
-    int min = 255;
-    int blankPixelsChecked = 0;
-    long long totBrightness = 0;
-    auto *rowMax = new unsigned char[m_height];
-    auto *colMax = new unsigned char[m_width];
-    memset(rowMax, 0, sizeof(*rowMax)*m_height);
-    memset(colMax, 0, sizeof(*colMax)*m_width);
-    int topDarkRow = m_commDetectBorder;
-    int bottomDarkRow = m_height - m_commDetectBorder - 1;
-    int leftDarkCol = m_commDetectBorder;
-    int rightDarkCol = m_width - m_commDetectBorder - 1;
-    FrameInfoEntry fInfo {};
+    m_pipelineAspect = aspect;
+    m_pipeline = new FrameAnalysisPipeline(
+        [this](const MythVideoFrame *frame, ClassicFrameFeatures &features)
+            { AnalyzeFrame(frame, features); },
+        m_analysisThreads, m_analysisThreads * 4);
+}
+
+void ClassicCommDetector::StopPipeline(void)
+{
+    delete m_pipeline;
+    m_pipeline = nullptr;
+}
+
+void ClassicCommDetector::MergePipelineResult(
+    const ClassicFrameFeatures &features)
+{
+    // Same aspect polling as go() does when not using the pipeline
+    if (features.m_aspect != m_pipelineAspect)
+    {
+        SetVideoParams(m_pipelineAspect);
+        m_pipelineAspect = features.m_aspect;
+    }
+
+    ApplyFrameFeatures(features);
+}
 
+bool ClassicCommDetector::FrameIsUsable(const MythVideoFrame *frame,
+                                        long long frame_number) const
+{
     if (!frame || !(frame->m_buffer) || frame_number == -1 ||
         frame->m_type != FMT_YV12)
     {
         LOG(VB_COMMFLAG, LOG_ERR, "CommDetect: Invalid video frame or codec, "
                                   "unable to process frame.");
-        delete[] rowMax;
-        delete[] colMax;
-        return;
+        return false;
     }
 
     if (!m_width || !m_height)
     {
         LOG(VB_COMMFLAG, LOG_ERR, "CommDetect: Width or Height is 0, "
                                   "unable to process frame.");
-        delete[] rowMax;
-        delete[] colMax;
-        return;
+        return false;
     }
 
-    m_curFrameNumber = frame_number;
-    unsigned char* framePtr = frame->m_buffer;
-    int bytesPerLine = frame->m_pitches[0];
-
-    fInfo.minBrightness = -1;
-    fInfo.maxBrightness = -1;
-    fInfo.avgBrightness = -1;
-    fInfo.sceneChangePercent = -1;
-    fInfo.aspect = m_currentAspect;
-    fInfo.format = COMM_FORMAT_NORMAL;
-    fInfo.flagMask = 0;
-
-    int& flagMask = m_frameInfo[m_curFrameNumber].flagMask;
-
-    // Fill in dummy info records for skipped frames.
-    if (m_lastFrameNumber != (m_curFrameNumber - 1))
-    {
-        if (m_lastFrameNumber > 0)
-        {
-            fInfo.aspect = m_frameInfo[m_lastFrameNumber].aspect;
-            fInfo.format = m_frameInfo[m_lastFrameNumber].format;
-        }
-        fInfo.flagMask = COMM_FRAME_SKIPPED;
-
-        m_lastFrameNumber++;
-        while(m_lastFrameNumber < m_curFrameNumber)
-            m_frameInfo[m_lastFrameNumber++] = fInfo;
-
-        fInfo.flagMask = 0;
-    }
-    m_lastFrameNumber = m_curFrameNumber;
+    return true;
+}
 
-    m_frameInfo[m_curFrameNumber] = fInfo;
+void ClassicCommDetector::ProcessFrame(MythVideoFrame *frame,
+                                       long long frame_number)
+{
+    if (!FrameIsUsable(frame, frame_number))
+        return;
 
-    if (m_commDetectMethod & COMM_DETECT_BLANKS)
-        m_frameIsBlank = false;
+    ClassicFrameFeatures features;
+    features.m_frameNumber = frame_number;
+    AnalyzeFrame(frame, features);
+    ApplyFrameFeatures(features);
 
-    if (m_commDetectMethod & COMM_DETECT_SCENE)
-    {
-        m_sceneChangeDetector->processFrame(frame);
-    }
+#ifdef SHOW_DEBUG_WIN
+    comm_debug_show(frame->buf);
+    getchar();
+#endif
+}
 
-    m_stationLogoPresent = false;
+/** \brief Precomputes which pixels of each sampled row AnalyzeFrame()
+ *         looks at.
+ *
+ *  The samples are the same in every frame, so they are kept as byte masks
+ *  the width of a frame that CommFlagKernels::SampledRow() can apply to a
+ *  whole row at once. Rows crossing the logo share a second mask.
+ */
+void ClassicCommDetector::BuildSampleMasks(void)
+{
+    m_sampleMasks.clear();
+    m_sampleMaskCounts.clear();
+    m_rowSampleMask.assign(m_height, -1);
 
     for(int y = m_commDetectBorder; y < (m_height - m_commDetectBorder);
             y += m_vertSpacing)
     {
+        std::vector<unsigned char> mask(m_width, 0);
+        int count = 0;
         for(int x = m_commDetectBorder; x < (m_width - m_commDetectBorder);
                 x += m_horizSpacing)
         {
-            uchar pixel = framePtr[y * bytesPerLine + x];
+            bool checkPixel = false;
+            if (!m_commDetectBlankCanHaveLogo)
+                checkPixel = true;
 
-            if (m_commDetectMethod & COMM_DETECT_BLANKS)
-            {
-                 bool checkPixel = false;
-                 if (!m_commDetectBlankCanHaveLogo)
-                     checkPixel = true;
+            if (!m_logoInfoAvailable ||
+                !m_logoDetector->pixelInsideLogo(x,y))
+                checkPixel=true;
 
-                 if (!m_logoInfoAvailable ||
-                     !m_logoDetector->pixelInsideLogo(x,y))
-                     checkPixel=true;
+            if (checkPixel)
+            {
+                mask[x] = 0xFF;
+                count++;
+            }
+        }
 
-                 if (checkPixel)
-                 {
-                     blankPixelsChecked++;
-                     totBrightness += pixel;
+        auto it = std::find(m_sampleMasks.cbegin(), m_sampleMasks.cend(), mask);
+        if (it == m_sampleMasks.cend())
+        {
+            m_sampleMasks.push_back(mask);
+            m_sampleMaskCounts.push_back(count);
+            it = m_sampleMasks.cend() - 1;
+        }
+        m_rowSampleMask[y] = it - m_sampleMasks.cbegin();
+    }
+}
 
-                     if (pixel < min)
-                          min = pixel;
+/** \brief Takes the measurements of a single frame.
+ *
+ *  This only reads the detector's settings, so it may run on several
+ *  frames concurrently. Everything that depends on earlier frames is
+ *  done by ApplyFrameFeatures().
+ */
+void ClassicCommDetector::AnalyzeFrame(const MythVideoFrame *frame,
+                                       ClassicFrameFeatures &features) const
+{
+    static thread_local std::vector<unsigned char> rowMax;
+    static thread_local std::vector<unsigned char> colMax;
+    rowMax.assign(m_height, 0);
+    colMax.assign(m_width, 0);
+    int topDarkRow = m_commDetectBorder;
+    int bottomDarkRow = m_height - m_commDetectBorder - 1;
+    int leftDarkCol = m_commDetectBorder;
+    int rightDarkCol = m_width - m_commDetectBorder - 1;
+    long long totBrightness = 0;
 
-                     if (pixel > max)
-                          max = pixel;
+    const unsigned char* framePtr = frame->m_buffer;
+    int bytesPerLine = frame->m_pitches[0];
 
-                     if (pixel > rowMax[y])
-                         rowMax[y] = pixel;
+    if (m_commDetectMethod & COMM_DETECT_SCENE)
+        m_sceneChangeDetector->generateHistogram(frame, features.m_histogram);
 
-                     if (pixel > colMax[x])
-                         colMax[x] = pixel;
-                 }
-            }
+    if (m_commDetectMethod & COMM_DETECT_BLANKS)
+    {
+        for(int y = m_commDetectBorder; y < (m_height - m_commDetectBorder);
+                y += m_vertSpacing)
+        {
+            int mask = m_rowSampleMask[y];
+            CommFlagKernels::RowStats stats;
+            CommFlagKernels::SampledRow(framePtr + (y * bytesPerLine),
+                                        m_sampleMasks[mask].data(), m_width,
+                                        colMax.data(), stats);
+
+            features.m_blankPixelsChecked += m_sampleMaskCounts[mask];
+            totBrightness += stats.m_sum;
+            features.m_minBrightness =
+                std::min<int>(features.m_minBrightness, stats.m_min);
+            features.m_maxBrightness =
+                std::max<int>(features.m_maxBrightness, stats.m_max);
+            rowMax[y] = stats.m_max;
         }
     }
 
-    if ((m_commDetectMethod & COMM_DETECT_BLANKS) && blankPixelsChecked)
+    if ((m_commDetectMethod & COMM_DETECT_BLANKS) &&
+        features.m_blankPixelsChecked)
     {
         for(int y = m_commDetectBorder; y < (m_height - m_commDetectBorder);
                 y += m_vertSpacing)
@@ -871,9 +961,6 @@ void ClassicCommDetector::ProcessFrame(MythVideoFrame *frame,
             if (rowMax[y] >= m_commDetectBoxBrightness)
                 bottomDarkRow = y;
 
-        delete[] rowMax;
-        rowMax = nullptr;
-
         for(int x = m_commDetectBorder; x < (m_width - m_commDetectBorder);
                 x += m_horizSpacing)
         {
@@ -887,30 +974,91 @@ void ClassicCommDetector::ProcessFrame(MythVideoFrame *frame,
             if (colMax[x] >= m_commDetectBoxBrightness)
                 rightDarkCol = x;
 
-        delete[] colMax;
-        colMax = nullptr;
-
-        m_frameInfo[m_curFrameNumber].format = COMM_FORMAT_NORMAL;
+        features.m_format = COMM_FORMAT_NORMAL;
         if ((topDarkRow > m_commDetectBorder) &&
             (topDarkRow < (m_height * .20)) &&
             (bottomDarkRow < (m_height - m_commDetectBorder)) &&
             (bottomDarkRow > (m_height * .80)))
         {
-            m_frameInfo[m_curFrameNumber].format |= COMM_FORMAT_LETTERBOX;
+            features.m_format |= COMM_FORMAT_LETTERBOX;
         }
         if ((leftDarkCol > m_commDetectBorder) &&
                  (leftDarkCol < (m_width * .20)) &&
                  (rightDarkCol < (m_width - m_commDetectBorder)) &&
                  (rightDarkCol > (m_width * .80)))
         {
-            m_frameInfo[m_curFrameNumber].format |= COMM_FORMAT_PILLARBOX;
+            features.m_format |= COMM_FORMAT_PILLARBOX;
+        }
+
+        features.m_avgBrightness = totBrightness / features.m_blankPixelsChecked;
+    }
+
+    if ((m_logoInfoAvailable) && (m_commDetectMethod & COMM_DETECT_LOGO))
+    {
+        features.m_logoPresent =
+            m_logoDetector->doesThisFrameContainTheFoundLogo(frame);
+    }
+}
+
+/** \brief Adds the measurements of the next frame to the frame info and
+ *         break maps. Frames must be passed in decoding order.
+ */
+void ClassicCommDetector::ApplyFrameFeatures(
+    const ClassicFrameFeatures &features)
+{
+    FrameInfoEntry fInfo {};
+
+    m_curFrameNumber = features.m_frameNumber;
+
+    fInfo.minBrightness = -1;
+    fInfo.maxBrightness = -1;
+    fInfo.avgBrightness = -1;
+    fInfo.sceneChangePercent = -1;
+    fInfo.aspect = m_currentAspect;
+    fInfo.format = COMM_FORMAT_NORMAL;
+    fInfo.flagMask = 0;
+
+    int flagMask = 0;
+
+    // Fill in dummy info records for skipped frames.
+    if (m_lastFrameNumber != (m_curFrameNumber - 1))
+    {
+        if (m_lastFrameNumber > 0)
+        {
+            fInfo.aspect = m_frameInfo.aspect(m_lastFrameNumber);
+            fInfo.format = m_frameInfo.format(m_lastFrameNumber);
         }
+        fInfo.flagMask = COMM_FRAME_SKIPPED;
+
+        m_lastFrameNumber++;
+        while(m_lastFrameNumber < m_curFrameNumber)
+            m_frameInfo.set(m_lastFrameNumber++, fInfo);
+
+        fInfo.flagMask = 0;
+    }
+    m_lastFrameNumber = m_curFrameNumber;
+
+    m_frameInfo.set(m_curFrameNumber, fInfo);
+
+    if (m_commDetectMethod & COMM_DETECT_BLANKS)
+        m_frameIsBlank = false;
+
+    if (m_commDetectMethod & COMM_DETECT_SCENE)
+    {
+        m_sceneChangeDetector->processHistogram(features.m_histogram);
+    }
+
+    m_stationLogoPresent = false;
 
-        int avg = totBrightness / blankPixelsChecked;
+    if ((m_commDetectMethod & COMM_DETECT_BLANKS) &&
+        features.m_blankPixelsChecked)
+    {
+        int min = features.m_minBrightness;
+        int max = features.m_maxBrightness;
+        int avg = features.m_avgBrightness;
 
-        m_frameInfo[m_curFrameNumber].minBrightness = min;
-        m_frameInfo[m_curFrameNumber].maxBrightness = max;
-        m_frameInfo[m_curFrameNumber].avgBrightness = avg;
+        m_frameInfo.setBrightness(m_curFrameNumber, features.m_format,
+                                  min, max, avg);
 
         m_totalMinBrightness += min;
         m_commDetectDimAverage = min + 10;
@@ -934,10 +1082,7 @@ void ClassicCommDetector::ProcessFrame(MythVideoFrame *frame,
     }
 
     if ((m_logoInfoAvailable) && (m_commDetectMethod & COMM_DETECT_LOGO))
-    {
-        m_stationLogoPresent =
-            m_logoDetector->doesThisFrameContainTheFoundLogo(frame);
-    }
+        m_stationLogoPresent = features.m_logoPresent;
 
 #if 0
     if ((m_commDetectMethod == COMM_DETECT_ALL) &&
@@ -957,6 +1102,9 @@ void ClassicCommDetector::ProcessFrame(MythVideoFrame *frame,
     if (m_stationLogoPresent)
         flagMask |= COMM_FRAME_LOGO_PRESENT;
 
+    // The scene change detector may already have flagged this frame.
+    m_frameInfo.addFlags(m_curFrameNumber, flagMask);
+
     //TODO: move this debugging code out of the perframe loop, and do it after
     // we've processed all frames. this is because a scenechangedetector can
     // now use a few frames to determine whether the frame a few frames ago was
@@ -967,25 +1115,19 @@ void ClassicCommDetector::ProcessFrame(MythVideoFrame *frame,
 
     if (m_verboseDebugging)
     {
+        FrameInfoEntry info = m_frameInfo.at(m_curFrameNumber);
         LOG(VB_COMMFLAG, LOG_DEBUG, QString("Frame: %1 -> %2 %3 %4 %5 %6 %7 %8")
             .arg(m_curFrameNumber, 6)
-            .arg(m_frameInfo[m_curFrameNumber].minBrightness, 3)
-            .arg(m_frameInfo[m_curFrameNumber].maxBrightness, 3)
-            .arg(m_frameInfo[m_curFrameNumber].avgBrightness, 3)
-            .arg(m_frameInfo[m_curFrameNumber].sceneChangePercent, 3)
-            .arg(m_frameInfo[m_curFrameNumber].format, 1)
-            .arg(m_frameInfo[m_curFrameNumber].aspect, 1)
-            .arg(m_frameInfo[m_curFrameNumber].flagMask, 4, 16, QChar('0')));
+            .arg(info.minBrightness, 3)
+            .arg(info.maxBrightness, 3)
+            .arg(info.avgBrightness, 3)
+            .arg(info.sceneChangePercent, 3)
+            .arg(info.format, 1)
+            .arg(info.aspect, 1)
+            .arg(info.flagMask, 4, 16, QChar('0')));
     }
 
-#ifdef SHOW_DEBUG_WIN
-    comm_debug_show(frame->buf);
-    getchar();
-#endif
-
     m_framesProcessed++;
-    delete[] rowMax;
-    delete[] colMax;
 }
 
 void ClassicCommDetector::ClearAllMaps(void)
@@ -1135,13 +1277,10 @@ frm_dir_map_t ClassicCommDetector::Combine2Maps(const frm_dir_map_t &a,
     return newMap;
 }
 
-void ClassicCommDetector::UpdateFrameBlock(FrameBlock *fbp,
-                                           const FrameInfoEntry& finfo,
-                                           int format, int aspect)
+void ClassicCommDetector::UpdateFrameBlock(FrameBlock *fbp, long long frame,
+                                           int format, int aspect) const
 {
-    int value = 0;
-
-    value = finfo.flagMask;
+    int value = m_frameInfo.flagMask(frame);
 
     if (value & COMM_FRAME_LOGO_PRESENT)
         fbp->logoCount++;
@@ -1152,10 +1291,10 @@ void ClassicCommDetector::UpdateFrameBlock(FrameBlock *fbp,
     if (value & COMM_FRAME_SCENE_CHANGE)
         fbp->scCount++;
 
-    if (finfo.format == format)
+    if (m_frameInfo.format(frame) == format)
         fbp->formatMatch++;
 
-    if (finfo.aspect == aspect)
+    if (m_frameInfo.aspect(frame) == aspect)
         fbp->aspectMatch++;
 }
 
@@ -1220,7 +1359,7 @@ void ClassicCommDetector::BuildAllMethodsCommList(void)
              i < ((int64_t)m_framesProcessed - (int64_t)m_postRoll); i++)
         {
             if ((m_frameInfo.contains(i)) &&
-                (m_frameInfo[i].aspect == COMM_ASPECT_NORMAL))
+                (m_frameInfo.aspect(i) == COMM_ASPECT_NORMAL))
                 aspectFrames++;
         }
 
@@ -1238,9 +1377,8 @@ void ClassicCommDetector::BuildAllMethodsCommList(void)
             i < ((int64_t)m_framesProcessed - (int64_t)m_postRoll); i++ )
         {
             if ((m_frameInfo.contains(i)) &&
-                (m_frameInfo[i].format >= 0) &&
-                (m_frameInfo[i].format < COMM_FORMAT_MAX))
-                formatCounts[m_frameInfo[i].format]++;
+                (m_frameInfo.format(i) < COMM_FORMAT_MAX))
+                formatCounts[m_frameInfo.format(i)]++;
         }
 
         uint64_t formatFrames = 0;
@@ -1254,12 +1392,14 @@ void ClassicCommDetector::BuildAllMethodsCommList(void)
         }
     }
 
+    int nextValue = m_frameInfo.flagMask(curFrame);
     while (curFrame <= m_framesProcessed)
     {
-        int value = m_frameInfo[curFrame].flagMask;
+        int value = nextValue;
+        nextValue = m_frameInfo.flagMask(curFrame + 1);
 
         bool nextFrameIsBlank = ((curFrame + 1) <= m_framesProcessed) &&
-            ((m_frameInfo[curFrame + 1].flagMask & COMM_FRAME_BLANK) != 0);
+            ((nextValue & COMM_FRAME_BLANK) != 0);
 
         if (value & COMM_FRAME_BLANK)
         {
@@ -1267,7 +1407,7 @@ void ClassicCommDetector::BuildAllMethodsCommList(void)
 
             if (!nextFrameIsBlank || !lastFrameWasBlank)
             {
-                UpdateFrameBlock(fbp, m_frameInfo[curFrame], format, aspect);
+                UpdateFrameBlock(fbp, curFrame, format, aspect);
 
                 fbp->end = curFrame;
                 fbp->frames = fbp->end - fbp->start + 1;
@@ -1297,7 +1437,7 @@ void ClassicCommDetector::BuildAllMethodsCommList(void)
             lastFrameWasBlank = false;
         }
 
-        UpdateFrameBlock(fbp, m_frameInfo[curFrame], format, aspect);
+        UpdateFrameBlock(fbp, curFrame, format, aspect);
 
         if ((value & COMM_FRAME_LOGO_PRESENT) &&
             (firstLogoFrame == -1))
@@ -1836,10 +1976,10 @@ void ClassicCommDetector::BuildAllMethodsCommList(void)
             uint64_t lastStartLower = it.key();
             uint64_t lastStartUpper = it.key();
             while ((lastStartLower > 0) &&
-                   ((m_frameInfo[lastStartLower - 1].flagMask & COMM_FRAME_BLANK) != 0))
+                   ((m_frameInfo.flagMask(lastStartLower - 1) & COMM_FRAME_BLANK) != 0))
                 lastStartLower--;
             while ((lastStartUpper < (m_framesProcessed - (2 * m_fps))) &&
-                   ((m_frameInfo[lastStartUpper + 1].flagMask & COMM_FRAME_BLANK) != 0))
+                   ((m_frameInfo.flagMask(lastStartUpper + 1) & COMM_FRAME_BLANK) != 0))
                 lastStartUpper++;
             uint64_t adj = (lastStartUpper - lastStartLower) / 2;
             if (adj > MAX_BLANK_FRAMES)
@@ -1857,10 +1997,10 @@ void ClassicCommDetector::BuildAllMethodsCommList(void)
             uint64_t lastEndLower = it.key();
             uint64_t lastEndUpper = it.key();
             while ((lastEndUpper < (m_framesProcessed - (2 * m_fps))) &&
-                   ((m_frameInfo[lastEndUpper + 1].flagMask & COMM_FRAME_BLANK) != 0))
+                   ((m_frameInfo.flagMask(lastEndUpper + 1) & COMM_FRAME_BLANK) != 0))
                 lastEndUpper++;
             while ((lastEndLower > 0) &&
-                   ((m_frameInfo[lastEndLower - 1].flagMask & COMM_FRAME_BLANK) != 0))
+                   ((m_frameInfo.flagMask(lastEndLower - 1) & COMM_FRAME_BLANK) != 0))
                 lastEndLower--;
             uint64_t adj = (lastEndUpper - lastEndLower) / 2;
             if (adj > MAX_BLANK_FRAMES)
@@ -2413,7 +2553,7 @@ void ClassicCommDetector::CleanupFrameInfo(void)
         avgHistogram.fill(0);
 
         for (uint64_t i = 1; i <= m_framesProcessed; i++)
-            avgHistogram[clamp(m_frameInfo[i].avgBrightness, 0, 255)] += 1;
+            avgHistogram[clamp(m_frameInfo.avgBrightness(i), 0, 255)] += 1;
 
         for (int i = 1; i <= 255 && minAvg == -1; i++)
             if (avgHistogram[i] > (m_framesProcessed * 0.0004))
@@ -2427,13 +2567,12 @@ void ClassicCommDetector::CleanupFrameInfo(void)
 
         for (uint64_t i = 1; i <= m_framesProcessed; i++)
         {
-            int value = m_frameInfo[i].flagMask;
-            m_frameInfo[i].flagMask = value & ~COMM_FRAME_BLANK;
+            int value = m_frameInfo.flagMask(i);
+            m_frameInfo.setFlagMask(i, value & ~COMM_FRAME_BLANK);
 
-            if (( (m_frameInfo[i].flagMask & COMM_FRAME_BLANK) == 0) &&
-                (m_frameInfo[i].avgBrightness < newThreshold))
+            if (m_frameInfo.avgBrightness(i) < newThreshold)
             {
-                m_frameInfo[i].flagMask = value | COMM_FRAME_BLANK;
+                m_frameInfo.setFlagMask(i, value | COMM_FRAME_BLANK);
                 m_blankFrameMap[i] = MARK_BLANK_FRAME;
                 m_blankFrameCount++;
             }
@@ -2445,34 +2584,37 @@ void ClassicCommDetector::CleanupFrameInfo(void)
     }
 
     // try to account for fuzzy logo detection
-    for (uint64_t i = 1; i <= m_framesProcessed; i++)
-    {
-        if ((i < 10) || ((i+10) > m_framesProcessed))
-            continue;
-
-        int before = 0;
-        for (int offset = 1; offset <= 10; offset++)
-            if ((m_frameInfo[i - offset].flagMask & COMM_FRAME_LOGO_PRESENT) != 0)
-                before++;
-
-        int after = 0;
-        for (int offset = 1; offset <= 10; offset++)
-            if ((m_frameInfo[i + offset].flagMask & COMM_FRAME_LOGO_PRESENT) != 0)
-                after++;
-
-        int value = m_frameInfo[i].flagMask;
-        if (value == -1)
-            m_frameInfo[i].flagMask = 0;
+    //
+    // "before" and "after" count the logo frames among the 10 frames on
+    // either side of frame i. They are slid along with i rather than
+    // recounted, "before" picking up the frames already corrected.
+    auto hasLogo = [this](uint64_t f)
+        { return (m_frameInfo.flagMask(f) & COMM_FRAME_LOGO_PRESENT) ? 1 : 0; };
+    int before = 0;
+    int after = 0;
+    for (uint64_t offset = 1; offset <= 10; offset++)
+    {
+        before += hasLogo(10 - offset);
+        after += hasLogo(10 + offset);
+    }
+    for (uint64_t i = 10; (i + 10) <= m_framesProcessed; i++)
+    {
+        if (i > 10)
+        {
+            before += hasLogo(i - 1) - hasLogo(i - 11);
+            after += hasLogo(i + 10) - hasLogo(i);
+        }
 
+        int value = m_frameInfo.flagMask(i);
         if (value & COMM_FRAME_LOGO_PRESENT)
         {
             if ((before < 4) && (after < 4))
-                m_frameInfo[i].flagMask = value & ~COMM_FRAME_LOGO_PRESENT;
+                m_frameInfo.setFlagMask(i, value & ~COMM_FRAME_LOGO_PRESENT);
         }
         else
         {
             if ((before > 6) && (after > 6))
-                m_frameInfo[i].flagMask = value | COMM_FRAME_LOGO_PRESENT;
+                m_frameInfo.setFlagMask(i, value | COMM_FRAME_LOGO_PRESENT);
         }
     }
 }
@@ -2488,7 +2630,7 @@ void ClassicCommDetector::GetLogoCommBreakMap(show_map_t &map)
     for (uint64_t curFrame = 1 ; curFrame <= m_framesProcessed; curFrame++)
     {
         bool CurrentFrameLogo =
-            (m_frameInfo[curFrame].flagMask & COMM_FRAME_LOGO_PRESENT) != 0;
+            (m_frameInfo.flagMask(curFrame) & COMM_FRAME_LOGO_PRESENT) != 0;
 
         if (!PrevFrameLogo && CurrentFrameLogo)
             map[curFrame] = MARK_START;
@@ -2515,11 +2657,10 @@ void ClassicCommDetector::PrintFullMap(
 
     for (long long i = 1; i < m_curFrameNumber; i++)
     {
-        QMap<long long, FrameInfoEntry>::const_iterator it = m_frameInfo.find(i);
-        if (it == m_frameInfo.end())
+        if (!m_frameInfo.contains(i))
             continue;
 
-        QByteArray atmp = (*it).toString(i, verbose).toLatin1();
+        QByteArray atmp = m_frameInfo.at(i).toString(i, verbose).toLatin1();
         out << atmp.constData() << " ";
         if (comm_breaks)
         {
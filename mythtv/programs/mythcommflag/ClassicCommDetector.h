@@ -3,6 +3,7 @@
 
 // C++ headers
 #include <cstdint>
+#include <vector>
 
 // Qt headers
 #include <QObject>
@@ -15,10 +16,13 @@
 
 // Commercial Flagging headers
 #include "CommDetectorBase.h"
+#include "FrameInfoStore.h"
+#include "Histogram.h"
 
 class MythCommFlagPlayer;
 class LogoDetectorBase;
-class SceneChangeDetectorBase;
+class ClassicSceneChangeDetector;
+class FrameAnalysisPipeline;
 
 enum frameMaskValues {
     COMM_FRAME_SKIPPED       = 0x0001,
@@ -29,18 +33,19 @@ enum frameMaskValues {
     COMM_FRAME_RATING_SYMBOL = 0x0020
 };
 
-class FrameInfoEntry
+/// The per-frame measurements ClassicCommDetector takes of one frame,
+/// before they are combined with those of the previous frames.
+struct ClassicFrameFeatures
 {
-  public:
-    int minBrightness;
-    int maxBrightness;
-    int avgBrightness;
-    int sceneChangePercent;
-    int aspect;
-    int format;
-    int flagMask;
-    static QString GetHeader(void);
-    QString toString(uint64_t frame, bool verbose) const;
+    long long    m_frameNumber        {-1};
+    float        m_aspect             {-1.0F};
+    int          m_blankPixelsChecked {0};
+    int          m_minBrightness      {255};
+    int          m_maxBrightness      {0};
+    int          m_avgBrightness      {0};
+    int          m_format             {0};
+    bool         m_logoPresent        {false};
+    Histogram    m_histogram;
 };
 
 class ClassicCommDetector : public CommDetectorBase
@@ -96,8 +101,8 @@ class ClassicCommDetector : public CommDetectorBase
                                int64_t start_frame);
         frm_dir_map_t Combine2Maps(
             const frm_dir_map_t &a, const frm_dir_map_t &b) const;
-        static void UpdateFrameBlock(FrameBlock *fbp, const FrameInfoEntry& finfo,
-                              int format, int aspect);
+        void UpdateFrameBlock(FrameBlock *fbp, long long frame,
+                              int format, int aspect) const;
         void BuildAllMethodsCommList(void);
         void BuildBlankFrameCommList(void);
         void BuildSceneChangeCommList(void);
@@ -160,7 +165,15 @@ class ClassicCommDetector : public CommDetectorBase
 
         bool m_decoderFoundAspectChanges   {false};
 
-        SceneChangeDetectorBase* m_sceneChangeDetector {nullptr};
+        ClassicSceneChangeDetector* m_sceneChangeDetector {nullptr};
+
+        std::vector<std::vector<unsigned char> > m_sampleMasks;
+        std::vector<int> m_sampleMaskCounts;
+        std::vector<int> m_rowSampleMask;
+
+        uint m_analysisThreads             {1};
+        FrameAnalysisPipeline *m_pipeline  {nullptr};
+        float m_pipelineAspect             {-1.0F};
 
 protected:
         MythCommFlagPlayer *m_player       {nullptr};
@@ -181,7 +194,16 @@ protected:
         void Init();
         void SetVideoParams(float aspect);
         void ProcessFrame(MythVideoFrame *frame, long long frame_number);
-        QMap<long long, FrameInfoEntry> m_frameInfo;
+        bool FrameIsUsable(const MythVideoFrame *frame,
+                           long long frame_number) const;
+        void AnalyzeFrame(const MythVideoFrame *frame,
+                          ClassicFrameFeatures &features) const;
+        void ApplyFrameFeatures(const ClassicFrameFeatures &features);
+        void MergePipelineResult(const ClassicFrameFeatures &features);
+        void BuildSampleMasks(void);
+        void StartPipeline(float aspect);
+        void StopPipeline(void);
+        FrameInfoStore m_frameInfo;
 
 public slots:
         void sceneChangeDetectorHasNewInformation(unsigned int framenum, bool isSceneChange,float debugValue);
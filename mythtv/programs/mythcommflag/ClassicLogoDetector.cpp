@@ -112,6 +112,11 @@ bool ClassicLogoDetector::searchForLogo(MythCommFlagPlayer *player)
         while (loops < maxLoops && player->GetEof() == kEofStateNone)
         {
             MythVideoFrame* vf = player->GetRawVideoFrame(seekFrame);
+            if (!vf)
+            {
+                delete[] edgeCounts;
+                return false;
+            }
 
             if ((loops % 50) == 0)
                 m_commDetector->logoDetectorBreathe();
@@ -361,7 +366,7 @@ void ClassicLogoDetector::DumpLogo(bool fromCurrentFrame,
  * which are partially mods based on Myth's original commercial skip
  * code written by Chris Pinkham. */
 bool ClassicLogoDetector::doesThisFrameContainTheFoundLogo(
-    MythVideoFrame* frame)
+    const MythVideoFrame* frame) const
 {
     int radius = 2;
     int goodEdges = 0;
@@ -369,7 +374,7 @@ bool ClassicLogoDetector::doesThisFrameContainTheFoundLogo(
     int testEdges = 0;
     int testNotEdges = 0;
 
-    unsigned char* framePtr = frame->m_buffer;
+    const unsigned char* framePtr = frame->m_buffer;
     int bytesPerLine = frame->m_pitches[0];
 
     for (uint y = m_logoMinY; y <= m_logoMaxY; y++ )
@@ -415,7 +420,6 @@ bool ClassicLogoDetector::doesThisFrameContainTheFoundLogo(
         }
     }
 
-    m_frameNumber++;
     double goodEdgeRatio = (testEdges) ?
         (double)goodEdges / (double)testEdges : 0.0;
     double badEdgeRatio = (testNotEdges) ?
@@ -14,7 +14,7 @@ class ClassicLogoDetector : public LogoDetectorBase
     virtual void deleteLater(void);
 
     bool searchForLogo(MythCommFlagPlayer* player) override; // LogoDetectorBase
-    bool doesThisFrameContainTheFoundLogo(MythVideoFrame* frame) override; // LogoDetectorBase
+    bool doesThisFrameContainTheFoundLogo(const MythVideoFrame* frame) const override; // LogoDetectorBase
     bool pixelInsideLogo(unsigned int x, unsigned int y) override; // LogoDetectorBase
 
     unsigned int getRequiredAvailableBufferForSearch() override; // LogoDetectorBase
@@ -28,7 +28,6 @@ class ClassicLogoDetector : public LogoDetectorBase
     void DetectEdges(MythVideoFrame *frame, EdgeMaskEntry *edges, int edgeDiff);
 
     ClassicCommDetector *m_commDetector                    {nullptr};
-    unsigned int         m_frameNumber                     {0};
     unsigned int         m_commDetectBorder                {16};
 
     int                  m_commDetectLogoSamplesNeeded     {240};
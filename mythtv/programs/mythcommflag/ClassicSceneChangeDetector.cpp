@@ -28,17 +28,30 @@ void ClassicSceneChangeDetector::deleteLater(void)
 
 void ClassicSceneChangeDetector::processFrame(MythVideoFrame* frame)
 {
-    m_histogram->generateFromImage(frame, m_width, m_height, m_commdetectborder,
-                                 m_width-m_commdetectborder, m_commdetectborder,
-                                 m_height-m_commdetectborder, m_xspacing, m_yspacing);
-    float similar = m_histogram->calculateSimilarityWith(*m_previousHistogram);
+    generateHistogram(frame, *m_histogram);
+    processHistogram(*m_histogram);
+}
+
+/// \brief Builds the histogram of a frame. Safe to call from any thread.
+void ClassicSceneChangeDetector::generateHistogram(const MythVideoFrame* frame,
+                                                   Histogram &histogram) const
+{
+    histogram.generateFromImage(frame, m_width, m_height, m_commdetectborder,
+                                m_width-m_commdetectborder, m_commdetectborder,
+                                m_height-m_commdetectborder, m_xspacing, m_yspacing);
+}
+
+/// \brief Compares the histogram of the next frame with the previous one.
+void ClassicSceneChangeDetector::processHistogram(const Histogram &histogram)
+{
+    float similar = histogram.calculateSimilarityWith(*m_previousHistogram);
 
     bool isSceneChange = (similar < .85F && !m_previousFrameWasSceneChange);
 
     emit haveNewInformation(m_frameNumber,isSceneChange,similar);
     m_previousFrameWasSceneChange = isSceneChange;
 
-    std::swap(m_histogram,m_previousHistogram);
+    *m_previousHistogram = histogram;
     m_frameNumber++;
 }
 
@@ -15,6 +15,10 @@ class ClassicSceneChangeDetector : public SceneChangeDetectorBase
 
     void processFrame(MythVideoFrame* frame) override; // SceneChangeDetectorBase
 
+    void generateHistogram(const MythVideoFrame* frame,
+                           Histogram &histogram) const;
+    void processHistogram(const Histogram &histogram);
+
   private:
     ~ClassicSceneChangeDetector() override;
 
@@ -76,7 +76,7 @@ void waitForBuffer(std::chrono::microseconds framestart, int minlag, int flaglag
 bool MythPlayerInited(FrameAnalyzerItem &pass,
                       FrameAnalyzerItem &finishedAnalyzers,
                       FrameAnalyzerItem &deadAnalyzers,
-                      MythPlayer *player,
+                      MythCommFlagPlayer *player,
                       long long nframes)
 {
     auto it = pass.begin();
@@ -541,6 +541,11 @@ bool CommDetector2::go(void)
             bool fetchNext = (nextFrame == m_currentFrameNumber + 1);
             MythVideoFrame *currentFrame =
                 m_player->GetRawVideoFrame(fetchNext ? -1 : nextFrame);
+            if (!currentFrame)
+            {
+                LOG(VB_GENERAL, LOG_ERR, "NVP: Unable to get a video frame.");
+                return false;
+            }
             long long lastFrameNumber = m_currentFrameNumber;
             m_currentFrameNumber = currentFrame->m_frameNumber + 1;
             auto end = nowAsDuration<std::chrono::microseconds>();
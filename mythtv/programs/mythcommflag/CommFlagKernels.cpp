@@ -0,0 +1,303 @@
+// C++ headers
+#include <algorithm>
+#include <cmath>
+
+// MythTV headers
+#include "config.h"
+
+extern "C" {
+#include "libavutil/cpu.h"
+}
+
+#if (HAVE_SSE2 && ARCH_X86_64)
+#include <immintrin.h>
+#endif
+
+// Commercial Flagging headers
+#include "CommFlagKernels.h"
+
+void CommFlagKernels::SampledRowScalar(const uint8_t *row, const uint8_t *mask,
+                                       int width, uint8_t *colMax,
+                                       RowStats &stats)
+{
+    for (int x = 0; x < width; x++)
+    {
+        if (!mask[x])
+            continue;
+
+        uint8_t pixel = row[x];
+        stats.m_sum += pixel;
+        stats.m_min = std::min(stats.m_min, pixel);
+        stats.m_max = std::max(stats.m_max, pixel);
+        colMax[x] = std::max(colMax[x], pixel);
+    }
+}
+
+void CommFlagKernels::ConvolveScalar(const uint8_t *src, ptrdiff_t stride,
+                                     uint8_t *dst, int count,
+                                     const double *mask, int radius)
+{
+    for (int ii = 0; ii < count; ii++)
+    {
+        double sum = 0;
+        const uint8_t *pp = src + ii - (radius * stride);
+        for (int kk = 0; kk <= 2 * radius; kk++, pp += stride)
+            sum += mask[kk] * *pp;
+        dst[ii] = lround(sum);
+    }
+}
+
+int CommFlagKernels::CountMatchesScalar(const uint8_t *a, const uint8_t *b,
+                                        int count)
+{
+    int matches = 0;
+    for (int ii = 0; ii < count; ii++)
+        if (a[ii] && b[ii])
+            matches++;
+    return matches;
+}
+
+unsigned int CommFlagKernels::SampledHistogram(
+    const uint8_t *plane, int pitch,
+    unsigned int minX, unsigned int maxX,
+    unsigned int minY, unsigned int maxY,
+    unsigned int xstep, unsigned int ystep,
+    std::array<int,256> &counts)
+{
+    std::array<std::array<int,256>,4> part {};
+    unsigned int samples = 0;
+
+    for (unsigned int y = minY; y < maxY; y += ystep)
+    {
+        const uint8_t *row = plane + (static_cast<ptrdiff_t>(y) * pitch);
+        unsigned int x = minX;
+        for (; x + (3 * xstep) < maxX; x += 4 * xstep)
+        {
+            part[0][row[x]]++;
+            part[1][row[x + xstep]]++;
+            part[2][row[x + (2 * xstep)]]++;
+            part[3][row[x + (3 * xstep)]]++;
+            samples += 4;
+        }
+        for (; x < maxX; x += xstep)
+        {
+            part[0][row[x]]++;
+            samples++;
+        }
+    }
+
+    for (size_t ii = 0; ii < counts.size(); ii++)
+        counts[ii] += part[0][ii] + part[1][ii] + part[2][ii] + part[3][ii];
+
+    return samples;
+}
+
+#if (HAVE_SSE2 && ARCH_X86_64)
+static void sampled_row_sse2(const uint8_t *row, const uint8_t *mask,
+                             int width, uint8_t *colMax,
+                             CommFlagKernels::RowStats &stats)
+{
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i vmin = _mm_set1_epi8(static_cast<char>(stats.m_min));
+    __m128i vmax = _mm_set1_epi8(static_cast<char>(stats.m_max));
+    __m128i vsum = zero;
+
+    int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i p  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        __m128i m  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + x));
+        __m128i cm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colMax + x));
+
+        // Masked out pixels become 0 for the maximums and sum, 255 for
+        // the minimum, so they never change the result.
+        __m128i pm = _mm_and_si128(p, m);
+        vmax = _mm_max_epu8(vmax, pm);
+        vmin = _mm_min_epu8(vmin, _mm_or_si128(p, _mm_xor_si128(m, ones)));
+        vsum = _mm_add_epi64(vsum, _mm_sad_epu8(pm, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(colMax + x),
+                         _mm_max_epu8(cm, pm));
+    }
+
+    alignas(16) std::array<uint8_t,16> lanes {};
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes.data()), vmin);
+    stats.m_min = *std::min_element(lanes.cbegin(), lanes.cend());
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes.data()), vmax);
+    stats.m_max = *std::max_element(lanes.cbegin(), lanes.cend());
+    stats.m_sum += _mm_cvtsi128_si64(vsum) +
+        _mm_cvtsi128_si64(_mm_unpackhi_epi64(vsum, vsum));
+
+    CommFlagKernels::SampledRowScalar(row + x, mask + x, width - x,
+                                      colMax + x, stats);
+}
+
+static void convolve_sse2(const uint8_t *src, ptrdiff_t stride, uint8_t *dst,
+                          int count, const double *mask, int radius)
+{
+    alignas(16) std::array<double,2> sums {};
+
+    int ii = 0;
+    for (; ii + 2 <= count; ii += 2)
+    {
+        // Same order of operations as the scalar version, lane by lane
+        __m128d sum = _mm_setzero_pd();
+        const uint8_t *pp = src + ii - (radius * stride);
+        for (int kk = 0; kk <= 2 * radius; kk++, pp += stride)
+        {
+            __m128d val = _mm_cvtepi32_pd(_mm_setr_epi32(pp[0], pp[1], 0, 0));
+            sum = _mm_add_pd(sum, _mm_mul_pd(_mm_set1_pd(mask[kk]), val));
+        }
+        _mm_store_pd(sums.data(), sum);
+        dst[ii]     = lround(sums[0]);
+        dst[ii + 1] = lround(sums[1]);
+    }
+
+    CommFlagKernels::ConvolveScalar(src + ii, stride, dst + ii, count - ii,
+                                    mask, radius);
+}
+
+static int count_matches_sse2(const uint8_t *a, const uint8_t *b, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int matches = 0;
+
+    int ii = 0;
+    for (; ii + 16 <= count; ii += 16)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + ii));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + ii));
+        int misses = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(va, zero), _mm_cmpeq_epi8(vb, zero)));
+        matches += 16 - __builtin_popcount(static_cast<unsigned>(misses));
+    }
+
+    return matches + CommFlagKernels::CountMatchesScalar(a + ii, b + ii,
+                                                         count - ii);
+}
+
+#if HAVE_AVX2 && defined(__GNUC__)
+__attribute__((target("avx2")))
+static void sampled_row_avx2(const uint8_t *row, const uint8_t *mask,
+                             int width, uint8_t *colMax,
+                             CommFlagKernels::RowStats &stats)
+{
+    const __m256i ones = _mm256_set1_epi8(-1);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i vmin = _mm256_set1_epi8(static_cast<char>(stats.m_min));
+    __m256i vmax = _mm256_set1_epi8(static_cast<char>(stats.m_max));
+    __m256i vsum = zero;
+
+    int x = 0;
+    for (; x + 32 <= width; x += 32)
+    {
+        __m256i p  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x));
+        __m256i m  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + x));
+        __m256i cm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(colMax + x));
+
+        __m256i pm = _mm256_and_si256(p, m);
+        vmax = _mm256_max_epu8(vmax, pm);
+        vmin = _mm256_min_epu8(vmin, _mm256_or_si256(p, _mm256_xor_si256(m, ones)));
+        vsum = _mm256_add_epi64(vsum, _mm256_sad_epu8(pm, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(colMax + x),
+                            _mm256_max_epu8(cm, pm));
+    }
+
+    alignas(32) std::array<uint8_t,32> lanes {};
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.data()), vmin);
+    stats.m_min = *std::min_element(lanes.cbegin(), lanes.cend());
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes.data()), vmax);
+    stats.m_max = *std::max_element(lanes.cbegin(), lanes.cend());
+    alignas(32) std::array<uint64_t,4> sums {};
+    _mm256_store_si256(reinterpret_cast<__m256i*>(sums.data()), vsum);
+    stats.m_sum += sums[0] + sums[1] + sums[2] + sums[3];
+
+    sampled_row_sse2(row + x, mask + x, width - x, colMax + x, stats);
+}
+
+__attribute__((target("avx2")))
+static void convolve_avx2(const uint8_t *src, ptrdiff_t stride, uint8_t *dst,
+                          int count, const double *mask, int radius)
+{
+    alignas(32) std::array<double,4> sums {};
+
+    int ii = 0;
+    for (; ii + 4 <= count; ii += 4)
+    {
+        __m256d sum = _mm256_setzero_pd();
+        const uint8_t *pp = src + ii - (radius * stride);
+        for (int kk = 0; kk <= 2 * radius; kk++, pp += stride)
+        {
+            __m256d val = _mm256_cvtepi32_pd(
+                _mm_setr_epi32(pp[0], pp[1], pp[2], pp[3]));
+            sum = _mm256_add_pd(sum,
+                                _mm256_mul_pd(_mm256_set1_pd(mask[kk]), val));
+        }
+        _mm256_store_pd(sums.data(), sum);
+        for (size_t jj = 0; jj < sums.size(); jj++)
+            dst[ii + jj] = lround(sums[jj]);
+    }
+
+    convolve_sse2(src + ii, stride, dst + ii, count - ii, mask, radius);
+}
+
+__attribute__((target("avx2")))
+static int count_matches_avx2(const uint8_t *a, const uint8_t *b, int count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    int matches = 0;
+
+    int ii = 0;
+    for (; ii + 32 <= count; ii += 32)
+    {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + ii));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + ii));
+        int misses = _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(va, zero),
+                            _mm256_cmpeq_epi8(vb, zero)));
+        matches += 32 - __builtin_popcount(static_cast<unsigned>(misses));
+    }
+
+    return matches + count_matches_sse2(a + ii, b + ii, count - ii);
+}
+#endif // HAVE_AVX2
+#endif // HAVE_SSE2 && ARCH_X86_64
+
+enum KernelLevel { kScalar, kSSE2, kAVX2 };
+
+static KernelLevel kernel_level(void)
+{
+#if (HAVE_SSE2 && ARCH_X86_64)
+    int flags = av_get_cpu_flags();
+#if HAVE_AVX2 && defined(__GNUC__)
+    if (flags & AV_CPU_FLAG_AVX2)
+        return kAVX2;
+#endif
+    if (flags & AV_CPU_FLAG_SSE2)
+        return kSSE2;
+#endif
+    return kScalar;
+}
+
+static const KernelLevel s_level = kernel_level();
+
+#if (HAVE_SSE2 && ARCH_X86_64) && HAVE_AVX2 && defined(__GNUC__)
+#define PICK(scalar, sse2, avx2) \
+    (s_level == kAVX2 ? (avx2) : s_level == kSSE2 ? (sse2) : (scalar))
+#elif (HAVE_SSE2 && ARCH_X86_64)
+#define PICK(scalar, sse2, avx2) (s_level == kSSE2 ? (sse2) : (scalar))
+#else
+#define PICK(scalar, sse2, avx2) (scalar)
+#endif
+
+const char *CommFlagKernels::s_kernelName =
+    PICK("scalar", "sse2", "avx2");
+CommFlagKernels::SampledRowFn CommFlagKernels::s_sampledRow =
+    PICK(CommFlagKernels::SampledRowScalar, sampled_row_sse2, sampled_row_avx2);
+CommFlagKernels::ConvolveFn CommFlagKernels::s_convolve =
+    PICK(CommFlagKernels::ConvolveScalar, convolve_sse2, convolve_avx2);
+CommFlagKernels::CountMatchesFn CommFlagKernels::s_countMatches =
+    PICK(CommFlagKernels::CountMatchesScalar, count_matches_sse2,
+         count_matches_avx2);
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
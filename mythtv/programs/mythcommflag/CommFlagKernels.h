@@ -0,0 +1,81 @@
+#ifndef COMMFLAGKERNELS_H
+#define COMMFLAGKERNELS_H
+
+// C++ headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/** \class CommFlagKernels
+ *  \brief Pixel loops shared by the commercial detectors.
+ *
+ *  The SSE2 or AVX2 version of each kernel is picked at startup from the
+ *  CPU flags, with a scalar version for other CPUs and for the tails of
+ *  rows. Every kernel returns exactly the same results as its scalar
+ *  version, which is public so that the two can be compared.
+ */
+class CommFlagKernels
+{
+  public:
+    struct RowStats
+    {
+        uint64_t m_sum {0};
+        uint8_t  m_min {255};
+        uint8_t  m_max {0};
+    };
+
+    /// Adds the pixels of \p row whose \p mask byte is 0xFF to \p stats and
+    /// raises \p colMax to them. Mask bytes must be either 0x00 or 0xFF.
+    static void SampledRow(const uint8_t *row, const uint8_t *mask,
+                           int width, uint8_t *colMax, RowStats &stats)
+        { s_sampledRow(row, mask, width, colMax, stats); }
+    static void SampledRowScalar(const uint8_t *row, const uint8_t *mask,
+                                 int width, uint8_t *colMax, RowStats &stats);
+
+    /// Convolves \p count pixels with the 2 * \p radius + 1 taps of \p mask,
+    /// the taps being \p stride bytes apart, rounding like lround().
+    static void Convolve(const uint8_t *src, ptrdiff_t stride, uint8_t *dst,
+                         int count, const double *mask, int radius)
+        { s_convolve(src, stride, dst, count, mask, radius); }
+    static void ConvolveScalar(const uint8_t *src, ptrdiff_t stride,
+                               uint8_t *dst, int count, const double *mask,
+                               int radius);
+
+    /// Returns the number of positions where both \p a and \p b are non-zero.
+    static int CountMatches(const uint8_t *a, const uint8_t *b, int count)
+        { return s_countMatches(a, b, count); }
+    static int CountMatchesScalar(const uint8_t *a, const uint8_t *b,
+                                  int count);
+
+    /// Counts every \p xstep th pixel of every \p ystep th row of the
+    /// \p minX to \p maxX by \p minY to \p maxY area of \p plane into
+    /// \p counts, maximums excluded, and returns the number of pixels
+    /// counted. Histogram updates are scattered stores, so this has no SIMD
+    /// version; it spreads the counts over several tables instead so that
+    /// runs of equal pixels do not stall on the same counter.
+    static unsigned int SampledHistogram(
+        const uint8_t *plane, int pitch,
+        unsigned int minX, unsigned int maxX,
+        unsigned int minY, unsigned int maxY,
+        unsigned int xstep, unsigned int ystep,
+        std::array<int,256> &counts);
+
+    /// Name of the kernels in use.
+    static const char *KernelName(void) { return s_kernelName; }
+
+    using SampledRowFn   = void (*)(const uint8_t *, const uint8_t *, int,
+                                    uint8_t *, RowStats &);
+    using ConvolveFn     = void (*)(const uint8_t *, ptrdiff_t, uint8_t *,
+                                    int, const double *, int);
+    using CountMatchesFn = int (*)(const uint8_t *, const uint8_t *, int);
+
+  private:
+    static SampledRowFn    s_sampledRow;
+    static ConvolveFn      s_convolve;
+    static CountMatchesFn  s_countMatches;
+    static const char     *s_kernelName;
+};
+
+#endif // COMMFLAGKERNELS_H
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -13,7 +13,7 @@ extern "C" {
 
 // MythTV headers
 #include "mythframe.h"          // VideoFrame
-#include "mythplayer.h"
+#include "mythcommflagplayer.h"
 
 // Commercial Flagging headers
 #include "FrameAnalyzer.h"
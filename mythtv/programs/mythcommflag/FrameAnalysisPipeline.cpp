@@ -0,0 +1,148 @@
+// C++ headers
+#include <algorithm>
+
+// MythTV headers
+#include "mythlogging.h"
+#include "mthread.h"
+
+// Commercial Flagging headers
+#include "FrameAnalysisPipeline.h"
+
+FrameAnalysisPipeline::Worker::Worker(FrameAnalysisPipeline *pipeline,
+                                      uint id)
+    : m_thread(new MThread(QString("CommAnalyze%1").arg(id), this)),
+      m_pipeline(pipeline)
+{
+}
+
+FrameAnalysisPipeline::Worker::~Worker()
+{
+    delete m_thread;
+}
+
+void FrameAnalysisPipeline::Worker::run(void)
+{
+    FrameAnalysisPipeline *p = m_pipeline;
+
+    QMutexLocker locker(&p->m_lock);
+    while (true)
+    {
+        while (!p->m_pendingWork && !p->m_stopping)
+            p->m_workAvailable.wait(locker.mutex());
+
+        if (p->m_stopping)
+            break;
+
+        Slot &slot = p->m_slots[p->m_nextWork];
+        p->m_nextWork = (p->m_nextWork + 1) % p->m_slots.size();
+        p->m_pendingWork--;
+
+        locker.unlock();
+        p->m_analyzer(&slot.m_frame, slot.m_features);
+        locker.relock();
+
+        slot.m_done = true;
+        p->m_resultReady.wakeAll();
+    }
+}
+
+FrameAnalysisPipeline::FrameAnalysisPipeline(Analyzer analyzer,
+                                             uint threads, uint depth)
+    : m_analyzer(std::move(analyzer)),
+      m_slots(std::max(depth, threads + 1))
+{
+    threads = std::max(threads, 1U);
+    for (uint i = 0; i < threads; ++i)
+    {
+        auto *worker = new Worker(this, i);
+        m_workers.push_back(worker);
+        worker->m_thread->start();
+    }
+
+    LOG(VB_COMMFLAG, LOG_INFO,
+        QString("Frame analysis pipeline: %1 threads, %2 frames deep")
+            .arg(threads).arg(m_slots.size()));
+}
+
+FrameAnalysisPipeline::~FrameAnalysisPipeline()
+{
+    m_lock.lock();
+    m_stopping = true;
+    m_workAvailable.wakeAll();
+    m_lock.unlock();
+
+    for (auto *worker : m_workers)
+    {
+        worker->m_thread->wait();
+        delete worker;
+    }
+}
+
+/** \brief Queues a decoded frame for analysis.
+ *
+ *  Only the luma plane is copied, which is all the analysis looks at.
+ *  The caller must make room with TakeResult() first if IsFull().
+ */
+void FrameAnalysisPipeline::Submit(const MythVideoFrame *frame)
+{
+    if (IsFull())
+        return;
+
+    // The slot is ours until it is handed to the workers below
+    Slot &slot = m_slots[m_tail];
+    if (slot.m_frame.m_width != frame->m_width ||
+        slot.m_frame.m_height != frame->m_height)
+    {
+        slot.m_frame.Init(FMT_YV12, frame->m_width, frame->m_height);
+    }
+    MythVideoFrame::CopyPlane(
+        slot.m_frame.m_buffer + slot.m_frame.m_offsets[0],
+        slot.m_frame.m_pitches[0],
+        frame->m_buffer + frame->m_offsets[0], frame->m_pitches[0],
+        frame->m_width, frame->m_height);
+    slot.m_frame.m_frameNumber = frame->m_frameNumber;
+    slot.m_frame.m_aspect      = frame->m_aspect;
+
+    slot.m_features = ClassicFrameFeatures();
+    slot.m_features.m_frameNumber = frame->m_frameNumber;
+    slot.m_features.m_aspect      = frame->m_aspect;
+
+    m_tail = (m_tail + 1) % m_slots.size();
+    m_count++;
+
+    QMutexLocker locker(&m_lock);
+    m_pendingWork++;
+    m_workAvailable.wakeOne();
+}
+
+/** \brief Returns the features of the oldest submitted frame.
+ *
+ *  \param wait If true, blocks until that frame has been analyzed,
+ *              otherwise returns false if it is not done yet.
+ *  \return false if there was no result to return.
+ */
+bool FrameAnalysisPipeline::TakeResult(ClassicFrameFeatures &features,
+                                       bool wait)
+{
+    if (IsEmpty())
+        return false;
+
+    Slot &slot = m_slots[m_head];
+    {
+        QMutexLocker locker(&m_lock);
+        while (!slot.m_done)
+        {
+            if (!wait)
+                return false;
+            m_resultReady.wait(locker.mutex());
+        }
+        slot.m_done = false;
+    }
+
+    features = slot.m_features;
+    m_head = (m_head + 1) % m_slots.size();
+    m_count--;
+    return true;
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
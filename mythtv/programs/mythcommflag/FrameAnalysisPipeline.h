@@ -0,0 +1,89 @@
+#ifndef FRAMEANALYSISPIPELINE_H
+#define FRAMEANALYSISPIPELINE_H
+
+// C++ headers
+#include <functional>
+#include <vector>
+
+// Qt headers
+#include <QWaitCondition>
+#include <QRunnable>
+#include <QMutex>
+
+// MythTV headers
+#include "mythframe.h"
+
+// Commercial Flagging headers
+#include "ClassicCommDetector.h"
+
+class MThread;
+
+/** \class FrameAnalysisPipeline
+ *  \brief Runs the per-frame analysis of ClassicCommDetector on a pool
+ *         of worker threads.
+ *
+ *  The thread feeding the pipeline copies the luma plane of each decoded
+ *  frame into one of a fixed number of slots, so the player's frame can be
+ *  released immediately. Workers analyze the slots in any order, while
+ *  TakeResult() hands the results back strictly in submission order so
+ *  that the stateful part of the detection sees the same sequence as when
+ *  flagging on a single thread.
+ *
+ *  Submit(), IsFull() and TakeResult() must all be called from the same
+ *  thread.
+ */
+class FrameAnalysisPipeline
+{
+  public:
+    using Analyzer =
+        std::function<void(const MythVideoFrame*, ClassicFrameFeatures&)>;
+
+    FrameAnalysisPipeline(Analyzer analyzer, uint threads, uint depth);
+    ~FrameAnalysisPipeline();
+
+    bool IsFull(void) const   { return m_count == m_slots.size(); }
+    bool IsEmpty(void) const  { return m_count == 0; }
+
+    void Submit(const MythVideoFrame *frame);
+    bool TakeResult(ClassicFrameFeatures &features, bool wait);
+
+  private:
+    struct Slot
+    {
+        MythVideoFrame       m_frame;
+        ClassicFrameFeatures m_features;
+        bool                 m_done {false}; // protected by m_lock
+    };
+
+    class Worker : public QRunnable
+    {
+      public:
+        explicit Worker(FrameAnalysisPipeline *pipeline, uint id);
+        ~Worker() override;
+        void run(void) override; // QRunnable
+
+        MThread *m_thread {nullptr};
+
+      private:
+        FrameAnalysisPipeline *m_pipeline;
+    };
+
+    Analyzer              m_analyzer;
+    std::vector<Slot>     m_slots;
+    size_t                m_head        {0}; // next result to take
+    size_t                m_tail        {0}; // next slot to fill
+    size_t                m_count       {0}; // slots submitted, not taken
+
+    QMutex                m_lock;
+    QWaitCondition        m_workAvailable;   // protected by m_lock
+    QWaitCondition        m_resultReady;     // protected by m_lock
+    size_t                m_nextWork    {0}; // protected by m_lock
+    size_t                m_pendingWork {0}; // protected by m_lock
+    bool                  m_stopping    {false};
+
+    std::vector<Worker*>  m_workers;
+};
+
+#endif // FRAMEANALYSISPIPELINE_H
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -23,7 +23,7 @@
 #define LONG_LONG_MAX  __LONG_LONG_MAX__  
 #endif
 
-class MythPlayer;
+class MythCommFlagPlayer;
 
 class FrameAnalyzer
 {
@@ -45,7 +45,7 @@ public:
     using FrameMap = QMap<long long, long long>;
 
     virtual enum analyzeFrameResult MythPlayerInited(
-            MythPlayer *player, long long nframes) {
+            MythCommFlagPlayer *player, long long nframes) {
         (void)player;
         (void)nframes;
         return ANALYZE_OK;
@@ -0,0 +1,78 @@
+// Commercial Flagging headers
+#include "FrameInfoStore.h"
+
+void FrameInfoStore::clear(void)
+{
+    m_chunks.clear();
+    m_size = 0;
+}
+
+/** \brief Returns the chunk holding \p frame, adding chunks and extending
+ *         the store up to \p frame if needed.
+ */
+FrameInfoStore::Chunk &FrameInfoStore::Grow(long long frame)
+{
+    size_t chunk = frame >> kChunkShift;
+    while (m_chunks.size() <= chunk)
+        m_chunks.push_back(std::make_unique<Chunk>());
+    if (frame >= m_size)
+        m_size = frame + 1;
+    return *m_chunks[chunk];
+}
+
+FrameInfoEntry FrameInfoStore::at(long long frame) const
+{
+    FrameInfoEntry info {};
+    if (!contains(frame))
+        return info;
+
+    const Chunk &c = Get(frame);
+    int ii = Index(frame);
+    info.minBrightness      = c.m_minBrightness[ii];
+    info.maxBrightness      = c.m_maxBrightness[ii];
+    info.avgBrightness      = c.m_avgBrightness[ii];
+    info.sceneChangePercent = c.m_sceneChangePercent[ii];
+    info.aspect             = c.m_aspect[ii];
+    info.format             = c.m_format[ii];
+    info.flagMask           = c.m_flagMask[ii];
+    return info;
+}
+
+void FrameInfoStore::set(long long frame, const FrameInfoEntry &info)
+{
+    if (frame < 0)
+        return;
+
+    Chunk &c = Grow(frame);
+    int ii = Index(frame);
+    c.m_minBrightness[ii]      = info.minBrightness;
+    c.m_maxBrightness[ii]      = info.maxBrightness;
+    c.m_avgBrightness[ii]      = info.avgBrightness;
+    c.m_sceneChangePercent[ii] = info.sceneChangePercent;
+    c.m_aspect[ii]             = info.aspect;
+    c.m_format[ii]             = info.format;
+    c.m_flagMask[ii]           = info.flagMask;
+}
+
+void FrameInfoStore::setBrightness(long long frame, int format,
+                                   int minBrightness, int maxBrightness,
+                                   int avgBrightness)
+{
+    if (frame < 0)
+        return;
+
+    Chunk &c = Grow(frame);
+    int ii = Index(frame);
+    c.m_format[ii]        = format;
+    c.m_minBrightness[ii] = minBrightness;
+    c.m_maxBrightness[ii] = maxBrightness;
+    c.m_avgBrightness[ii] = avgBrightness;
+}
+
+void FrameInfoStore::setSceneChangePercent(long long frame, int percent)
+{
+    if (frame >= 0)
+        Grow(frame).m_sceneChangePercent[Index(frame)] = percent;
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -0,0 +1,104 @@
+#ifndef FRAMEINFOSTORE_H
+#define FRAMEINFOSTORE_H
+
+// C++ headers
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Qt headers
+#include <QString>
+
+class FrameInfoEntry
+{
+  public:
+    int minBrightness;
+    int maxBrightness;
+    int avgBrightness;
+    int sceneChangePercent;
+    int aspect;
+    int format;
+    int flagMask;
+    static QString GetHeader(void);
+    QString toString(uint64_t frame, bool verbose) const;
+};
+
+/** \class FrameInfoStore
+ *  \brief The FrameInfoEntry of every frame of a recording, indexed by
+ *         frame number.
+ *
+ *  Frames are stored column by column in chunks of kChunkFrames, so
+ *  appending never moves what is already stored and a pass over one
+ *  field, such as the flags, only touches that field. Every frame from 0
+ *  up to the highest one written is present; reading a frame that is not
+ *  returns zeros, and writes to negative frame numbers are ignored.
+ */
+class FrameInfoStore
+{
+  public:
+    static constexpr int kChunkShift  { 16 };
+    static constexpr int kChunkFrames { 1 << kChunkShift };
+
+    void clear(void);
+    long long size(void) const { return m_size; }
+    bool contains(long long frame) const
+        { return frame >= 0 && frame < m_size; }
+
+    FrameInfoEntry at(long long frame) const;
+    void set(long long frame, const FrameInfoEntry &info);
+
+    int flagMask(long long frame) const
+        { return contains(frame) ? Get(frame).m_flagMask[Index(frame)] : 0; }
+    void setFlagMask(long long frame, int mask)
+    {
+        if (frame >= 0)
+            Grow(frame).m_flagMask[Index(frame)] = mask;
+    }
+    void addFlags(long long frame, int mask)
+        { setFlagMask(frame, flagMask(frame) | mask); }
+    void removeFlags(long long frame, int mask)
+        { setFlagMask(frame, flagMask(frame) & ~mask); }
+
+    int aspect(long long frame) const
+        { return contains(frame) ? Get(frame).m_aspect[Index(frame)] : 0; }
+    int format(long long frame) const
+        { return contains(frame) ? Get(frame).m_format[Index(frame)] : 0; }
+    int avgBrightness(long long frame) const
+    {
+        return contains(frame) ?
+            Get(frame).m_avgBrightness[Index(frame)] : 0;
+    }
+
+    void setBrightness(long long frame, int format,
+                       int minBrightness, int maxBrightness,
+                       int avgBrightness);
+    void setSceneChangePercent(long long frame, int percent);
+
+  private:
+    // Brightnesses and scene change percentages range from -1, for not
+    // measured, to 255. Aspects, formats and flags fit in a byte.
+    struct Chunk
+    {
+        std::array<int16_t,kChunkFrames> m_minBrightness;
+        std::array<int16_t,kChunkFrames> m_maxBrightness;
+        std::array<int16_t,kChunkFrames> m_avgBrightness;
+        std::array<int16_t,kChunkFrames> m_sceneChangePercent;
+        std::array<uint8_t,kChunkFrames> m_aspect;
+        std::array<uint8_t,kChunkFrames> m_format;
+        std::array<uint8_t,kChunkFrames> m_flagMask;
+    };
+
+    static int Index(long long frame)
+        { return static_cast<int>(frame & (kChunkFrames - 1)); }
+    const Chunk &Get(long long frame) const
+        { return *m_chunks[frame >> kChunkShift]; }
+    Chunk &Grow(long long frame);
+
+    std::vector<std::unique_ptr<Chunk> > m_chunks;
+    long long m_size {0};
+};
+
+#endif // FRAMEINFOSTORE_H
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -5,7 +5,9 @@
 
 #include "mythframe.h"
 
-void Histogram::generateFromImage(MythVideoFrame* frame, unsigned int frameWidth,
+#include "CommFlagKernels.h"
+
+void Histogram::generateFromImage(const MythVideoFrame* frame, unsigned int frameWidth,
          unsigned int frameHeight, unsigned int minScanX, unsigned int maxScanX,
          unsigned int minScanY, unsigned int maxScanY, unsigned int XSpacing,
          unsigned int YSpacing)
@@ -19,16 +21,9 @@ void Histogram::generateFromImage(MythVideoFrame* frame, unsigned int frameWidth
     if (maxScanY > frameHeight-1)
         maxScanY = frameHeight-1;
 
-    unsigned char* framePtr = frame->m_buffer;
-    int bytesPerLine = frame->m_pitches[0];
-    for(unsigned int y = minScanY; y < maxScanY; y += YSpacing)
-    {
-        for(unsigned int x = minScanX; x < maxScanX; x += XSpacing)
-        {
-            m_data[framePtr[y * bytesPerLine + x]]++;
-            m_numberOfSamples++;
-        }
-    }
+    m_numberOfSamples = CommFlagKernels::SampledHistogram(
+        frame->m_buffer, frame->m_pitches[0], minScanX, maxScanX,
+        minScanY, maxScanY, XSpacing, YSpacing, m_data);
 }
 
 unsigned int Histogram::getAverageIntensity(void) const
@@ -9,7 +9,7 @@ public:
     Histogram() = default;
     ~Histogram() = default;
 
-    void generateFromImage(MythVideoFrame* frame, unsigned int frameWidth,
+    void generateFromImage(const MythVideoFrame* frame, unsigned int frameWidth,
              unsigned int frameHeight, unsigned int minScanX,
              unsigned int maxScanX, unsigned int minScanY,
              unsigned int maxScanY, unsigned int XSpacing,
@@ -4,7 +4,7 @@
 
 // MythTV headers
 #include "mythcorecontext.h"
-#include "mythplayer.h"
+#include "mythcommflagplayer.h"
 #include "mythlogging.h"
 
 // Commercial Flagging headers
@@ -178,7 +178,7 @@ HistogramAnalyzer::~HistogramAnalyzer()
 }
 
 enum FrameAnalyzer::analyzeFrameResult
-HistogramAnalyzer::MythPlayerInited(MythPlayer *player, long long nframes)
+HistogramAnalyzer::MythPlayerInited(MythCommFlagPlayer *player, long long nframes)
 {
     if (m_histValDone)
         return FrameAnalyzer::ANALYZE_FINISHED;
@@ -186,7 +186,7 @@ HistogramAnalyzer::MythPlayerInited(MythPlayer *player, long long nframes)
     if (m_monochromatic)
         return FrameAnalyzer::ANALYZE_OK;
 
-    QSize buf_dim = player->GetVideoBufferSize();
+    QSize buf_dim = player->GetRawVideoBufferSize();
     unsigned int width  = buf_dim.width();
     unsigned int height = buf_dim.height();
 
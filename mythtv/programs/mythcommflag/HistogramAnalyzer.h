@@ -23,7 +23,7 @@ public:
     ~HistogramAnalyzer();
 
     enum FrameAnalyzer::analyzeFrameResult MythPlayerInited(
-            MythPlayer *player, long long nframes);
+            MythCommFlagPlayer *player, long long nframes);
     void setLogoState(TemplateFinder *finder);
     static const long long kUncached = -1;
     enum FrameAnalyzer::analyzeFrameResult analyzeFrame(const MythVideoFrame *frame,
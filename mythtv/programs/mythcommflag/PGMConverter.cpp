@@ -3,7 +3,7 @@
 
 // MythTV headers
 #include "mythlogging.h"
-#include "mythplayer.h"
+#include "mythcommflagplayer.h"
 #include "mythframe.h"          /* VideoFrame */
 #include "mythavutil.h"
 
@@ -29,7 +29,7 @@ PGMConverter::~PGMConverter(void)
 }
 
 int
-PGMConverter::MythPlayerInited(const MythPlayer *player)
+PGMConverter::MythPlayerInited(const MythCommFlagPlayer *player)
 {
 #ifdef PGM_CONVERT_GREYSCALE
     m_timeReported = false;
@@ -39,7 +39,7 @@ PGMConverter::MythPlayerInited(const MythPlayer *player)
     if (m_width != -1)
         return 0;
 
-    QSize buf_dim = player->GetVideoBufferSize();
+    QSize buf_dim = player->GetRawVideoBufferSize();
     m_width  = buf_dim.width();
     m_height = buf_dim.height();
 
@@ -11,7 +11,7 @@ extern "C" {
 #include "libavcodec/avcodec.h"    /* AVFrame */
 }
 
-class MythPlayer;
+class MythCommFlagPlayer;
 class MythAVCopy;
 class MythVideoFrame;
 
@@ -34,7 +34,7 @@ public:
     PGMConverter(void) = default;
     ~PGMConverter(void);
 
-    int MythPlayerInited(const MythPlayer *player);
+    int MythPlayerInited(const MythCommFlagPlayer *player);
     const AVFrame *getImage(const MythVideoFrame *frame, long long frameno,
             int *pwidth, int *pheight);
     int reportTime(void);
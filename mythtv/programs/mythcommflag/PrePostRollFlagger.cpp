@@ -226,6 +226,11 @@ long long PrePostRollFlagger::findBreakInrange(long long startFrame,
 
     long long tmpStartFrame = startFrame;
     MythVideoFrame* f = m_player->GetRawVideoFrame(tmpStartFrame);
+    if (!f)
+    {
+        LOG(VB_GENERAL, LOG_ERR, "NVP: Unable to get a video frame.");
+        return 0;
+    }
     float aspect = m_player->GetVideoAspect();
     long long currentFrameNumber = f->m_frameNumber;
     LOG(VB_COMMFLAG, LOG_INFO, QString("Starting with frame %1")
@@ -241,6 +246,11 @@ long long PrePostRollFlagger::findBreakInrange(long long startFrame,
             startTime = nowAsDuration<std::chrono::microseconds>();
 
         MythVideoFrame* currentFrame = m_player->GetRawVideoFrame();
+        if (!currentFrame)
+        {
+            LOG(VB_GENERAL, LOG_ERR, "NVP: Unable to get a video frame.");
+            return 0;
+        }
         currentFrameNumber = currentFrame->m_frameNumber;
 
         if(currentFrameNumber % 1000 == 0)
@@ -342,7 +352,7 @@ long long PrePostRollFlagger::findBreakInrange(long long startFrame,
 
         ProcessFrame(currentFrame, currentFrameNumber);
 
-        if (m_frameInfo[currentFrameNumber].flagMask &
+        if (m_frameInfo.flagMask(currentFrameNumber) &
            (COMM_FRAME_SCENE_CHANGE | COMM_FRAME_BLANK))
         {
             foundFrame = currentFrameNumber;
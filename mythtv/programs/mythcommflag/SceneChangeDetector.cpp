@@ -5,7 +5,7 @@
 
 // MythTV headers
 #include "mythcorecontext.h"    /* gContext */
-#include "mythplayer.h"
+#include "mythcommflagplayer.h"
 #include "mythlogging.h"
 
 // Commercial Flagging headers
@@ -116,7 +116,7 @@ SceneChangeDetector::SceneChangeDetector(std::shared_ptr<HistogramAnalyzer> ha,
 
 
 enum FrameAnalyzer::analyzeFrameResult
-SceneChangeDetector::MythPlayerInited(MythPlayer *player,
+SceneChangeDetector::MythPlayerInited(MythCommFlagPlayer *player,
         long long nframes)
 {
     FrameAnalyzer::analyzeFrameResult ares =
@@ -127,7 +127,7 @@ SceneChangeDetector::MythPlayerInited(MythPlayer *player,
     m_scData.resize(nframes);
     m_scDiff.resize(nframes);
 
-    QSize video_disp_dim = player->GetVideoSize();
+    QSize video_disp_dim = player->GetRawVideoSize();
 
     LOG(VB_COMMFLAG, LOG_INFO, 
         QString("SceneChangeDetector::MythPlayerInited %1x%2")
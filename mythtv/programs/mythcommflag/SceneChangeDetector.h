@@ -23,7 +23,7 @@ public:
     /* FrameAnalyzer interface. */
     const char *name(void) const override // FrameAnalyzer
         { return "SceneChangeDetector"; }
-    enum analyzeFrameResult MythPlayerInited(MythPlayer *player,
+    enum analyzeFrameResult MythPlayerInited(MythCommFlagPlayer *player,
             long long nframes) override; // FrameAnalyzer
     enum analyzeFrameResult analyzeFrame(const MythVideoFrame *frame,
             long long frameno, long long *pNextFrame) override; // FrameAnalyzer
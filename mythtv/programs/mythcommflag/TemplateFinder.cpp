@@ -9,7 +9,7 @@
 #include <utility>
 
 // MythTV headers
-#include "mythplayer.h"
+#include "mythcommflagplayer.h"
 #include "mythcorecontext.h"    /* gContext */
 #include "mythframe.h"          /* VideoFrame */
 #include "mythdate.h"
@@ -696,7 +696,7 @@ writeTemplate(const QString& tmplfile, const AVFrame *tmpl, const QString& dataf
 TemplateFinder::TemplateFinder(std::shared_ptr<PGMConverter> pgmc,
                                std::shared_ptr<BorderDetector> bd,
                                std::shared_ptr<EdgeDetector> ed,
-                               MythPlayer *player, std::chrono::seconds proglen,
+                               MythCommFlagPlayer *player, std::chrono::seconds proglen,
                                const QString& debugdir)
   : m_pgmConverter(std::move(pgmc)),
     m_borderDetector(std::move(bd)),
@@ -767,7 +767,7 @@ TemplateFinder::~TemplateFinder(void)
 }
 
 enum FrameAnalyzer::analyzeFrameResult
-TemplateFinder::MythPlayerInited(MythPlayer *player, long long nframes)
+TemplateFinder::MythPlayerInited(MythCommFlagPlayer *player, long long nframes)
 {
     /*
      * Only detect edges in portions of the frame where we expect to find
@@ -782,7 +782,7 @@ TemplateFinder::MythPlayerInited(MythPlayer *player, long long nframes)
     QString playerdims;
 
     (void)nframes; /* gcc */
-    QSize buf_dim = player->GetVideoBufferSize();
+    QSize buf_dim = player->GetRawVideoBufferSize();
     m_width  = buf_dim.width();
     m_height = buf_dim.height();
     playerdims = QString("%1x%2").arg(m_width).arg(m_height);
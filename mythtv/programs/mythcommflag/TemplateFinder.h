@@ -34,12 +34,12 @@ public:
     TemplateFinder(std::shared_ptr<PGMConverter> pgmc,
                    std::shared_ptr<BorderDetector> bd,
                    std::shared_ptr<EdgeDetector> ed,
-                   MythPlayer *player, std::chrono::seconds proglen,
+                   MythCommFlagPlayer *player, std::chrono::seconds proglen,
                    const QString& debugdir);
     TemplateFinder(std::shared_ptr<PGMConverter> pgmc,
                    std::shared_ptr<BorderDetector> bd,
                    std::shared_ptr<EdgeDetector> ed,
-                   MythPlayer *player, int proglen, const QString& debugdir) :
+                   MythCommFlagPlayer *player, int proglen, const QString& debugdir) :
         TemplateFinder(std::move(pgmc), std::move(bd), std::move(ed),
                        player, std::chrono::seconds(proglen), debugdir) {};
     ~TemplateFinder(void) override;
@@ -47,7 +47,7 @@ public:
     /* FrameAnalyzer interface. */
     const char *name(void) const override // FrameAnalyzer
         { return "TemplateFinder"; }
-    enum analyzeFrameResult MythPlayerInited(MythPlayer *player,
+    enum analyzeFrameResult MythPlayerInited(MythCommFlagPlayer *player,
             long long nframes) override; // FrameAnalyzer
     enum analyzeFrameResult analyzeFrame(const MythVideoFrame *frame,
             long long frameno, long long *pNextFrame) override; // FrameAnalyzer
@@ -4,6 +4,7 @@
 
 // C++ headers
 #include <algorithm>
+#include <vector>
 
 // Qt headers
 #include <QFile>
@@ -11,12 +12,13 @@
 #include <utility>
 
 // MythTV headers
-#include "mythplayer.h"
+#include "mythcommflagplayer.h"
 #include "mythcorecontext.h"
 #include "mythlogging.h"
 
 // Commercial Flagging headers
 #include "CommDetector2.h"
+#include "CommFlagKernels.h"
 #include "FrameAnalyzer.h"
 #include "pgm.h"
 #include "PGMConverter.h"
@@ -60,37 +62,54 @@ int pgm_match(const AVFrame *tmpl, const AVFrame *test, int height,
         return -1;
     }
 
-    int score = 0;
+    const int       size = width * height;
+
+    if (!radius)
+    {
+        *pscore = CommFlagKernels::CountMatches(tmpl->data[0], test->data[0],
+                                                size);
+        return 0;
+    }
+
+    /*
+     * A template edge pixel matches if there is a test edge pixel within
+     * "radius" of it. Rather than searching around every template pixel,
+     * dilate the test edges by "radius" once (a thresholded chessboard
+     * distance transform) and count the overlap. The horizontal window
+     * is the one the search used, which can reach the first pixel of the
+     * next row.
+     */
+    const uint8_t *edges = test->data[0];
+    std::vector<uint8_t> rowdilated(size);
     for (int rr = 0; rr < height; rr++)
     {
         for (int cc = 0; cc < width; cc++)
         {
-            if (!tmpl->data[0][rr * width + cc])
-                continue;
-
-            int r2min = std::max(0, rr - radius);
-            int r2max = std::min(height, rr + radius);
-
-            int c2min = std::max(0, cc - radius);
-            int c2max = std::min(width, cc + radius);
+            int ii = rr * width + std::max(0, cc - radius);
+            int iimax = std::min(size - 1,
+                                 rr * width + std::min(width, cc + radius));
+            while (ii <= iimax && !edges[ii])
+                ii++;
+            rowdilated[rr * width + cc] = (ii <= iimax) ? 1 : 0;
+        }
+    }
 
-            for (int r2 = r2min; r2 <= r2max; r2++)
-            {
-                for (int c2 = c2min; c2 <= c2max; c2++)
-                {
-                    if (test->data[0][r2 * width + c2])
-                    {
-                        score++;
-                        goto next_pixel;
-                    }
-                }
-            }
-next_pixel:
-            ;
+    std::vector<uint8_t> dilated(size);
+    for (int rr = 0; rr < height; rr++)
+    {
+        int r2min = std::max(0, rr - radius);
+        int r2max = std::min(height - 1, rr + radius);
+        for (int cc = 0; cc < width; cc++)
+        {
+            uint8_t any = 0;
+            for (int r2 = r2min; r2 <= r2max && !any; r2++)
+                any = rowdilated[r2 * width + cc];
+            dilated[rr * width + cc] = any;
         }
     }
 
-    *pscore = score;
+    *pscore = CommFlagKernels::CountMatches(tmpl->data[0], dilated.data(),
+                                            size);
     return 0;
 }
 
@@ -341,7 +360,7 @@ TemplateMatcher::~TemplateMatcher(void)
 }
 
 enum FrameAnalyzer::analyzeFrameResult
-TemplateMatcher::MythPlayerInited(MythPlayer *_player,
+TemplateMatcher::MythPlayerInited(MythCommFlagPlayer *_player,
         long long nframes)
 {
     m_player = _player;
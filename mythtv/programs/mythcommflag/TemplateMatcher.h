@@ -40,7 +40,7 @@ public:
     /* FrameAnalyzer interface. */
     const char *name(void) const override // FrameAnalyzer
         { return "TemplateMatcher"; }
-    enum analyzeFrameResult MythPlayerInited(MythPlayer *player,
+    enum analyzeFrameResult MythPlayerInited(MythCommFlagPlayer *player,
             long long nframes) override; // FrameAnalyzer
     enum analyzeFrameResult analyzeFrame(const MythVideoFrame *frame,
             long long frameno, long long *pNextFrame) override; // FrameAnalyzer
@@ -77,7 +77,7 @@ private:
     int                     m_debugLevel        {0};
     QString                 m_debugDir;
     QString                 m_debugData;                   /* filename */
-    MythPlayer             *m_player            {nullptr};
+    MythCommFlagPlayer     *m_player            {nullptr};
     bool                    m_debugMatches      {false};
     bool                    m_debugRemoveRunts  {false};
     bool                    m_matchesDone       {false};
@@ -64,6 +64,10 @@ void MythCommFlagCommandLineParser::LoadArguments(void)
     add("--outputmethod", "outputmethod", "",
         "Format of output written to outputfile, essentials, full.", "")
             ->SetGroup("Commflagging");
+    add("--decode", "decode", "",
+        "Decoding mode: full, or fast to flag reduced resolution frames.\n"
+        "Defaults to the CommFlagFast setting.", "")
+            ->SetGroup("Commflagging");
     add("--queue", "queue", false,
         "Insert flagging job into the JobQueue, rather than "
         "running flagging in the foreground.", "");
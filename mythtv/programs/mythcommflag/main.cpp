@@ -113,6 +113,11 @@ enum OutputMethod
 };
 OutputMethod outputMethod = kOutputMethodEssentials;
 
+// Frames taller than this are reduced before flagging in the fast mode.
+// Every detector already scales its sampling and thresholds to the frame
+// size, and nothing they look for needs more than SD resolution.
+static constexpr int kFastFlagMaxHeight { 576 };
+
 static QMap<QString,OutputMethod> *init_output_types();
 QMap<QString,OutputMethod> *outputTypes = init_output_types();
 
@@ -888,14 +893,24 @@ static int FlagCommercials(ProgramInfo *program_info, int jobid,
     auto flags = static_cast<PlayerFlags>(kAudioMuted | kVideoIsNull | kNoITV);
 
     int flagfast = gCoreContext->GetNumSetting("CommFlagFast", 0);
+    if (cmdline.toBool("decode"))
+    {
+        QString decode = cmdline.toString("decode");
+        if (decode != "full" && decode != "fast")
+        {
+            LOG(VB_GENERAL, LOG_ERR,
+                QString("Unknown decoding mode '%1', using full").arg(decode));
+        }
+        flagfast = (decode == "fast") ? 1 : 0;
+    }
+
     if (flagfast)
     {
-        // Note: These additional flags replicate the intent of the original
-        // commit that enabled lowres support - but I'm not sure why it requires
-        // single threaded decoding - which surely slows everything down? Though
-        // there is probably no profile to enable multi-threaded decoding anyway.
+        // Codecs that support it are decoded at a quarter of the size, and
+        // single threaded, as they always have been. H.264 and HEVC skip the
+        // loop filter instead and the player reduces their luma plane.
         LOG(VB_GENERAL, LOG_INFO, "Enabling experimental flagging speedup (low resolution)");
-        flags = static_cast<PlayerFlags>(flags | kDecodeLowRes | kDecodeSingleThreaded | kDecodeNoLoopFilter);
+        flags = static_cast<PlayerFlags>(flags | kDecodeLowRes | kDecodeNoLoopFilter);
     }
 
     // blank detector needs to be only sample center for this optimization.
@@ -907,6 +922,8 @@ static int FlagCommercials(ProgramInfo *program_info, int jobid,
 
     auto *ctx = new PlayerContext(kFlaggerInUseID);
     auto *cfp = new MythCommFlagPlayer(ctx, flags);
+    if (flagfast)
+        cfp->SetMaxRawVideoHeight(kFastFlagMaxHeight);
     ctx->SetPlayingInfo(program_info);
     ctx->SetRingBuffer(tmprbuf);
     ctx->SetPlayer(cfp);
@@ -16,6 +16,7 @@ HEADERS += CommDetectorFactory.h CommDetectorBase.h
 HEADERS += ClassicLogoDetector.h
 HEADERS += ClassicSceneChangeDetector.h
 HEADERS += ClassicCommDetector.h
+HEADERS += CommFlagKernels.h FrameAnalysisPipeline.h FrameInfoStore.h
 HEADERS += Histogram.h
 HEADERS += quickselect.h
 HEADERS += CommDetector2.h
@@ -37,6 +38,7 @@ SOURCES += CommDetectorFactory.cpp CommDetectorBase.cpp
 SOURCES += ClassicLogoDetector.cpp
 SOURCES += ClassicSceneChangeDetector.cpp
 SOURCES += ClassicCommDetector.cpp
+SOURCES += CommFlagKernels.cpp FrameAnalysisPipeline.cpp FrameInfoStore.cpp
 SOURCES += Histogram.cpp
 SOURCES += quickselect.cpp
 SOURCES += CommDetector2.cpp
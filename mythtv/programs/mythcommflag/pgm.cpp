@@ -9,6 +9,7 @@ extern "C" {
 #include "mythframe.h"
 #include "mythlogging.h"
 #include "pgm.h"
+#include "CommFlagKernels.h"
 
 // TODO: verify this
 /*
@@ -257,34 +258,21 @@ int pgm_convolve_radial(AVFrame *dst, AVFrame *s1, AVFrame *s2,
 
     /* "s1" convolve with column vector => "s2" */
     int rr2 = mask_radius + srcheight;
-    int cc2 = mask_radius + srcwidth;
     for (int rr = mask_radius; rr < rr2; rr++)
     {
-        for (int cc = mask_radius; cc < cc2; cc++)
-        {
-            double sum = 0;
-            for (int ii = -mask_radius; ii <= mask_radius; ii++)
-            {
-                sum += mask[ii + mask_radius] *
-                    s1->data[0][(rr + ii) * newwidth + cc];
-            }
-            s2->data[0][rr * newwidth + cc] = lround(sum);
-        }
+        int offset = rr * newwidth + mask_radius;
+        CommFlagKernels::Convolve(s1->data[0] + offset, newwidth,
+                                  s2->data[0] + offset, srcwidth,
+                                  mask, mask_radius);
     }
 
     /* "s2" convolve with row vector => "dst" */
     for (int rr = mask_radius; rr < rr2; rr++)
     {
-        for (int cc = mask_radius; cc < cc2; cc++)
-        {
-            double sum = 0;
-            for (int ii = -mask_radius; ii <= mask_radius; ii++)
-            {
-                sum += mask[ii + mask_radius] *
-                    s2->data[0][rr * newwidth + cc + ii];
-            }
-            dst->data[0][rr * newwidth + cc] = lround(sum);
-        }
+        int offset = rr * newwidth + mask_radius;
+        CommFlagKernels::Convolve(s2->data[0] + offset, 1,
+                                  dst->data[0] + offset, srcwidth,
+                                  mask, mask_radius);
     }
 
     return 0;
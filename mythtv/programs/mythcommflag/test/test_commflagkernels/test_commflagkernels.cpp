@@ -0,0 +1,367 @@
+/*
+ *  Class TestCommFlagKernels
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "test_commflagkernels.h"
+#include "CommFlagKernels.h"
+
+// The luma plane of a YV12 frame, with the row padding a decoder adds.
+struct Frame
+{
+    int m_width  {720};
+    int m_height {480};
+    int m_pitch  {768};
+    std::vector<uint8_t> m_plane;
+};
+
+// The logo area of the "logo" frames, and the border and sample spacing
+// ClassicCommDetector uses for SD frames.
+static constexpr int kLogoMinX  { 560 };
+static constexpr int kLogoMaxX  { 680 };
+static constexpr int kLogoMinY  { 30 };
+static constexpr int kLogoMaxY  { 90 };
+static constexpr int kBorder    { 20 };
+static constexpr int kSpacing   { 4 };
+
+static Frame make_frame(const QString &kind)
+{
+    std::mt19937 gen(4321);
+    std::uniform_int_distribution<int> noise(16, 235);
+
+    Frame frame;
+    frame.m_plane.assign(frame.m_pitch * frame.m_height, 0xEE);
+    for (int y = 0; y < frame.m_height; y++)
+    {
+        uint8_t *row = frame.m_plane.data() + (y * frame.m_pitch);
+        for (int x = 0; x < frame.m_width; x++)
+        {
+            if (kind == "blank")
+                row[x] = 16 + (gen() & 3);
+            else if (kind == "letterbox" && (y < 60 || y >= 420))
+                row[x] = 16;
+            else if (kind == "logo" && x >= kLogoMinX && x < kLogoMaxX &&
+                     y >= kLogoMinY && y < kLogoMaxY)
+                row[x] = 250;
+            else
+                row[x] = noise(gen);
+        }
+    }
+    return frame;
+}
+
+static void add_frame_rows(void)
+{
+    QTest::addColumn<QString>("kind");
+
+    QTest::newRow("noise")     << "noise";
+    QTest::newRow("letterbox") << "letterbox";
+    QTest::newRow("blank")     << "blank";
+    QTest::newRow("logo")      << "logo";
+}
+
+static bool inside_logo(const QString &kind, int x, int y)
+{
+    return kind == "logo" && x >= kLogoMinX && x < kLogoMaxX &&
+        y >= kLogoMinY && y < kLogoMaxY;
+}
+
+static std::vector<uint8_t> make_mask(const Frame &frame,
+                                      const QString &kind, int y)
+{
+    std::vector<uint8_t> mask(frame.m_width, 0);
+    for (int x = kBorder; x < frame.m_width - kBorder; x += kSpacing)
+        if (!inside_logo(kind, x, y))
+            mask[x] = 0xFF;
+    return mask;
+}
+
+// A 5 tap gaussian, as built by pgm_convolve_radial's callers.
+static std::array<double,5> make_gaussian(void)
+{
+    std::array<double,5> mask {};
+    double sum = 0;
+    for (int ii = -2; ii <= 2; ii++)
+    {
+        mask[ii + 2] = exp(-(ii * ii) / (2 * 1.5 * 1.5));
+        sum += mask[ii + 2];
+    }
+    for (auto & tap : mask)
+        tap /= sum;
+    return mask;
+}
+
+static std::vector<uint8_t> make_edges(const Frame &frame, int threshold)
+{
+    std::vector<uint8_t> edges(frame.m_width * frame.m_height);
+    for (int y = 0; y < frame.m_height; y++)
+    {
+        for (int x = 0; x < frame.m_width; x++)
+        {
+            edges[y * frame.m_width + x] =
+                frame.m_plane[y * frame.m_pitch + x] > threshold ? 255 : 0;
+        }
+    }
+    return edges;
+}
+
+void TestCommFlagKernels::initTestCase(void)
+{
+    qDebug() << "CommFlag kernels:" << CommFlagKernels::KernelName();
+}
+
+void TestCommFlagKernels::SampledRowMatchesOriginal_data(void)
+{
+    add_frame_rows();
+}
+
+void TestCommFlagKernels::SampledRowMatchesOriginal(void)
+{
+    QFETCH(QString, kind);
+
+    Frame frame = make_frame(kind);
+    std::vector<uint8_t> colMax(frame.m_width, 0);
+    std::vector<uint8_t> colMaxScalar(frame.m_width, 0);
+    std::vector<uint8_t> colMaxOriginal(frame.m_width, 0);
+
+    for (int y = kBorder; y < frame.m_height - kBorder; y += kSpacing)
+    {
+        const uint8_t *row = frame.m_plane.data() + (y * frame.m_pitch);
+        std::vector<uint8_t> mask = make_mask(frame, kind, y);
+
+        // The loop ClassicCommDetector used to run over each row.
+        CommFlagKernels::RowStats original;
+        for (int x = kBorder; x < frame.m_width - kBorder; x += kSpacing)
+        {
+            if (inside_logo(kind, x, y))
+                continue;
+            uint8_t pixel = row[x];
+            original.m_sum += pixel;
+            if (pixel < original.m_min)
+                original.m_min = pixel;
+            if (pixel > original.m_max)
+                original.m_max = pixel;
+            if (pixel > colMaxOriginal[x])
+                colMaxOriginal[x] = pixel;
+        }
+
+        CommFlagKernels::RowStats stats;
+        CommFlagKernels::SampledRow(row, mask.data(), frame.m_width,
+                                    colMax.data(), stats);
+        CommFlagKernels::RowStats scalar;
+        CommFlagKernels::SampledRowScalar(row, mask.data(), frame.m_width,
+                                          colMaxScalar.data(), scalar);
+
+        QCOMPARE(stats.m_sum, original.m_sum);
+        QCOMPARE(stats.m_min, original.m_min);
+        QCOMPARE(stats.m_max, original.m_max);
+        QCOMPARE(scalar.m_sum, original.m_sum);
+        QCOMPARE(scalar.m_min, original.m_min);
+        QCOMPARE(scalar.m_max, original.m_max);
+    }
+    QVERIFY(colMax == colMaxOriginal);
+    QVERIFY(colMaxScalar == colMaxOriginal);
+}
+
+void TestCommFlagKernels::ConvolveMatchesOriginal_data(void)
+{
+    add_frame_rows();
+}
+
+void TestCommFlagKernels::ConvolveMatchesOriginal(void)
+{
+    QFETCH(QString, kind);
+
+    Frame frame = make_frame(kind);
+    std::array<double,5> mask = make_gaussian();
+    const int radius = 2;
+    const int count = frame.m_width - (2 * radius);
+
+    std::vector<uint8_t> dst(count);
+    std::vector<uint8_t> scalar(count);
+    std::vector<uint8_t> original(count);
+
+    // Odd lengths exercise the tails left to the scalar code.
+    for (int len : { count, count - 1, count - 7, 3 })
+    {
+        for (int y = radius; y < frame.m_height - radius; y += 3)
+        {
+            const uint8_t *src =
+                frame.m_plane.data() + (y * frame.m_pitch) + radius;
+
+            // Vertical, then horizontal, as in pgm_convolve_radial().
+            for (ptrdiff_t stride : { ptrdiff_t(frame.m_pitch), ptrdiff_t(1) })
+            {
+                for (int x = 0; x < len; x++)
+                {
+                    double sum = 0;
+                    for (int ii = -radius; ii <= radius; ii++)
+                        sum += mask[ii + radius] * src[x + (ii * stride)];
+                    original[x] = lround(sum);
+                }
+
+                CommFlagKernels::Convolve(src, stride, dst.data(), len,
+                                          mask.data(), radius);
+                CommFlagKernels::ConvolveScalar(src, stride, scalar.data(),
+                                                len, mask.data(), radius);
+
+                QVERIFY(std::equal(dst.cbegin(), dst.cbegin() + len,
+                                   original.cbegin()));
+                QVERIFY(std::equal(scalar.cbegin(), scalar.cbegin() + len,
+                                   original.cbegin()));
+            }
+        }
+    }
+}
+
+void TestCommFlagKernels::CountMatchesMatchesScalar_data(void)
+{
+    add_frame_rows();
+}
+
+void TestCommFlagKernels::CountMatchesMatchesScalar(void)
+{
+    QFETCH(QString, kind);
+
+    Frame frame = make_frame(kind);
+    std::vector<uint8_t> edges = make_edges(frame, 128);
+    std::vector<uint8_t> tmpl = make_edges(make_frame("logo"), 200);
+
+    for (int len : { int(edges.size()), int(edges.size()) - 1, 63, 31, 1 })
+    {
+        int original = 0;
+        for (int ii = 0; ii < len; ii++)
+            if (edges[ii] && tmpl[ii])
+                original++;
+
+        QCOMPARE(CommFlagKernels::CountMatches(edges.data(), tmpl.data(), len),
+                 original);
+        QCOMPARE(CommFlagKernels::CountMatchesScalar(edges.data(), tmpl.data(),
+                                                     len),
+                 original);
+    }
+}
+
+void TestCommFlagKernels::SampledHistogramMatchesOriginal_data(void)
+{
+    add_frame_rows();
+}
+
+void TestCommFlagKernels::SampledHistogramMatchesOriginal(void)
+{
+    QFETCH(QString, kind);
+
+    Frame frame = make_frame(kind);
+
+    for (unsigned int step : { 1U, 2U, 3U, 4U, 10U })
+    {
+        // The loop Histogram::generateFromImage() used to run.
+        std::array<int,256> original {};
+        unsigned int originalSamples = 0;
+        for (int y = kBorder; y < frame.m_height - 1; y += step)
+        {
+            for (int x = kBorder; x < frame.m_width - 1; x += step)
+            {
+                original[frame.m_plane[y * frame.m_pitch + x]]++;
+                originalSamples++;
+            }
+        }
+
+        std::array<int,256> counts {};
+        unsigned int samples = CommFlagKernels::SampledHistogram(
+            frame.m_plane.data(), frame.m_pitch,
+            kBorder, frame.m_width - 1, kBorder, frame.m_height - 1,
+            step, step, counts);
+
+        QCOMPARE(samples, originalSamples);
+        QVERIFY(counts == original);
+    }
+}
+
+void TestCommFlagKernels::BenchmarkKernels_data(void)
+{
+    QTest::addColumn<QString>("kernel");
+    QTest::addColumn<bool>("scalar");
+
+    QTest::newRow("sampled row, scalar")      << "sampledrow" << true;
+    QTest::newRow("sampled row, dispatched")  << "sampledrow" << false;
+    QTest::newRow("convolve, scalar")         << "convolve"   << true;
+    QTest::newRow("convolve, dispatched")     << "convolve"   << false;
+    QTest::newRow("count matches, scalar")    << "matches"    << true;
+    QTest::newRow("count matches, dispatched") << "matches"   << false;
+}
+
+void TestCommFlagKernels::BenchmarkKernels(void)
+{
+    QFETCH(QString, kernel);
+    QFETCH(bool, scalar);
+
+    Frame frame = make_frame("noise");
+    const uint8_t *plane = frame.m_plane.data();
+
+    if (kernel == "sampledrow")
+    {
+        CommFlagKernels::SampledRowFn fn = scalar
+            ? CommFlagKernels::SampledRowScalar : CommFlagKernels::SampledRow;
+        std::vector<uint8_t> mask = make_mask(frame, "noise", 0);
+        std::vector<uint8_t> colMax(frame.m_width, 0);
+        CommFlagKernels::RowStats stats;
+        QBENCHMARK {
+            for (int y = kBorder; y < frame.m_height - kBorder; y += kSpacing)
+            {
+                fn(plane + (y * frame.m_pitch), mask.data(), frame.m_width,
+                   colMax.data(), stats);
+            }
+        }
+        QVERIFY(stats.m_sum > 0);
+    }
+    else if (kernel == "convolve")
+    {
+        CommFlagKernels::ConvolveFn fn = scalar
+            ? CommFlagKernels::ConvolveScalar : CommFlagKernels::Convolve;
+        std::array<double,5> mask = make_gaussian();
+        std::vector<uint8_t> dst(frame.m_pitch * frame.m_height, 0);
+        QBENCHMARK {
+            for (int y = 2; y < frame.m_height - 2; y++)
+            {
+                int offset = (y * frame.m_pitch) + 2;
+                fn(plane + offset, frame.m_pitch, dst.data() + offset,
+                   frame.m_width - 4, mask.data(), 2);
+            }
+        }
+        QVERIFY(dst[(100 * frame.m_pitch) + 100] > 0);
+    }
+    else
+    {
+        CommFlagKernels::CountMatchesFn fn = scalar
+            ? CommFlagKernels::CountMatchesScalar
+            : CommFlagKernels::CountMatches;
+        std::vector<uint8_t> edges = make_edges(frame, 128);
+        std::vector<uint8_t> tmpl = make_edges(make_frame("logo"), 200);
+        int matches = 0;
+        QBENCHMARK {
+            matches = fn(edges.data(), tmpl.data(), edges.size());
+        }
+        QVERIFY(matches > 0);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestCommFlagKernels)
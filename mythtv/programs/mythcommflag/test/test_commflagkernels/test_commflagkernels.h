@@ -0,0 +1,37 @@
+/*
+ *  Class TestCommFlagKernels
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+class TestCommFlagKernels : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void initTestCase(void);
+    static void SampledRowMatchesOriginal_data(void);
+    static void SampledRowMatchesOriginal(void);
+    static void ConvolveMatchesOriginal_data(void);
+    static void ConvolveMatchesOriginal(void);
+    static void CountMatchesMatchesScalar_data(void);
+    static void CountMatchesMatchesScalar(void);
+    static void SampledHistogramMatchesOriginal_data(void);
+    static void SampledHistogramMatchesOriginal(void);
+    static void BenchmarkKernels_data(void);
+    static void BenchmarkKernels(void);
+};
@@ -57,6 +57,20 @@ void MythFillDatabaseCommandLineParser::LoadArguments(void)
             "Only update the guide data, do not alter channels or icons.")
         ->SetBlocks("manual")
         ->SetGroup("Guide Data Handling");
+    add("--bulk-import", "bulkimport", false, "Import guide data in bulk",
+            "Compare the imported listings of each channel against "
+            "the existing guide data in memory and write the changes "
+            "in a few large batches instead of several queries per "
+            "program. This is much faster for large listings.")
+        ->SetGroup("Guide Data Handling");
+    add("--import-threads", "importthreads", 0,
+            "Import guide data while parsing it",
+            "Write the listings of each channel to the database "
+            "on this many threads as soon as the channel has been "
+            "read from the XMLTV file, instead of reading the whole "
+            "file first. This bounds the memory needed for large "
+            "listings. 0 disables streaming.")
+        ->SetGroup("Guide Data Handling");
 
 
     add("--do-channel-updates", "dochannelupdates", false,
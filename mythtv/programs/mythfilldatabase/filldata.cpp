@@ -88,6 +88,9 @@ void FillData::SetRefresh(int day, bool set)
 // XMLTV stuff
 bool FillData::GrabDataFromFile(int id, const QString &filename)
 {
+    if (m_importThreads > 0)
+        return StreamDataFromFile(id, filename);
+
     ChannelInfoList chanlist;
     QMap<QString, QList<ProgInfo> > proglist;
 
@@ -102,7 +105,58 @@ bool FillData::GrabDataFromFile(int id, const QString &filename)
     }
     else
     {
-        ProgramData::HandlePrograms(id, proglist);
+        ProgramData::HandlePrograms(id, proglist, m_bulkImport);
+    }
+    return true;
+}
+
+/** \brief Imports an XMLTV file while it is being parsed.
+ *
+ *  The programs are handed to a ProgramImportPool in batches while the
+ *  file is parsed, so at most a batch of programs is held in memory by
+ *  the parser, and the database work of different channels overlaps.
+ */
+bool FillData::StreamDataFromFile(int id, const QString &filename)
+{
+    ChannelInfoList chanlist;
+    QMap<QString, QList<ProgInfo> > proglist;
+    bool channelsHandled = false;
+
+    ProgramImportPool pool(id, m_bulkImport, m_importThreads,
+                           kImportQueueSize);
+
+    m_xmltvParser.SetProgramHandler(
+        [&](const QString &xmltvid, QList<ProgInfo> &programs)
+        {
+            // XMLTV files list all channels before the first programme
+            if (!channelsHandled)
+            {
+                m_chanData.handleChannels(id, &chanlist);
+                channelsHandled = true;
+            }
+            pool.Enqueue(xmltvid, programs);
+        }, kImportBatchSize);
+
+    bool ok = m_xmltvParser.parseFile(filename, &chanlist, &proglist);
+    m_xmltvParser.SetProgramHandler(nullptr, 0);
+    pool.Finish();
+
+    if (!ok)
+        return false;
+
+    if (!channelsHandled)
+        m_chanData.handleChannels(id, &chanlist);
+
+    if (pool.Queued() == 0)
+    {
+        LOG(VB_GENERAL, LOG_INFO, "No programs found in data.");
+        m_endOfData = true;
+    }
+    else
+    {
+        LOG(VB_GENERAL, LOG_INFO,
+            QString("Updated programs: %1 Unchanged programs: %2")
+                    .arg(pool.Updated()) .arg(pool.Unchanged()));
     }
     return true;
 }
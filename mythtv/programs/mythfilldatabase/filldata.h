@@ -12,6 +12,7 @@
 
 // filldata headers
 #include "channeldata.h"
+#include "programimportpool.h"
 #include "xmltvparser.h"
 
 #define REFRESH_MAX 21
@@ -48,6 +49,7 @@ class FillData
     void SetRefresh(int day, bool set);
 
     bool GrabDataFromFile(int id, const QString &filename);
+    bool StreamDataFromFile(int id, const QString &filename);
     bool GrabData(const Source& source, int offset);
     bool Run(SourceList &sourcelist);
 
@@ -71,8 +73,16 @@ class FillData
     bool    m_onlyUpdateChannels      {false};
     bool    m_channelUpdateRun        {false};
     bool    m_noAllAtOnce             {false};
+    bool    m_bulkImport              {false};
+    uint    m_importThreads           {0};
 
   private:
+    /// Programs buffered across all channels before they are handed
+    /// over when streaming
+    static constexpr uint kImportBatchSize { 5000 };
+    /// Programs waiting to be written before the parser is held up
+    static constexpr uint kImportQueueSize { 20000 };
+
     QMap<uint,bool>     m_refreshDay;
     bool                m_refreshAll  {false};
     mutable QStringList m_fatalErrors;
@@ -243,6 +243,10 @@ int main(int argc, char *argv[])
         fill_data.m_onlyUpdateChannels = true;
     if (cmdline.toBool("noallatonce"))
         fill_data.m_noAllAtOnce = true;
+    if (cmdline.toBool("bulkimport"))
+        fill_data.m_bulkImport = true;
+    if (cmdline.toInt("importthreads") > 0)
+        fill_data.m_importThreads = cmdline.toUInt("importthreads");
 
     mark_repeats = cmdline.toBool("markrepeats");
 
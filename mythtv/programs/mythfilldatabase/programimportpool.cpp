@@ -0,0 +1,136 @@
+// C++ headers
+#include <algorithm>
+
+// Qt headers
+#include <QHash>
+
+// libmyth headers
+#include "mythlogging.h"
+#include "mthread.h"
+
+// filldata headers
+#include "programimportpool.h"
+
+#define LOC QString("ProgramImportPool: ")
+
+ProgramImportPool::Worker::Worker(ProgramImportPool *pool, uint id)
+    : m_thread(new MThread(QString("ProgImport%1").arg(id), this)),
+      m_pool(pool), m_id(id)
+{
+}
+
+ProgramImportPool::Worker::~Worker()
+{
+    delete m_thread;
+}
+
+void ProgramImportPool::Worker::run(void)
+{
+    Batch batch;
+    while (m_pool->NextBatch(m_id, batch))
+    {
+        auto count = static_cast<uint>(batch.m_programs.size());
+        QMap<QString, QList<ProgInfo> > proglist;
+        proglist[batch.m_xmltvid].swap(batch.m_programs);
+
+        uint unchanged = 0;
+        uint updated = 0;
+        ProgramData::HandlePrograms(m_pool->m_sourceid, proglist,
+                                    m_pool->m_bulk, unchanged, updated);
+        m_pool->BatchDone(count, unchanged, updated);
+    }
+}
+
+ProgramImportPool::ProgramImportPool(
+    uint sourceid, bool bulk, uint threads, uint maxQueued)
+    : m_sourceid(sourceid), m_bulk(bulk),
+      m_maxQueued(std::max(maxQueued, 1U)),
+      m_queues(std::max(threads, 1U))
+{
+    for (uint i = 0; i < m_queues.size(); ++i)
+    {
+        auto *worker = new Worker(this, i);
+        m_workers.push_back(worker);
+        worker->m_thread->start();
+    }
+
+    LOG(VB_XMLTV, LOG_INFO, LOC +
+        QString("Started %1 import threads, at most %2 programs queued")
+            .arg(m_workers.size()).arg(m_maxQueued));
+}
+
+ProgramImportPool::~ProgramImportPool()
+{
+    Finish();
+}
+
+/** \brief Queues the programs of one channel to be written.
+ *
+ *  The programs are taken from \p programs, which is left empty. Blocks
+ *  while the queued programs exceed the limit given to the constructor.
+ */
+void ProgramImportPool::Enqueue(const QString &xmltvid,
+                                QList<ProgInfo> &programs)
+{
+    if (programs.isEmpty())
+        return;
+
+    auto count = static_cast<uint>(programs.size());
+
+    QMutexLocker locker(&m_lock);
+
+    while (m_queued && m_queued + count > m_maxQueued)
+        m_spaceAvailable.wait(locker.mutex());
+
+    Batch batch;
+    batch.m_xmltvid = xmltvid;
+    batch.m_programs.swap(programs);
+
+    m_queued += count;
+    m_totalQueued += count;
+    m_queues[qHash(xmltvid) % m_queues.size()].enqueue(batch);
+    m_workAvailable.wakeAll();
+}
+
+/// \brief Waits for all queued programs to be written and stops the workers.
+void ProgramImportPool::Finish(void)
+{
+    if (m_workers.empty())
+        return;
+
+    m_lock.lock();
+    m_finishing = true;
+    m_workAvailable.wakeAll();
+    m_lock.unlock();
+
+    for (auto *worker : m_workers)
+    {
+        worker->m_thread->wait();
+        delete worker;
+    }
+    m_workers.clear();
+}
+
+bool ProgramImportPool::NextBatch(uint id, Batch &batch)
+{
+    QMutexLocker locker(&m_lock);
+
+    while (m_queues[id].isEmpty() && !m_finishing)
+        m_workAvailable.wait(locker.mutex());
+
+    if (m_queues[id].isEmpty())
+        return false;
+
+    batch = m_queues[id].dequeue();
+    return true;
+}
+
+void ProgramImportPool::BatchDone(uint count, uint unchanged, uint updated)
+{
+    QMutexLocker locker(&m_lock);
+
+    m_queued -= count;
+    m_unchanged += unchanged;
+    m_updated += updated;
+    m_spaceAvailable.wakeAll();
+}
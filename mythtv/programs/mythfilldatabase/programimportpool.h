@@ -0,0 +1,84 @@
+#ifndef PROGRAMIMPORTPOOL_H
+#define PROGRAMIMPORTPOOL_H
+
+// C++ headers
+#include <vector>
+
+// Qt headers
+#include <QWaitCondition>
+#include <QRunnable>
+#include <QString>
+#include <QMutex>
+#include <QQueue>
+#include <QList>
+
+// libmythtv headers
+#include "programdata.h"
+
+class MThread;
+
+/** \class ProgramImportPool
+ *  \brief Writes batches of XMLTV programs to the database on a pool
+ *         of worker threads.
+ *
+ *  Each channel is always handled by the same worker, so the batches of
+ *  one channel are written in the order they were queued while different
+ *  channels are written concurrently. Enqueue() blocks once more than the
+ *  configured number of programs is waiting, which bounds the memory used
+ *  when the parser is faster than the database.
+ */
+class ProgramImportPool
+{
+  public:
+    ProgramImportPool(uint sourceid, bool bulk, uint threads, uint maxQueued);
+    ~ProgramImportPool();
+
+    void Enqueue(const QString &xmltvid, QList<ProgInfo> &programs);
+    void Finish(void);
+
+    uint Queued(void) const   { return m_totalQueued; }
+    uint Unchanged(void) const { return m_unchanged; }
+    uint Updated(void) const  { return m_updated; }
+
+  private:
+    struct Batch
+    {
+        QString         m_xmltvid;
+        QList<ProgInfo> m_programs;
+    };
+
+    class Worker : public QRunnable
+    {
+      public:
+        Worker(ProgramImportPool *pool, uint id);
+        ~Worker() override;
+        void run(void) override; // QRunnable
+
+        MThread *m_thread {nullptr};
+
+      private:
+        ProgramImportPool *m_pool;
+        uint               m_id;
+    };
+
+    bool NextBatch(uint id, Batch &batch);
+    void BatchDone(uint count, uint unchanged, uint updated);
+
+    uint                  m_sourceid;
+    bool                  m_bulk;
+    uint                  m_maxQueued;
+
+    QMutex                m_lock;
+    QWaitCondition        m_workAvailable;   // protected by m_lock
+    QWaitCondition        m_spaceAvailable;  // protected by m_lock
+    std::vector<QQueue<Batch> > m_queues;    // protected by m_lock
+    uint                  m_queued      {0}; // protected by m_lock
+    bool                  m_finishing   {false};
+    uint                  m_totalQueued {0};
+    uint                  m_unchanged   {0}; // protected by m_lock
+    uint                  m_updated     {0}; // protected by m_lock
+
+    std::vector<Worker*>  m_workers;
+};
+
+#endif // PROGRAMIMPORTPOOL_H
@@ -8,6 +8,7 @@
 #include <QUrl>
 
 // C++ headers
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 
@@ -189,6 +190,67 @@ static int readNextWithErrorCheck(QXmlStreamReader &xml)
     return true;
 }
 
+/** \brief Streams programs to \p handler while parsing.
+ *
+ *  Instead of collecting the whole file in the program list passed to
+ *  parseFile(), the buffered programs of every channel are passed to
+ *  \p handler once \p batchSize programs have been buffered in all, and
+ *  the rest at the end of the file.  This bounds the memory used however
+ *  the file is sorted.
+ *
+ *  The last program of a channel is held back until the next batch when
+ *  it has no stop time, so that FixProgramList() can take its stop time
+ *  from the program that follows it.  The channel list is complete by
+ *  the time \p handler is first called.
+ */
+void XMLTVParser::SetProgramHandler(const ProgramHandler &handler,
+                                    uint batchSize)
+{
+    m_programHandler = handler;
+    m_batchSize = std::max(batchSize, 1U);
+    m_buffered = 0;
+    m_heldBack = 0;
+}
+
+void XMLTVParser::addProgram(QMap<QString, QList<ProgInfo> > *proglist,
+                             const ProgInfo &pginfo)
+{
+    (*proglist)[pginfo.m_channel].push_back(pginfo);
+    m_buffered++;
+
+    // The held back programs don't count, or a file with more channels
+    // than a batch would be flushed after every program
+    if (m_programHandler && (m_buffered >= m_heldBack + m_batchSize))
+        flushPrograms(proglist, false);
+}
+
+/// Passes the buffered programs to the program handler, except for the
+/// programs without a stop time that end a channel unless \p all is set.
+void XMLTVParser::flushPrograms(QMap<QString, QList<ProgInfo> > *proglist,
+                                bool all)
+{
+    m_heldBack = 0;
+    for (auto it = proglist->begin(); it != proglist->end(); )
+    {
+        QList<ProgInfo> &list = *it;
+        if (!all && list.back().m_endts.isEmpty())
+        {
+            ProgInfo last = list.takeLast();
+            if (!list.isEmpty())
+                m_programHandler(it.key(), list);
+            list.clear();
+            list.push_back(last);
+            m_heldBack++;
+            ++it;
+            continue;
+        }
+
+        m_programHandler(it.key(), list);
+        it = proglist->erase(it);
+    }
+    m_buffered = m_heldBack;
+}
+
 bool XMLTVParser::parseFile(
     const QString& filename, ChannelInfoList *chanlist,
     QMap<QString, QList<ProgInfo> > *proglist)
@@ -804,7 +866,7 @@ bool XMLTVParser::parseFile(
                 {
                     // so we have a (relatively) clean program element now, which is good enough to process or to store
                     if (pginfo->m_clumpidx.isEmpty())
-                        (*proglist)[pginfo->m_channel].push_back(*pginfo);
+                        addProgram(proglist, *pginfo);
                     else
                     {
                         /* append all titles/descriptions from one clump */
@@ -829,7 +891,7 @@ bool XMLTVParser::parseFile(
                         {
                             pginfo->m_title = aggregatedTitle;
                             pginfo->m_description = aggregatedDesc;
-                            (*proglist)[pginfo->m_channel].push_back(*pginfo);
+                            addProgram(proglist, *pginfo);
                         }
                     }
                 }
@@ -842,8 +904,11 @@ bool XMLTVParser::parseFile(
         LOG(VB_GENERAL, LOG_ERR, QString("Malformed XML file, missing </tv> element, at line %1, %2").arg(xml.lineNumber()).arg(xml.errorString()));
         return false;
     }
-    //TODO add code for adding data on the run
     f.close();
 
+    // hand over whatever is still buffered
+    if (m_programHandler)
+        flushPrograms(proglist, true);
+
     return true;
 }
@@ -1,6 +1,9 @@
 #ifndef XMLTVPARSER_H
 #define XMLTVPARSER_H
 
+// C++ headers
+#include <functional>
+
 // Qt headers
 #include <QMap>
 #include <QList>
@@ -16,11 +19,23 @@ class QDomElement;
 class XMLTVParser
 {
   public:
+    using ProgramHandler =
+        std::function<void(const QString&, QList<ProgInfo>&)>;
+
     XMLTVParser();
+    void SetProgramHandler(const ProgramHandler &handler, uint batchSize);
     bool parseFile(const QString& filename, ChannelInfoList *chanlist,
                    QMap<QString, QList<ProgInfo> > *proglist);
 
   private:
+    void addProgram(QMap<QString, QList<ProgInfo> > *proglist,
+                    const ProgInfo &pginfo);
+    void flushPrograms(QMap<QString, QList<ProgInfo> > *proglist, bool all);
+
+    ProgramHandler m_programHandler;
+    uint         m_batchSize    {0};
+    uint         m_buffered     {0}; ///< programs in the program list
+    uint         m_heldBack     {0}; ///< of those, kept by the last flush
     unsigned int m_currentYear {0};
     QString m_movieGrabberPath;
     QString m_tvGrabberPath;
@@ -22,3 +22,15 @@ using_backend {
 }
 
 using_mythtranscode: SUBDIRS += mythtranscode
+
+# unit tests mythbackend
+mythbackend-test.depends = sub-mythbackend
+mythbackend-test.target = buildtestmythbackend
+mythbackend-test.commands = cd mythbackend/test && $(QMAKE) && $(MAKE)
+unix:QMAKE_EXTRA_TARGETS += mythbackend-test
+
+# unit tests mythcommflag
+mythcommflag-test.depends = sub-mythcommflag
+mythcommflag-test.target = buildtestmythcommflag
+mythcommflag-test.commands = cd mythcommflag/test && $(QMAKE) && $(MAKE)
+unix:QMAKE_EXTRA_TARGETS += mythcommflag-test